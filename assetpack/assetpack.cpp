@@ -0,0 +1,151 @@
+//
+// @file:   assetpack.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Bundles files into one compressed asset pack
+//
+
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <string>
+#include <cstring>
+#include <stdexcept>
+
+#include <lz4hc.h>
+
+#include "assets/asset_pack_format.h"
+#include "snapshot/checksum.h"
+
+inline std::vector<char> read_file(const std::string& filename) {
+	std::ifstream file(filename, std::ios::ate | std::ios::binary);
+
+	if (!file.is_open()) {
+		throw std::runtime_error("failed to open file " + filename);
+	}
+
+	size_t const fileSize = (size_t)file.tellg();
+	std::vector<char> buffer(fileSize);
+
+	file.seekg(0);
+	file.read(buffer.data(), fileSize);
+
+	file.close();
+
+	return buffer;
+}
+
+
+using namespace std;
+
+struct Input
+{
+	std::string name;
+	std::vector<char> data;
+};
+
+int main(int const argc, char const * argv[])
+{
+	if (argc <= 2)
+	{
+		cout << "Usage: [OutputFileName] [Name=InputFileName]..." << endl;
+		return 1;
+	}
+
+	try {
+		std::string const output_file_name = argv[1];
+
+		std::vector<Input> inputs;
+		for (int i = 2; i < argc; ++i)
+		{
+			std::string const arg = argv[i];
+			auto const separator = arg.find('=');
+			if (separator == std::string::npos || separator == 0) {
+				throw std::runtime_error("expected Name=InputFileName, got " + arg);
+			}
+
+			inputs.push_back({ arg.substr(0, separator), read_file(arg.substr(separator + 1)) });
+		}
+
+		// the runtime looks entries up with a binary search
+		std::sort(inputs.begin(), inputs.end(), [](Input const & a, Input const & b) { return a.name < b.name; });
+		for (size_t i = 1; i < inputs.size(); ++i) {
+			if (inputs[i - 1].name == inputs[i].name) {
+				throw std::runtime_error("duplicate asset " + inputs[i].name);
+			}
+		}
+
+		std::vector<asset_pack::Entry> entries(inputs.size());
+		std::vector<std::vector<char>> blobs(inputs.size());
+		std::string names;
+
+		for (size_t i = 0; i < inputs.size(); ++i)
+		{
+			auto const & input = inputs[i];
+			auto & entry = entries[i];
+
+			entry.nameOffset = static_cast<uint32_t>(names.size());
+			entry.nameSize = static_cast<uint32_t>(input.name.size());
+			entry.size = input.data.size();
+			entry.checksum = checksum64(std::as_bytes(std::span(input.data)));
+			names += input.name;
+
+			// entries that do not shrink are stored as they are
+			auto & blob = blobs[i];
+			blob.resize(LZ4_compressBound(static_cast<int>(input.data.size())));
+			int const size = input.data.empty() ? 0 : LZ4_compress_HC(input.data.data(), blob.data(),
+				static_cast<int>(input.data.size()), static_cast<int>(blob.size()), LZ4HC_CLEVEL_MAX);
+
+			if (size > 0 && static_cast<size_t>(size) < input.data.size()) {
+				blob.resize(size);
+			}
+			else {
+				blob = input.data;
+			}
+			entry.compressedSize = blob.size();
+		}
+
+		auto const align = [](uint64_t const value) {
+			return (value + asset_pack::alignment - 1) & ~(asset_pack::alignment - 1);
+		};
+
+		uint64_t offset = align(sizeof(asset_pack::Header) + sizeof(asset_pack::Entry) * entries.size() + names.size());
+		for (auto & entry : entries) {
+			entry.dataOffset = offset;
+			offset = align(offset + entry.compressedSize);
+		}
+
+		asset_pack::Header header = {};
+		header.magic = asset_pack::magic;
+		header.version = asset_pack::version;
+		header.entryCount = static_cast<uint32_t>(entries.size());
+
+		std::vector<char> out(offset, 0);
+		std::memcpy(out.data(), &header, sizeof(header));
+		std::memcpy(out.data() + sizeof(header), entries.data(), sizeof(asset_pack::Entry) * entries.size());
+		std::memcpy(out.data() + sizeof(header) + sizeof(asset_pack::Entry) * entries.size(), names.data(), names.size());
+		for (size_t i = 0; i < entries.size(); ++i) {
+			std::memcpy(out.data() + entries[i].dataOffset, blobs[i].data(), blobs[i].size());
+		}
+
+		ofstream file(output_file_name, std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!file.is_open()) {
+			throw std::runtime_error("failed to create file!");
+		}
+
+		file.write(out.data(), static_cast<std::streamsize>(out.size()));
+		file.close();
+
+		if (!file) {
+			throw std::runtime_error("failed to write file!");
+		}
+	}
+	catch (exception const& e)
+	{
+		cout << "Exception: " << e.what() << endl;
+		return 1;
+	}
+
+	return 0;
+}
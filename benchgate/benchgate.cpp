@@ -0,0 +1,180 @@
+//
+// @file:   benchgate.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Runs the benchmarks several times and fails on regressions against a baseline
+//
+
+#include "benchgate_compare.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+
+namespace {
+
+int printUsage()
+{
+    cout << "Usage: benchgate --baseline Baseline.json [--benchmark Executable] [--runs N]" << endl;
+    cout << "                 [--filter Substring] [--min-time Seconds] [--threshold Fraction]" << endl;
+    cout << "                 [--update] [Results.json...]" << endl;
+    cout << endl;
+    cout << "  Runs the benchmark executable N times, or reads the given result files," << endl;
+    cout << "  and compares the medians with the baseline. --update writes the baseline," << endl;
+    cout << "  timings depend on the machine, so it is created where the gate runs." << endl;
+    cout << "  Exit code 0: no regression, 1: regression, 2: error" << endl;
+    return 2;
+}
+
+string quote(string const & value)
+{
+    return "\"" + value + "\"";
+}
+
+}
+
+
+int main(int const argc, char const * argv[])
+{
+    string baselineFile;
+    string benchmarkFile;
+    string filter;
+    string minTime;
+    size_t runs = 5;
+    double threshold = -1.0;
+    bool update = false;
+    vector<string> resultFiles;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        string const arg = argv[i];
+        bool const hasValue = i + 1 < argc;
+        if(arg == "--baseline" && hasValue) {
+            baselineFile = argv[++i];
+        }
+        else if(arg == "--benchmark" && hasValue) {
+            benchmarkFile = argv[++i];
+        }
+        else if(arg == "--runs" && hasValue) {
+            runs = std::stoul(argv[++i]);
+        }
+        else if(arg == "--filter" && hasValue) {
+            filter = argv[++i];
+        }
+        else if(arg == "--min-time" && hasValue) {
+            minTime = argv[++i];
+        }
+        else if(arg == "--threshold" && hasValue) {
+            threshold = std::stod(argv[++i]);
+        }
+        else if(arg == "--update") {
+            update = true;
+        }
+        else if(!arg.empty() && arg[0] != '-') {
+            resultFiles.push_back(arg);
+        }
+        else {
+            return printUsage();
+        }
+    }
+
+    if(baselineFile.empty() || (benchmarkFile.empty() && resultFiles.empty()) || runs == 0) {
+        return printUsage();
+    }
+
+    // without a baseline every benchmark would be new and the gate would always pass
+    if(!update && !std::filesystem::exists(baselineFile)) {
+        cout << "no baseline " << baselineFile << ", create it with --update on the machine that runs the gate" << endl;
+        return 2;
+    }
+
+    auto const baseline = benchgate::readBaseline(baselineFile);
+    if(!baseline) {
+        cout << "failed to parse baseline " << baselineFile << endl;
+        return 2;
+    }
+
+    benchgate::Samples samples;
+
+    // result files replace the runs, e.g. from CI artifacts or synthetic data
+    for(auto const & file : resultFiles)
+    {
+        if(!benchgate::readResults(file, samples)) {
+            cout << "failed to read results " << file << endl;
+            return 2;
+        }
+    }
+
+    if(resultFiles.empty())
+    {
+        auto const output = std::filesystem::temp_directory_path() / "benchgate_results.json";
+
+        for(size_t run = 0; run < runs; ++run)
+        {
+            cout << "run " << run + 1 << " of " << runs << endl;
+
+            string command = quote(benchmarkFile) + " --out " + quote(output.string());
+            if(!filter.empty()) {
+                command += " --filter " + quote(filter);
+            }
+            if(!minTime.empty()) {
+                command += " --min-time " + minTime;
+            }
+
+            if(std::system(command.c_str()) != 0 || !benchgate::readResults(output.string(), samples)) {
+                cout << "benchmark run failed: " << command << endl;
+                return 2;
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::remove(output, error);
+    }
+
+    if(update)
+    {
+        auto newBaseline = benchgate::createBaseline(samples, *baseline);
+        if(threshold >= 0.0) {
+            newBaseline.threshold = threshold;
+        }
+
+        if(!benchgate::writeBaseline(baselineFile, newBaseline)) {
+            cout << "failed to write baseline " << baselineFile << endl;
+            return 2;
+        }
+        cout << "wrote baseline of " << newBaseline.benchmarks.size() << " benchmarks to " << baselineFile << endl;
+        return 0;
+    }
+
+    auto gateBaseline = *baseline;
+    if(threshold >= 0.0) {
+        gateBaseline.threshold = threshold;
+    }
+
+    auto const comparisons = benchgate::compare(gateBaseline, samples);
+    cout << endl;
+    benchgate::printTable(cout, comparisons);
+    cout << endl;
+
+    bool const compared = std::any_of(comparisons.begin(), comparisons.end(), [](benchgate::Comparison const & comparison) {
+        return comparison.verdict != benchgate::Verdict::eNew && comparison.verdict != benchgate::Verdict::eMissing;
+    });
+    if(!compared) {
+        cout << "no benchmark of the run is in the baseline" << endl;
+        return 2;
+    }
+
+    if(benchgate::hasRegression(comparisons)) {
+        cout << "benchmark gate failed" << endl;
+        return 1;
+    }
+
+    cout << "benchmark gate passed" << endl;
+    return 0;
+}
@@ -0,0 +1,500 @@
+//
+// @file:   benchgate_compare.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Robust statistics of benchmark runs and comparison with a baseline
+//
+
+#include "benchgate_compare.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+
+namespace benchgate {
+
+namespace {
+
+// just enough json for the files of the benchmark executable and the baseline
+struct JsonValue
+{
+    enum class Type { eNull, eBool, eNumber, eString, eArray, eObject };
+
+    Type type = Type::eNull;
+    bool boolean = false;
+    double number = 0.0;
+    std::string string;
+    std::vector<JsonValue> array;
+    std::vector<std::pair<std::string, JsonValue>> object;
+
+    JsonValue const * find(std::string const & key) const
+    {
+        for(auto const & [name, value] : object) {
+            if(name == key) {
+                return &value;
+            }
+        }
+        return nullptr;
+    }
+};
+
+class JsonParser
+{
+public:
+    explicit JsonParser(std::string const & text) : mText(text) {}
+
+    bool parse(JsonValue & value)
+    {
+        return parseValue(value) && (skipSpace(), mPosition == mText.size());
+    }
+
+private:
+    std::string const & mText;
+    size_t mPosition = 0;
+
+    void skipSpace()
+    {
+        while(mPosition < mText.size() && std::isspace(static_cast<unsigned char>(mText[mPosition]))) {
+            mPosition++;
+        }
+    }
+
+    bool consume(char const c)
+    {
+        skipSpace();
+        if(mPosition < mText.size() && mText[mPosition] == c) {
+            mPosition++;
+            return true;
+        }
+        return false;
+    }
+
+    bool consumeWord(char const * word)
+    {
+        size_t const size = std::char_traits<char>::length(word);
+        if(mText.compare(mPosition, size, word) != 0) {
+            return false;
+        }
+        mPosition += size;
+        return true;
+    }
+
+    bool parseString(std::string & out)
+    {
+        if(!consume('"')) {
+            return false;
+        }
+
+        while(mPosition < mText.size())
+        {
+            char const c = mText[mPosition++];
+            if(c == '"') {
+                return true;
+            }
+            if(c != '\\') {
+                out.push_back(c);
+                continue;
+            }
+            if(mPosition >= mText.size()) {
+                return false;
+            }
+
+            // names are ascii, \u escapes are kept as they are
+            char const escaped = mText[mPosition++];
+            switch(escaped)
+            {
+                case 'n': out.push_back('\n'); break;
+                case 't': out.push_back('\t'); break;
+                case 'r': out.push_back('\r'); break;
+                case 'b': out.push_back('\b'); break;
+                case 'f': out.push_back('\f'); break;
+                case 'u': out += "\\u"; break;
+                default: out.push_back(escaped); break;
+            }
+        }
+        return false;
+    }
+
+    bool parseValue(JsonValue & value)
+    {
+        skipSpace();
+        if(mPosition >= mText.size()) {
+            return false;
+        }
+
+        char const c = mText[mPosition];
+        if(c == '{')
+        {
+            value.type = JsonValue::Type::eObject;
+            mPosition++;
+            if(consume('}')) {
+                return true;
+            }
+            do
+            {
+                std::pair<std::string, JsonValue> member;
+                if(!parseString(member.first) || !consume(':') || !parseValue(member.second)) {
+                    return false;
+                }
+                value.object.push_back(std::move(member));
+            }
+            while(consume(','));
+            return consume('}');
+        }
+        if(c == '[')
+        {
+            value.type = JsonValue::Type::eArray;
+            mPosition++;
+            if(consume(']')) {
+                return true;
+            }
+            do
+            {
+                value.array.emplace_back();
+                if(!parseValue(value.array.back())) {
+                    return false;
+                }
+            }
+            while(consume(','));
+            return consume(']');
+        }
+        if(c == '"') {
+            value.type = JsonValue::Type::eString;
+            return parseString(value.string);
+        }
+        if(consumeWord("true")) {
+            value.type = JsonValue::Type::eBool;
+            value.boolean = true;
+            return true;
+        }
+        if(consumeWord("false")) {
+            value.type = JsonValue::Type::eBool;
+            return true;
+        }
+        if(consumeWord("null")) {
+            return true;
+        }
+
+        char const * begin = mText.c_str() + mPosition;
+        char * end = nullptr;
+        value.type = JsonValue::Type::eNumber;
+        value.number = std::strtod(begin, &end);
+        mPosition += static_cast<size_t>(end - begin);
+        return end != begin;
+    }
+};
+
+bool readJson(std::string const & filename, JsonValue & value)
+{
+    std::ifstream file(filename, std::ios::binary);
+    if(!file.is_open()) {
+        return false;
+    }
+
+    std::stringstream text;
+    text << file.rdbuf();
+    std::string const content = text.str();
+
+    return JsonParser(content).parse(value);
+}
+
+double getNumber(JsonValue const & object, std::string const & key, double const fallback)
+{
+    auto const * value = object.find(key);
+    return value && value->type == JsonValue::Type::eNumber ? value->number : fallback;
+}
+
+double getMedian(std::vector<double> & values)
+{
+    if(values.empty()) {
+        return 0.0;
+    }
+
+    size_t const middle = values.size() / 2;
+    std::nth_element(values.begin(), values.begin() + middle, values.end());
+    double const upper = values[middle];
+    if(values.size() % 2 == 1) {
+        return upper;
+    }
+
+    double const lower = *std::max_element(values.begin(), values.begin() + middle);
+    return 0.5 * (lower + upper);
+}
+
+std::string formatTime(double const ns)
+{
+    char buffer[32];
+    if(ns >= 1e9) {
+        std::snprintf(buffer, sizeof(buffer), "%.3f s", ns * 1e-9);
+    }
+    else if(ns >= 1e6) {
+        std::snprintf(buffer, sizeof(buffer), "%.3f ms", ns * 1e-6);
+    }
+    else if(ns >= 1e3) {
+        std::snprintf(buffer, sizeof(buffer), "%.3f us", ns * 1e-3);
+    }
+    else {
+        std::snprintf(buffer, sizeof(buffer), "%.1f ns", ns);
+    }
+    return buffer;
+}
+
+char const * getVerdictName(Verdict const verdict)
+{
+    switch(verdict)
+    {
+        case Verdict::eUnchanged: return "ok";
+        case Verdict::eNoise: return "noise";
+        case Verdict::eRegression: return "REGRESSION";
+        case Verdict::eImprovement: return "improved";
+        case Verdict::eNew: return "new";
+        case Verdict::eMissing: return "missing";
+    }
+    return "";
+}
+
+}
+
+
+Statistics computeStatistics(std::vector<double> samples)
+{
+    Statistics statistics;
+    statistics.runs = samples.size();
+    statistics.median = getMedian(samples);
+
+    for(auto & sample : samples) {
+        sample = std::fabs(sample - statistics.median);
+    }
+    statistics.mad = getMedian(samples);
+
+    return statistics;
+}
+
+bool readResults(std::string const & filename, Samples & samples)
+{
+    JsonValue root;
+    if(!readJson(filename, root)) {
+        return false;
+    }
+
+    auto const * benchmarks = root.find("benchmarks");
+    if(benchmarks == nullptr || benchmarks->type != JsonValue::Type::eArray) {
+        return false;
+    }
+
+    for(auto const & benchmark : benchmarks->array)
+    {
+        auto const * name = benchmark.find("name");
+        auto const * ns = benchmark.find("ns_per_op");
+        if(name == nullptr || ns == nullptr || name->type != JsonValue::Type::eString || ns->type != JsonValue::Type::eNumber) {
+            return false;
+        }
+        samples[name->string].push_back(ns->number);
+    }
+
+    return true;
+}
+
+std::optional<Baseline> readBaseline(std::string const & filename)
+{
+    if(!std::filesystem::exists(filename)) {
+        return Baseline();
+    }
+
+    JsonValue root;
+    if(!readJson(filename, root)) {
+        return std::nullopt;
+    }
+
+    Baseline baseline;
+    baseline.threshold = getNumber(root, "threshold", baseline.threshold);
+
+    auto const * benchmarks = root.find("benchmarks");
+    if(benchmarks == nullptr || benchmarks->type != JsonValue::Type::eArray) {
+        return std::nullopt;
+    }
+
+    for(auto const & benchmark : benchmarks->array)
+    {
+        auto const * name = benchmark.find("name");
+        if(name == nullptr || name->type != JsonValue::Type::eString) {
+            return std::nullopt;
+        }
+
+        BaselineEntry entry;
+        entry.statistics.median = getNumber(benchmark, "median_ns", 0.0);
+        entry.statistics.mad = getNumber(benchmark, "mad_ns", 0.0);
+        entry.statistics.runs = static_cast<size_t>(getNumber(benchmark, "runs", 1.0));
+        if(auto const * threshold = benchmark.find("threshold"); threshold && threshold->type == JsonValue::Type::eNumber) {
+            entry.threshold = threshold->number;
+        }
+
+        baseline.benchmarks[name->string] = entry;
+    }
+
+    return baseline;
+}
+
+bool writeBaseline(std::string const & filename, Baseline const & baseline)
+{
+    std::ofstream file(filename);
+    if(!file.is_open()) {
+        return false;
+    }
+
+    file << std::setprecision(6);
+    file << "{\n";
+    file << "  \"threshold\": " << baseline.threshold << ",\n";
+    file << "  \"benchmarks\": [";
+
+    bool first = true;
+    for(auto const & [name, entry] : baseline.benchmarks)
+    {
+        file << (first ? "\n" : ",\n");
+        file << "    { \"name\": \"" << name << "\", \"median_ns\": " << std::fixed << std::setprecision(3) << entry.statistics.median
+             << ", \"mad_ns\": " << entry.statistics.mad << ", \"runs\": " << entry.statistics.runs;
+        if(entry.threshold) {
+            file << std::defaultfloat << std::setprecision(6) << ", \"threshold\": " << *entry.threshold;
+        }
+        file << " }" << std::defaultfloat;
+        first = false;
+    }
+
+    file << "\n  ]\n";
+    file << "}\n";
+
+    return file.good();
+}
+
+Baseline createBaseline(Samples const & samples, Baseline const & previous)
+{
+    Baseline baseline;
+    baseline.threshold = previous.threshold;
+
+    for(auto const & [name, values] : samples)
+    {
+        BaselineEntry entry;
+        entry.statistics = computeStatistics(values);
+
+        // thresholds are tuned by hand, so they survive an update
+        if(auto it = previous.benchmarks.find(name); it != previous.benchmarks.end()) {
+            entry.threshold = it->second.threshold;
+        }
+
+        baseline.benchmarks[name] = entry;
+    }
+
+    return baseline;
+}
+
+std::vector<Comparison> compare(Baseline const & baseline, Samples const & samples)
+{
+    std::vector<Comparison> comparisons;
+
+    for(auto const & [name, values] : samples)
+    {
+        Comparison comparison;
+        comparison.name = name;
+        comparison.current = computeStatistics(values);
+
+        auto const it = baseline.benchmarks.find(name);
+        if(it == baseline.benchmarks.end())
+        {
+            comparison.verdict = Verdict::eNew;
+            comparisons.push_back(comparison);
+            continue;
+        }
+
+        comparison.baseline = it->second.statistics;
+        comparison.threshold = it->second.threshold.value_or(baseline.threshold);
+
+        double const delta = comparison.current.median - comparison.baseline.median;
+        comparison.change = comparison.baseline.median > 0.0 ? delta / comparison.baseline.median : 0.0;
+
+        // the spread of both sets of runs, at least the noise floor, a single run has none
+        double const baselineMad = std::max(comparison.baseline.mad, minRelativeMad * comparison.baseline.median);
+        double const currentMad = std::max(comparison.current.mad, minRelativeMad * comparison.current.median);
+        double const noise = significance * madToSigma * std::sqrt(baselineMad * baselineMad + currentMad * currentMad);
+
+        if(std::fabs(comparison.change) <= comparison.threshold) {
+            comparison.verdict = Verdict::eUnchanged;
+        }
+        else if(std::fabs(delta) <= noise) {
+            comparison.verdict = Verdict::eNoise;
+        }
+        else {
+            comparison.verdict = delta > 0.0 ? Verdict::eRegression : Verdict::eImprovement;
+        }
+
+        comparisons.push_back(comparison);
+    }
+
+    for(auto const & [name, entry] : baseline.benchmarks)
+    {
+        if(samples.find(name) == samples.end())
+        {
+            Comparison comparison;
+            comparison.name = name;
+            comparison.baseline = entry.statistics;
+            comparison.threshold = entry.threshold.value_or(baseline.threshold);
+            comparison.verdict = Verdict::eMissing;
+            comparisons.push_back(comparison);
+        }
+    }
+
+    return comparisons;
+}
+
+bool hasRegression(std::vector<Comparison> const & comparisons)
+{
+    return std::any_of(comparisons.begin(), comparisons.end(),
+        [](Comparison const & comparison) { return comparison.verdict == Verdict::eRegression; });
+}
+
+void printTable(std::ostream & out, std::vector<Comparison> const & comparisons)
+{
+    size_t nameWidth = 9;
+    for(auto const & comparison : comparisons) {
+        nameWidth = std::max(nameWidth, comparison.name.size());
+    }
+
+    out << std::left << std::setw(nameWidth) << "benchmark" << std::right
+        << std::setw(14) << "baseline" << std::setw(14) << "current"
+        << std::setw(10) << "change" << std::setw(14) << "mad" << std::setw(11) << "threshold"
+        << "  verdict\n";
+    out << std::string(nameWidth + 73, '-') << '\n';
+
+    for(auto const & comparison : comparisons)
+    {
+        bool const hasBaseline = comparison.verdict != Verdict::eNew;
+        bool const hasCurrent = comparison.verdict != Verdict::eMissing;
+
+        char change[32] = "";
+        if(hasBaseline && hasCurrent) {
+            std::snprintf(change, sizeof(change), "%+.1f%%", comparison.change * 100.0);
+        }
+
+        char threshold[32] = "";
+        if(hasBaseline) {
+            std::snprintf(threshold, sizeof(threshold), "%.0f%%", comparison.threshold * 100.0);
+        }
+
+        out << std::left << std::setw(nameWidth) << comparison.name << std::right
+            << std::setw(14) << (hasBaseline ? formatTime(comparison.baseline.median) : "")
+            << std::setw(14) << (hasCurrent ? formatTime(comparison.current.median) : "")
+            << std::setw(10) << change
+            << std::setw(14) << (hasCurrent ? formatTime(comparison.current.mad) : "")
+            << std::setw(11) << threshold
+            << "  " << getVerdictName(comparison.verdict) << '\n';
+    }
+}
+
+}
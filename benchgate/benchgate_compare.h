@@ -0,0 +1,89 @@
+//
+// @file:   benchgate_compare.h
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Robust statistics of benchmark runs and comparison with a baseline
+//
+
+#pragma once
+
+#include <iosfwd>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+
+namespace benchgate {
+
+// ns_per_op of every run, by benchmark name
+using Samples = std::map<std::string, std::vector<double>>;
+
+struct Statistics
+{
+    double median = 0.0;
+    double mad = 0.0;               // median absolute deviation
+    size_t runs = 0;
+};
+
+struct BaselineEntry
+{
+    Statistics statistics;
+    std::optional<double> threshold;    // relative, falls back to Baseline::threshold
+};
+
+struct Baseline
+{
+    double threshold = 0.1;
+    std::map<std::string, BaselineEntry> benchmarks;
+};
+
+enum class Verdict {
+    eUnchanged,
+    eNoise,             // above the threshold but within the spread of the runs
+    eRegression,
+    eImprovement,
+    eNew,               // not in the baseline
+    eMissing,           // in the baseline but not run
+};
+
+struct Comparison
+{
+    std::string name;
+    Statistics baseline;
+    Statistics current;
+    double change = 0.0;            // current / baseline - 1
+    double threshold = 0.0;
+    Verdict verdict = Verdict::eUnchanged;
+};
+
+// MAD scaled by this estimates the standard deviation of normal samples
+constexpr double madToSigma = 1.4826;
+
+// a change is significant if it is larger than this many sigmas of both runs
+constexpr double significance = 3.0;
+
+// smallest MAD relative to the median, timings are never more stable than
+// this, a MAD of zero, e.g. of a single run, is raised to it
+constexpr double minRelativeMad = 0.01;
+
+Statistics computeStatistics(std::vector<double> samples);
+
+// appends the samples of one output file of the benchmark executable, false on errors
+bool readResults(std::string const & filename, Samples & samples);
+
+// an empty baseline if the file does not exist, so --update can create it, nullopt if it can not be parsed
+std::optional<Baseline> readBaseline(std::string const & filename);
+
+bool writeBaseline(std::string const & filename, Baseline const & baseline);
+
+// current statistics with the thresholds of the old baseline
+Baseline createBaseline(Samples const & samples, Baseline const & previous);
+
+std::vector<Comparison> compare(Baseline const & baseline, Samples const & samples);
+
+bool hasRegression(std::vector<Comparison> const & comparisons);
+
+void printTable(std::ostream & out, std::vector<Comparison> const & comparisons);
+
+}
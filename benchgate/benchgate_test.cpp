@@ -0,0 +1,106 @@
+//
+// @file:   benchgate_test.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Runs the comparison of the gate on the synthetic runs in fixtures/
+//
+
+#include "benchgate_compare.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+using namespace std;
+using namespace benchgate;
+
+
+namespace {
+
+int failures = 0;
+
+void check(bool const condition, string const & what)
+{
+    if(!condition) {
+        cout << "FAILED: " << what << endl;
+        failures++;
+    }
+}
+
+Comparison const * findComparison(vector<Comparison> const & comparisons, string const & name)
+{
+    auto const it = std::find_if(comparisons.begin(), comparisons.end(),
+        [&](Comparison const & comparison) { return comparison.name == name; });
+    return it != comparisons.end() ? &*it : nullptr;
+}
+
+void checkVerdict(vector<Comparison> const & comparisons, string const & name, Verdict const verdict)
+{
+    auto const * comparison = findComparison(comparisons, name);
+    check(comparison != nullptr && comparison->verdict == verdict, name + " verdict");
+}
+
+}
+
+
+int main(int const argc, char const * argv[])
+{
+    if(argc != 2) {
+        cout << "Usage: benchgate_test FixtureDirectory" << endl;
+        return 2;
+    }
+
+    std::filesystem::path const fixtures = argv[1];
+
+    // median and MAD of an even number of runs
+    auto const statistics = computeStatistics({ 4.0, 1.0, 3.0, 2.0 });
+    check(statistics.runs == 4 && statistics.median == 2.5 && statistics.mad == 1.0, "statistics of 4 runs");
+
+    auto const baseline = readBaseline((fixtures / "baseline.json").string());
+    check(baseline.has_value() && baseline->benchmarks.size() == 7, "read baseline");
+    if(!baseline) {
+        return 1;
+    }
+
+    Samples samples;
+    for(char const * file : { "run1.json", "run2.json", "run3.json" }) {
+        check(readResults((fixtures / file).string(), samples), string("read ") + file);
+    }
+
+    auto const comparisons = compare(*baseline, samples);
+    printTable(cout, comparisons);
+
+    checkVerdict(comparisons, "fixture/unchanged", Verdict::eUnchanged);
+    checkVerdict(comparisons, "fixture/regression", Verdict::eRegression);
+    checkVerdict(comparisons, "fixture/improvement", Verdict::eImprovement);
+    checkVerdict(comparisons, "fixture/noisy", Verdict::eNoise);
+    checkVerdict(comparisons, "fixture/new", Verdict::eNew);
+    checkVerdict(comparisons, "fixture/missing", Verdict::eMissing);
+
+    // identical runs have no spread, the noise floor keeps a 3% change within a 2% threshold from failing
+    checkVerdict(comparisons, "fixture/zero_mad", Verdict::eNoise);
+    checkVerdict(comparisons, "fixture/zero_mad_regression", Verdict::eRegression);
+
+    check(hasRegression(comparisons), "gate fails");
+
+    auto const * regression = findComparison(comparisons, "fixture/regression");
+    check(regression != nullptr && std::fabs(regression->change - 0.3) < 1e-9, "relative change");
+
+    // a baseline written and read again compares the same
+    auto const written = std::filesystem::temp_directory_path() / "benchgate_test_baseline.json";
+    check(writeBaseline(written.string(), createBaseline(samples, *baseline)), "write baseline");
+    auto const reread = readBaseline(written.string());
+    check(reread && reread->benchmarks.at("fixture/zero_mad").threshold == 0.02, "thresholds survive an update");
+    check(reread && !hasRegression(compare(*reread, samples)), "runs against their own baseline");
+    std::error_code error;
+    std::filesystem::remove(written, error);
+
+    // a missing file is an empty baseline for --update, the gate itself refuses it
+    auto const missing = readBaseline((fixtures / "does_not_exist.json").string());
+    check(missing && missing->benchmarks.empty(), "missing baseline");
+
+    cout << (failures == 0 ? "passed" : "failed") << endl;
+    return failures == 0 ? 0 : 1;
+}
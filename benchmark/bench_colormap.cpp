@@ -0,0 +1,57 @@
+//
+// @file:   bench_colormap.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Colormap throughput on a 10M cell field
+//
+
+#include "benchmark.h"
+#include "colormap/colormap.h"
+
+#include <cmath>
+
+
+namespace {
+
+constexpr size_t cellCount = 10'000'000;
+
+std::vector<float> const & getField()
+{
+    static std::vector<float> const field = [](){
+        std::vector<float> values(cellCount);
+        for(size_t i = 0; i < values.size(); ++i) {
+            values[i] = std::sin(i * 0.001f) * 50.0f;
+        }
+        return values;
+    }();
+
+    return field;
+}
+
+std::vector<SphereShaderObject::ColorBufferElement> & getColors()
+{
+    static std::vector<SphereShaderObject::ColorBufferElement> colors(cellCount);
+    return colors;
+}
+
+BENCHMARK("colormap/viridis_fixed_10m", [](size_t const iterations) {
+    auto & colors = getColors();
+    Colormap colormap(ColormapType::eViridis);
+    colormap.setRange({ -50.0f, 50.0f });
+    for(size_t i = 0; i < iterations; ++i) {
+        colormap.apply(getField(), colors);
+        doNotOptimize(colors.data());
+    }
+});
+
+BENCHMARK("colormap/viridis_automatic_10m", [](size_t const iterations) {
+    auto & colors = getColors();
+    Colormap colormap(ColormapType::eViridis);
+    colormap.setAutomaticRange(true);
+    for(size_t i = 0; i < iterations; ++i) {
+        colormap.apply(getField(), colors);
+        doNotOptimize(colors.data());
+    }
+});
+
+}
@@ -0,0 +1,59 @@
+//
+// @file:   bench_memory.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Arena allocators against the default allocator
+//
+
+#include "benchmark.h"
+#include "memory/monotonic_arena.h"
+#include "memory/frame_arena.h"
+#include "geometry/sphere.h"
+
+#include <memory_resource>
+#include <vector>
+
+
+namespace {
+
+// many small scratch vectors, like per frame temporaries in the update delegates
+void scratchVectors(std::pmr::memory_resource * const resource)
+{
+    for(size_t i = 0; i < 64; ++i) {
+        std::pmr::vector<float> values(resource);
+        for(size_t j = 0; j < 100; ++j) {
+            values.push_back(static_cast<float>(j));
+        }
+        doNotOptimize(values.data());
+    }
+}
+
+BENCHMARK("memory/scratch_vectors/default", [](size_t const iterations) {
+    for(size_t i = 0; i < iterations; ++i) {
+        scratchVectors(std::pmr::get_default_resource());
+    }
+});
+
+BENCHMARK("memory/scratch_vectors/frame_arena", [](size_t const iterations) {
+    FrameArena frameArena(3);
+    for(size_t i = 0; i < iterations; ++i) {
+        frameArena.beginFrame(i);
+        scratchVectors(&frameArena.get());
+    }
+});
+
+BENCHMARK("memory/sphere_mesh_200/default", [](size_t const iterations) {
+    for(size_t i = 0; i < iterations; ++i) {
+        auto const mesh = createSphereTriangles(createSphereVertices(2.0f, 200));
+        doNotOptimize(mesh.data());
+    }
+});
+
+BENCHMARK("memory/sphere_mesh_200/arena", [](size_t const iterations) {
+    for(size_t i = 0; i < iterations; ++i) {
+        auto const mesh = createSphereMesh(2.0f, 200);
+        doNotOptimize(mesh.data());
+    }
+});
+
+}
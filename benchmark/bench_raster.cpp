@@ -0,0 +1,63 @@
+//
+// @file:   bench_raster.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Software rasterizer, 1M triangle sphere at 1080p
+//
+
+#include "benchmark.h"
+#include "raster/software_rasterizer.h"
+#include "geometry/sphere.h"
+
+
+namespace {
+
+struct Scene
+{
+    std::vector<SphereShaderObject::VertexBufferElement> vertices;
+    std::vector<SphereShaderObject::ColorBufferElement> colors;
+    SphereShaderObject::UnformBuffer uniforms;
+};
+
+Scene const & getScene()
+{
+    static Scene const scene = [](){
+        Scene scene;
+
+        // 2 * 708 * 708 triangles
+        auto const mesh = createSphereMesh(2.0f, 708);
+        scene.vertices.resize(mesh.size());
+        for(size_t i = 0; i < mesh.size(); ++i) {
+            scene.vertices[i].pos = mesh[i];
+            scene.vertices[i].normal = mesh[i];
+        }
+
+        scene.colors.resize(mesh.size() / 6);
+        for(size_t i = 0; i < scene.colors.size(); ++i) {
+            float const t = static_cast<float>(i) / scene.colors.size();
+            scene.colors[i] = { t, 1.0f - t, 0.5f };
+        }
+
+        // the camera of main.cpp
+        scene.uniforms.model = glm::mat4(1);
+        scene.uniforms.view = glm::lookAt(glm::vec3(0.0f, -8.0f, 0.0f), glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+        scene.uniforms.proj = glm::perspective(glm::radians(45.0f), 1920.0f / 1080.0f, 0.1f, 100'000.0f);
+        scene.uniforms.proj[1][1] *= -1;
+
+        return scene;
+    }();
+
+    return scene;
+}
+
+BENCHMARK("raster/sphere_1m_1080p", [](size_t const iterations) {
+    auto const & scene = getScene();
+    SoftwareRasterizer rasterizer(1920, 1080);
+    for(size_t i = 0; i < iterations; ++i) {
+        rasterizer.clear();
+        rasterizer.draw(scene.vertices, scene.colors, scene.uniforms);
+        doNotOptimize(rasterizer.getImage().pixels.data());
+    }
+});
+
+}
@@ -0,0 +1,155 @@
+//
+// @file:   bench_raycast.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Picking rays against the planet mesh, brute force, single rays and packets
+//
+
+#include "benchmark.h"
+#include "raycast/triangle_bvh.h"
+#include "world/world.h"
+
+#include <random>
+#include <utility>
+
+
+namespace {
+
+constexpr size_t screenSize = 512;
+
+// 300 * 300 cells, 180000 triangles
+World const & getRaycastWorld()
+{
+    static World const world = createSphereWorld(2.0f, 300);
+    return world;
+}
+
+TriangleBvh const & getBvh()
+{
+    static TriangleBvh const bvh(getRaycastWorld().vertices, getRaycastWorld().indices);
+    return bvh;
+}
+
+glm::mat4 getViewProjection()
+{
+    glm::mat4 proj = glm::perspective(glm::radians(45.0f), 1.0f, 0.1f, 100.0f);
+    proj[1][1] *= -1;
+    return proj * glm::lookAt(glm::vec3(0.0f, -8.0f, 0.0f), glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+}
+
+// one ray per pixel, neighbours in a packet are coherent like in a terrain or picking pass
+std::vector<Ray> const & getScreenRays()
+{
+    static std::vector<Ray> const rays = [](){
+        glm::mat4 const viewProjection = getViewProjection();
+        std::vector<Ray> result;
+        result.reserve(screenSize * screenSize);
+        for(size_t y = 0; y < screenSize; ++y) {
+            for(size_t x = 0; x < screenSize; ++x) {
+                glm::vec2 const ndc(static_cast<float>(x) * 2.0f / screenSize - 1.0f, static_cast<float>(y) * 2.0f / screenSize - 1.0f);
+                result.push_back(createPickingRay(ndc, viewProjection));
+            }
+        }
+        return result;
+    }();
+
+    return rays;
+}
+
+// line of sight between random points around the planet, incoherent
+std::vector<std::pair<glm::vec3, glm::vec3>> const & getSightLines()
+{
+    static std::vector<std::pair<glm::vec3, glm::vec3>> const lines = [](){
+        std::mt19937 random(7);
+        std::uniform_real_distribution<float> position(-4.0f, 4.0f);
+        std::vector<std::pair<glm::vec3, glm::vec3>> result(100'000);
+        for(auto & [from, to] : result) {
+            from = glm::vec3(position(random), position(random), position(random));
+            to = glm::vec3(position(random), position(random), position(random));
+        }
+        return result;
+    }();
+
+    return lines;
+}
+
+BENCHMARK("raycast/build_180k_triangles", [](size_t const iterations) {
+    auto const & world = getRaycastWorld();
+    for(size_t i = 0; i < iterations; ++i) {
+        TriangleBvh const bvh(world.vertices, world.indices);
+        doNotOptimize(bvh.getNodeCount());
+    }
+});
+
+BENCHMARK("raycast/refit_180k_triangles", [](size_t const iterations) {
+    static TriangleBvh bvh(getRaycastWorld().vertices, getRaycastWorld().indices);
+    for(size_t i = 0; i < iterations; ++i) {
+        bvh.refit(getRaycastWorld().vertices);
+        doNotOptimize(bvh.getNodeCount());
+    }
+});
+
+// what picking did before, every triangle for one ray
+BENCHMARK("raycast/brute_force_1_ray", [](size_t const iterations) {
+    auto const & world = getRaycastWorld();
+    Ray const ray = getScreenRays()[screenSize * screenSize / 2 + screenSize / 2];
+    for(size_t i = 0; i < iterations; ++i)
+    {
+        float closest = ray.maxDistance;
+        for(size_t index = 0; index + 2 < world.indices.size(); index += 3)
+        {
+            glm::vec3 const v0 = world.vertices[world.indices[index]];
+            glm::vec3 const e1 = world.vertices[world.indices[index + 1]] - v0;
+            glm::vec3 const e2 = world.vertices[world.indices[index + 2]] - v0;
+            glm::vec3 const p = glm::cross(ray.direction, e2);
+            float const inverse = 1.0f / glm::dot(e1, p);
+            glm::vec3 const s = ray.origin - v0;
+            glm::vec3 const q = glm::cross(s, e1);
+            float const u = glm::dot(s, p) * inverse;
+            float const v = glm::dot(ray.direction, q) * inverse;
+            float const t = glm::dot(e2, q) * inverse;
+            if(u >= 0.0f && v >= 0.0f && u + v <= 1.0f && t > 0.0f && t < closest) {
+                closest = t;
+            }
+        }
+        doNotOptimize(closest);
+    }
+});
+
+BENCHMARK("raycast/single_rays_512x512", [](size_t const iterations) {
+    auto const & bvh = getBvh();
+    auto const & rays = getScreenRays();
+    for(size_t i = 0; i < iterations; ++i)
+    {
+        size_t hits = 0;
+        for(auto const & ray : rays) {
+            hits += bvh.intersect(ray).hasHit() ? 1 : 0;
+        }
+        doNotOptimize(hits);
+    }
+});
+
+BENCHMARK("raycast/packets_512x512", [](size_t const iterations) {
+    auto const & bvh = getBvh();
+    auto const & rays = getScreenRays();
+    static std::vector<RayHit> hits(rays.size());
+    for(size_t i = 0; i < iterations; ++i) {
+        bvh.intersect(rays, hits);
+        doNotOptimize(hits.back());
+    }
+});
+
+BENCHMARK("raycast/line_of_sight_100k", [](size_t const iterations) {
+    auto const & bvh = getBvh();
+    auto const & lines = getSightLines();
+    for(size_t i = 0; i < iterations; ++i)
+    {
+        size_t visible = 0;
+        for(auto const & [from, to] : lines) {
+            visible += bvh.isVisible(from, to) ? 1 : 0;
+        }
+        doNotOptimize(visible);
+    }
+});
+
+}
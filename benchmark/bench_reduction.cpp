@@ -0,0 +1,120 @@
+//
+// @file:   bench_reduction.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Field statistics, fused into the tick, as a pass of their own and incremental
+//
+
+#include "benchmark.h"
+#include "domain/domain.h"
+#include "kernel/kernel_host.h"
+#include "kernel/diffusion_kernel.h"
+#include "reduction/field_reduction.h"
+#include "reduction/region_reduction.h"
+
+#include <random>
+
+
+namespace {
+
+// 1000 * 1000 cells with a striped temperature
+World createReductionWorld()
+{
+    World world = createSphereWorld(2.0f, 1000);
+    auto & temperature = world.addField("temperature");
+    for(size_t i = 0; i < temperature.values.size(); ++i) {
+        temperature.values[i] = (i / 1000) % 20 < 10 ? 1.0f : 0.0f;
+    }
+    return world;
+}
+
+struct Simulation
+{
+    World world = createReductionWorld();
+    KernelHost host = KernelHost(world);
+};
+
+void runTicks(size_t const iterations, bool const statistics, bool const pass)
+{
+    // the host keeps a reference to the world, so the simulation is built in place
+    static Simulation simulation;
+    if(simulation.host.getKernel() == nullptr) {
+        simulation.host.setKernel(getDiffusionKernel());
+    }
+
+    simulation.host.setStatisticsEnabled(statistics);
+    for(size_t i = 0; i < iterations; ++i)
+    {
+        simulation.host.tick(0.1);
+        if(pass) {
+            auto const & values = simulation.world.fields.front().values;
+            FieldSummary const summary = reduceField(values);
+            FieldHistogram histogram;
+            histogram.setRange(summary.min, summary.max);
+            histogram.addRange(values, 1, 0, values.size());
+            doNotOptimize(histogram.bins[0]);
+        }
+    }
+}
+
+// the cube faces of the domain partition as regions
+struct Regions
+{
+    World world = createReductionWorld();
+    std::vector<uint32_t> faces = partitionWorld(world.getView(), 6);
+    RegionReduction reduction = RegionReduction(faces, 6);
+    std::vector<uint32_t> changed;
+};
+
+Regions & getRegions()
+{
+    static Regions regions = [](){
+        Regions regions;
+        regions.reduction.build(regions.world.fields.front().values);
+
+        // 1 % of the cells change per tick
+        std::mt19937 random(42);
+        std::uniform_int_distribution<uint32_t> cell(0, static_cast<uint32_t>(regions.world.getCellCount() - 1));
+        for(size_t i = 0; i < regions.world.getCellCount() / 100; ++i) {
+            regions.changed.push_back(cell(random));
+        }
+        return regions;
+    }();
+
+    return regions;
+}
+
+}
+
+
+BENCHMARK("reduction/tick_1m", [](size_t const iterations) {
+    runTicks(iterations, false, false);
+});
+
+BENCHMARK("reduction/tick_fused_statistics_1m", [](size_t const iterations) {
+    runTicks(iterations, true, false);
+});
+
+BENCHMARK("reduction/tick_separate_pass_1m", [](size_t const iterations) {
+    runTicks(iterations, false, true);
+});
+
+BENCHMARK("reduction/region_build_1m", [](size_t const iterations) {
+    auto & regions = getRegions();
+    for(size_t i = 0; i < iterations; ++i) {
+        regions.reduction.build(regions.world.fields.front().values);
+        doNotOptimize(regions.reduction.getTotal().sum);
+    }
+});
+
+BENCHMARK("reduction/region_update_1m_1_percent", [](size_t const iterations) {
+    auto & regions = getRegions();
+    auto & values = regions.world.fields.front().values;
+    for(size_t i = 0; i < iterations; ++i) {
+        for(auto const cell : regions.changed) {
+            values[cell] += 0.01f;
+        }
+        regions.reduction.update(values, regions.changed);
+        doNotOptimize(regions.reduction.getRegion(static_cast<uint32_t>(i % 6)).sum);
+    }
+});
@@ -0,0 +1,115 @@
+//
+// @file:   bench_routing.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Shortest path queries and distance fields on sphere worlds
+//
+
+#include "benchmark.h"
+#include "routing/cell_graph.h"
+#include "routing/contraction_hierarchy.h"
+#include "routing/distance_field.h"
+#include "routing/path_finder.h"
+
+#include <random>
+#include <utility>
+
+
+namespace {
+
+// the hierarchy of 300 * 300 cells takes seconds to build, the one of 1000 * 1000 minutes
+struct Routing
+{
+    explicit Routing(size_t const n)
+        : world(createSphereWorld(2.0f, n)),
+          graph(world.getView()),
+          hierarchy(graph)
+    {
+        std::mt19937 random(42);
+        std::uniform_int_distribution<uint32_t> cell(0, static_cast<uint32_t>(graph.getNodeCount() - 1));
+        for(size_t i = 0; i < 256; ++i) {
+            queries.push_back({ cell(random), cell(random) });
+        }
+    }
+
+    World world;
+    CellGraph graph;
+    ContractionHierarchy hierarchy;
+    std::vector<std::pair<uint32_t, uint32_t>> queries;
+};
+
+template<size_t n>
+Routing const & getRouting()
+{
+    static Routing const routing(n);
+    return routing;
+}
+
+void findPaths(Routing const & routing, size_t const iterations)
+{
+    PathFinder finder(routing.graph);
+    CellPath path;
+    for(size_t i = 0; i < iterations; ++i) {
+        auto const & query = routing.queries[i % routing.queries.size()];
+        bool const found = finder.findPath(query.first, query.second, path);
+        doNotOptimize(found);
+    }
+}
+
+void findContractionDistances(Routing const & routing, size_t const iterations)
+{
+    ContractionPathFinder finder(routing.hierarchy);
+    for(size_t i = 0; i < iterations; ++i) {
+        auto const & query = routing.queries[i % routing.queries.size()];
+        float const distance = finder.findDistance(query.first, query.second);
+        doNotOptimize(distance);
+    }
+}
+
+void findContractionPaths(Routing const & routing, size_t const iterations)
+{
+    ContractionPathFinder finder(routing.hierarchy);
+    CellPath path;
+    for(size_t i = 0; i < iterations; ++i) {
+        auto const & query = routing.queries[i % routing.queries.size()];
+        bool const found = finder.findPath(query.first, query.second, path);
+        doNotOptimize(found);
+    }
+}
+
+BENCHMARK("routing/astar_90k", [](size_t const iterations) {
+    findPaths(getRouting<300>(), iterations);
+});
+
+BENCHMARK("routing/contraction_distance_90k", [](size_t const iterations) {
+    findContractionDistances(getRouting<300>(), iterations);
+});
+
+BENCHMARK("routing/contraction_path_90k", [](size_t const iterations) {
+    findContractionPaths(getRouting<300>(), iterations);
+});
+
+BENCHMARK("routing/astar_1m", [](size_t const iterations) {
+    findPaths(getRouting<1000>(), iterations);
+});
+
+BENCHMARK("routing/contraction_distance_1m", [](size_t const iterations) {
+    findContractionDistances(getRouting<1000>(), iterations);
+});
+
+BENCHMARK("routing/contraction_path_1m", [](size_t const iterations) {
+    findContractionPaths(getRouting<1000>(), iterations);
+});
+
+constexpr uint32_t fieldSources[] = { 0, 1000, 125'000, 250'000, 500'500, 640'000, 777'777, 999'000 };
+
+BENCHMARK("routing/distance_field_1m_8_sources", [](size_t const iterations) {
+    static World const world = createSphereWorld(2.0f, 1000);
+    static CellGraph const graph(world.getView());
+    for(size_t i = 0; i < iterations; ++i) {
+        auto const field = computeDistanceField(graph, fieldSources);
+        doNotOptimize(field.data());
+    }
+});
+
+}
@@ -0,0 +1,63 @@
+//
+// @file:   bench_snapshot.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Loading a world from a snapshot against building it
+//
+
+#include "benchmark.h"
+#include "world/world.h"
+#include "snapshot/world_snapshot.h"
+
+#include <filesystem>
+#include <stdexcept>
+
+
+namespace {
+
+constexpr size_t resolution = 1000;
+
+std::string const & getSnapshotFile()
+{
+    static std::string const filename = [](){
+        auto const path = (std::filesystem::temp_directory_path() / "bench_world.snapshot").string();
+
+        World world = createSphereWorld(2.0f, resolution);
+        world.addField("temperature", 1, 1.0f);
+        if(!WorldSnapshot::write(path, world.getView())) {
+            throw std::runtime_error("failed to write " + path);
+        }
+
+        return path;
+    }();
+
+    return filename;
+}
+
+BENCHMARK("snapshot/create_world_1m", [](size_t const iterations) {
+    for(size_t i = 0; i < iterations; ++i) {
+        World world = createSphereWorld(2.0f, resolution);
+        world.addField("temperature", 1, 1.0f);
+        doNotOptimize(world.vertices.data());
+    }
+});
+
+BENCHMARK("snapshot/open_1m", [](size_t const iterations) {
+    auto const & filename = getSnapshotFile();
+    for(size_t i = 0; i < iterations; ++i) {
+        WorldSnapshot snapshot;
+        bool const ok = snapshot.open(filename);
+        doNotOptimize(ok);
+    }
+});
+
+BENCHMARK("snapshot/open_verify_1m", [](size_t const iterations) {
+    auto const & filename = getSnapshotFile();
+    for(size_t i = 0; i < iterations; ++i) {
+        WorldSnapshot snapshot;
+        bool const ok = snapshot.open(filename) && snapshot.verify();
+        doNotOptimize(ok);
+    }
+});
+
+}
@@ -0,0 +1,232 @@
+//
+// @file:   bench_tasks.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  CPU work of a frame with many objects, one after another and as a task graph
+//
+
+#include "benchmark.h"
+#include "colormap/colormap.h"
+#include "sphere/sphere_shader_object.h"
+#include "tasks/task_graph.h"
+#include "include_glm.h"
+
+#include <cmath>
+#include <deque>
+
+
+namespace {
+
+constexpr size_t objectCount = 64;
+constexpr size_t cellsPerObject = 20'000;
+
+// what a draw of a SphereShaderObject computes on the CPU, vertices moved by the model matrix and a colormapped field
+struct FrameObject
+{
+    glm::mat4 model = glm::mat4(1);
+    std::vector<glm::vec3> vertices = std::vector<glm::vec3>(cellsPerObject * 6);
+    std::vector<glm::vec3> transformed = std::vector<glm::vec3>(cellsPerObject * 6);
+    std::vector<float> field = std::vector<float>(cellsPerObject);
+    std::vector<SphereShaderObject::ColorBufferElement> colors = std::vector<SphereShaderObject::ColorBufferElement>(cellsPerObject);
+    Colormap colormap = Colormap(ColormapType::eViridis);
+    bool visible = false;
+};
+
+std::vector<FrameObject> & getObjects()
+{
+    static std::vector<FrameObject> objects = [](){
+        std::vector<FrameObject> result(objectCount);
+        for(size_t object = 0; object < result.size(); ++object)
+        {
+            auto & frameObject = result[object];
+            frameObject.model = glm::translate(glm::mat4(1), glm::vec3(static_cast<float>(object), 0.0f, 0.0f));
+            for(size_t i = 0; i < frameObject.vertices.size(); ++i) {
+                frameObject.vertices[i] = glm::vec3(std::sin(i * 0.01f), std::cos(i * 0.01f), i * 0.0001f);
+            }
+            for(size_t i = 0; i < frameObject.field.size(); ++i) {
+                frameObject.field[i] = std::sin((i + object) * 0.001f) * 50.0f;
+            }
+            frameObject.colormap.setAutomaticRange(true);
+        }
+        return result;
+    }();
+
+    return objects;
+}
+
+void cull(FrameObject & object, glm::mat4 const & viewProjection)
+{
+    glm::vec4 const center = viewProjection * object.model * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+    object.visible = center.w > 0.0f;
+}
+
+void transform(FrameObject & object)
+{
+    for(size_t i = 0; i < object.vertices.size(); ++i) {
+        object.transformed[i] = glm::vec3(object.model * glm::vec4(object.vertices[i], 1.0f));
+    }
+}
+
+void colorize(FrameObject & object)
+{
+    object.colormap.apply(object.field, object.colors);
+}
+
+glm::mat4 const viewProjection = glm::perspective(0.8f, 1.7f, 0.1f, 1000.0f) *
+    glm::lookAt(glm::vec3(0.0f, -8.0f, 0.0f), glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+
+BENCHMARK("tasks/frame_serial_64_objects", [](size_t const iterations) {
+    auto & objects = getObjects();
+    for(size_t i = 0; i < iterations; ++i)
+    {
+        for(auto & object : objects)
+        {
+            cull(object, viewProjection);
+            if(object.visible) {
+                transform(object);
+                colorize(object);
+            }
+        }
+        doNotOptimize(objects.back().colors.back());
+    }
+});
+
+// the graph is built once, culling gates the transform and the colormap of every object
+BENCHMARK("tasks/frame_graph_64_objects", [](size_t const iterations) {
+    auto & objects = getObjects();
+
+    TaskGraph graph;
+    for(auto & object : objects)
+    {
+        FrameObject * const frameObject = &object;
+        auto const culled = graph.add([frameObject]() { cull(*frameObject, viewProjection); });
+        graph.add([frameObject]() {
+            if(frameObject->visible) {
+                transform(*frameObject);
+            }
+        }, { culled });
+        graph.add([frameObject]() {
+            if(frameObject->visible) {
+                colorize(*frameObject);
+            }
+        }, { culled });
+    }
+
+    for(size_t i = 0; i < iterations; ++i)
+    {
+        graph.run();
+        doNotOptimize(objects.back().colors.back());
+    }
+});
+
+// the update delegates of SphereShaderObjects as main sets them for a field of the world,
+// plus vertices moved by the model matrix, filled into the staging buffers by the update tasks
+struct SphereFrameObject
+{
+    static constexpr size_t cellCount = 100 * 100;
+
+    SphereShaderObject shaderObject = SphereShaderObject(cellCount * 6, cellCount);
+    glm::mat4 model = glm::mat4(1);
+    std::vector<glm::vec3> vertices = std::vector<glm::vec3>(cellCount * 6);
+    std::vector<float> field = std::vector<float>(cellCount);
+    Colormap colormap = Colormap(ColormapType::eViridis);
+
+    explicit SphereFrameObject(size_t const object)
+    {
+        model = glm::translate(glm::mat4(1), glm::vec3(static_cast<float>(object), 0.0f, 0.0f));
+        for(size_t i = 0; i < vertices.size(); ++i) {
+            vertices[i] = glm::vec3(std::sin(i * 0.01f), std::cos(i * 0.01f), i * 0.0001f);
+        }
+        for(size_t i = 0; i < field.size(); ++i) {
+            field[i] = std::sin((i + object) * 0.001f) * 50.0f;
+        }
+        colormap.setAutomaticRange(true);
+
+        shaderObject.updateVertexBuffer.set<&SphereFrameObject::updateVertices>(*this);
+        shaderObject.updateColorBuffer.set<&SphereFrameObject::updateColors>(*this);
+        shaderObject.updateUniformBuffer.set<&SphereFrameObject::updateUniforms>(*this);
+    }
+
+    void updateVertices(std::span<SphereShaderObject::VertexBufferElement> data)
+    {
+        for(size_t i = 0; i < data.size(); ++i) {
+            data[i].pos = glm::vec3(model * glm::vec4(vertices[i], 1.0f));
+            data[i].normal = glm::normalize(data[i].pos);
+        }
+    }
+
+    void updateColors(std::span<SphereShaderObject::ColorBufferElement> data)
+    {
+        colormap.apply(field, data);
+    }
+
+    void updateUniforms(std::span<SphereShaderObject::UnformBuffer> data)
+    {
+        data[0].model = model;
+        data[0].view = glm::lookAt(glm::vec3(0.0f, -8.0f, 0.0f), glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+        data[0].proj = glm::perspective(0.8f, 1.7f, 0.1f, 1000.0f);
+        data[0].lightPosition = glm::vec3(10.0f, 10.0f, 10.0f);
+        data[0].ambient = 0.2f;
+    }
+};
+
+// the shader objects refer to themselves, they stay in place
+std::deque<SphereFrameObject> & getSphereObjects()
+{
+    static std::deque<SphereFrameObject> objects = [](){
+        std::deque<SphereFrameObject> result;
+        for(size_t object = 0; object < 16; ++object) {
+            result.emplace_back(object);
+        }
+        return result;
+    }();
+
+    return objects;
+}
+
+void addSphereUpdates(TaskGraph & graph)
+{
+    for(auto & object : getSphereObjects()) {
+        object.shaderObject.addUpdateTasks(graph, {});
+    }
+}
+
+// the staging of the draws of a frame on the calling thread only, like the serial draw did
+BENCHMARK("tasks/sphere_updates_1_thread_16_objects", [](size_t const iterations) {
+    static ThreadPool pool(0);
+    static TaskGraph graph;
+    if(graph.empty()) {
+        addSphereUpdates(graph);
+    }
+
+    for(size_t i = 0; i < iterations; ++i) {
+        graph.run(pool);
+    }
+});
+
+// the same graph on all cores, as the frame graph of main runs it
+BENCHMARK("tasks/sphere_updates_graph_16_objects", [](size_t const iterations) {
+    static TaskGraph graph;
+    if(graph.empty()) {
+        addSphereUpdates(graph);
+    }
+
+    for(size_t i = 0; i < iterations; ++i) {
+        graph.run();
+    }
+});
+
+// overhead of the scheduler itself, one task that starts 999 empty ones
+BENCHMARK("tasks/graph_1000_empty_tasks", [](size_t const iterations) {
+    TaskGraph graph;
+    auto const root = graph.add([]() {});
+    for(size_t task = 0; task < 999; ++task) {
+        graph.add([]() {}, { root });
+    }
+
+    for(size_t i = 0; i < iterations; ++i) {
+        graph.run();
+    }
+});
+
+}
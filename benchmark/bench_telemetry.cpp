@@ -0,0 +1,35 @@
+//
+// @file:   bench_telemetry.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Cost of recording telemetry on the hot path
+//
+
+#include "benchmark.h"
+#include "telemetry/telemetry.h"
+
+
+namespace {
+
+BENCHMARK("telemetry/counter_add", [](size_t const iterations) {
+    auto const counter = getTelemetry().getCounter("benchmark.counter");
+    for(size_t i = 0; i < iterations; ++i) {
+        counter.add(i);
+    }
+});
+
+BENCHMARK("telemetry/histogram_record", [](size_t const iterations) {
+    auto const histogram = getTelemetry().getHistogram("benchmark.histogram");
+    for(size_t i = 0; i < iterations; ++i) {
+        histogram.record(i);
+    }
+});
+
+BENCHMARK("telemetry/snapshot", [](size_t const iterations) {
+    for(size_t i = 0; i < iterations; ++i) {
+        auto const snapshot = getTelemetry().getSnapshot();
+        doNotOptimize(snapshot.counters.size());
+    }
+});
+
+}
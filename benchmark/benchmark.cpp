@@ -0,0 +1,107 @@
+//
+// @file:   benchmark.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Runs all registered benchmarks and writes the results as json
+//
+
+#include "benchmark.h"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+using namespace std;
+
+
+std::vector<Benchmark>& Benchmark::registry()
+{
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+// runs a benchmark with growing iteration counts until it takes long enough to measure
+double measure(Benchmark const & benchmark, double const minSeconds)
+{
+    using Clock = std::chrono::steady_clock;
+
+    // untimed, builds the data that benchmarks create on their first call
+    benchmark.function(1);
+
+    size_t iterations = 1;
+    while(true)
+    {
+        auto const start = Clock::now();
+        benchmark.function(iterations);
+        double const seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        if(seconds >= minSeconds || iterations >= (size_t(1) << 40)) {
+            return seconds * 1e9 / iterations;
+        }
+
+        double const factor = seconds > 0.0 ? minSeconds / seconds : 1000.0;
+        iterations *= std::clamp<size_t>(static_cast<size_t>(factor * 1.2), 2, 1000);
+    }
+}
+
+int main(int const argc, char const * argv[])
+{
+    std::string filter;
+    std::string output;
+    double minSeconds = 0.2;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        std::string const arg = argv[i];
+        if(arg == "--filter" && i + 1 < argc) {
+            filter = argv[++i];
+        }
+        else if(arg == "--out" && i + 1 < argc) {
+            output = argv[++i];
+        }
+        else if(arg == "--min-time" && i + 1 < argc) {
+            minSeconds = std::stod(argv[++i]);
+        }
+        else {
+            cout << "Usage: [--filter Substring] [--out Results.json] [--min-time Seconds]" << endl;
+            return 1;
+        }
+    }
+
+    std::ofstream file;
+    if(!output.empty()) {
+        file.open(output);
+        if(!file.is_open()) {
+            cout << "failed to create " << output << endl;
+            return 1;
+        }
+    }
+
+    std::ostream & out = output.empty() ? cout : file;
+
+    out << "{" << endl;
+    out << "  \"benchmarks\": [" << endl;
+
+    bool first = true;
+    for(auto const & benchmark : Benchmark::registry())
+    {
+        if(!filter.empty() && benchmark.name.find(filter) == std::string::npos) {
+            continue;
+        }
+
+        double const ns = measure(benchmark, minSeconds);
+        if(!output.empty()) {
+            cout << std::left << std::setw(48) << benchmark.name << std::right << std::setw(16) << std::fixed << std::setprecision(1) << ns << " ns" << endl;
+        }
+
+        out << (first ? "" : ",\n") << "    { \"name\": \"" << benchmark.name << "\", \"ns_per_op\": " << std::setprecision(3) << std::fixed << ns << " }";
+        first = false;
+    }
+
+    out << endl << "  ]" << endl;
+    out << "}" << endl;
+
+    return 0;
+}
@@ -0,0 +1,55 @@
+//
+// @file:   benchmark.h
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Minimal benchmark registry
+//
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <cstddef>
+
+
+//
+// @class:  Benchmark
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  A registered benchmark, the function runs the measured code
+//          iterations times
+//
+struct Benchmark
+{
+    using Function = std::function<void(size_t const iterations)>;
+
+    std::string name;
+    Function function;
+
+    static std::vector<Benchmark>& registry();
+};
+
+struct BenchmarkRegistration
+{
+    BenchmarkRegistration(std::string const & name, Benchmark::Function function) {
+        Benchmark::registry().push_back({name, std::move(function)});
+    }
+};
+
+// keeps the compiler from removing the computation of value
+template<typename T>
+inline void doNotOptimize(T const & value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static_cast<void>(*static_cast<char const volatile *>(static_cast<void const *>(&value)));
+#endif
+}
+
+#define BENCHMARK_CONCAT_IMPL(a, b) a##b
+#define BENCHMARK_CONCAT(a, b) BENCHMARK_CONCAT_IMPL(a, b)
+
+#define BENCHMARK(name, function) \
+    static BenchmarkRegistration const BENCHMARK_CONCAT(benchmarkRegistration, __LINE__)(name, function)
@@ -8,11 +8,14 @@
 #include <vector>
 #include <fstream>
 #include <iostream>
-#include <iomanip>
-#include <chrono>
-#include <ctime>
 #include <filesystem>
-#include <bit>
+#include <array>
+#include <string>
+#include <string_view>
+#include <stdexcept>
+#include <cstdio>
+
+#include "snapshot/checksum.h"
 
 inline std::vector<char> read_file(const std::string& filename) {
 	std::ifstream file(filename, std::ios::ate | std::ios::binary);
@@ -37,85 +40,251 @@ namespace fs = std::filesystem;
 
 using namespace std;
 
+// bump when the generated code changes
+constexpr uint64_t format_version = 3;
+
+enum class Mode {
+	eArray,		// constexpr std::array<char, N>, works everywhere
+	eString,	// string literal, compiles much faster (MSVC limits literals to 64 KB)
+	eEmbed,		// #embed, needs a C++26 preprocessor
+	eIncbin,	// .incbin assembly, GCC and Clang on ELF targets
+};
+
+// the hash line of an existing output, empty if there is none
+std::string read_hash_line(std::string const & filename)
+{
+	std::ifstream file(filename);
+	std::string line;
+	for (size_t i = 0; i < 8 && std::getline(file, line); ++i)
+	{
+		if (line.rfind("/// @hash:", 0) == 0) {
+			return line;
+		}
+	}
+
+	return {};
+}
+
+// text in a string literal, quotes and backslashes escaped
+std::string escape_string(std::string_view const text)
+{
+	std::string out;
+	out.reserve(text.size());
+	for (char const c : text)
+	{
+		if (c == '\n') {
+			throw std::runtime_error("a path with a line break can not be embedded");
+		}
+		if (c == '"' || c == '\\') {
+			out += '\\';
+		}
+		out += c;
+	}
+
+	return out;
+}
+
+// every byte as a signed decimal plus comma, looked up instead of formatted
+std::array<std::string, 256> create_number_table()
+{
+	std::array<std::string, 256> table;
+	for (int i = 0; i < 256; ++i) {
+		table[i] = std::to_string(static_cast<int>(static_cast<signed char>(i))) + ",";
+	}
+
+	return table;
+}
+
+void append_array(std::string & out, std::vector<char> const & file)
+{
+	auto const table = create_number_table();
+
+	for (size_t i = 0; i < file.size(); ++i)
+	{
+		out += table[static_cast<unsigned char>(file[i])];
+		if (i % 32 == 31) {
+			out += '\n';
+		}
+	}
+}
+
+void append_string(std::string & out, std::vector<char> const & file)
+{
+	// printable characters stay as they are, the rest become 3 digit octal escapes
+	// so the next character can never be taken as part of the escape
+	out += '"';
+	size_t line = 0;
+	for (size_t i = 0; i < file.size(); ++i)
+	{
+		auto const c = static_cast<unsigned char>(file[i]);
+		if (c >= ' ' && c <= '~' && c != '"' && c != '\\' && c != '?') {
+			out += static_cast<char>(c);
+			line += 1;
+		}
+		else {
+			char escape[5] = { '\\', static_cast<char>('0' + (c >> 6)), static_cast<char>('0' + ((c >> 3) & 7)), static_cast<char>('0' + (c & 7)), 0 };
+			out += escape;
+			line += 4;
+		}
+
+		if (line >= 120 && i + 1 < file.size()) {
+			out += "\"\n\"";
+			line = 0;
+		}
+	}
+	out += '"';
+}
+
+std::string create_header(Mode const mode, std::string const & variable_name, std::string const & input_file_name,
+	std::string const & absolute, std::string const & filename, std::string const & hash_line, std::vector<char> const & file)
+{
+	std::string out;
+	out.reserve(file.size() * (mode == Mode::eArray ? 5 : 3) + 1024);
+
+	out += "///\n";
+	out += "/// @file: " + filename + "\n";
+	out += "/// @author: embedfile\n";
+	out += "/// @brief: " + input_file_name + "\n";
+	out += hash_line + "\n";
+	out += "///\n";
+	out += "\n";
+	out += "#pragma once\n";
+	out += "\n";
+
+	auto const size = std::to_string(file.size());
+
+	switch (mode)
+	{
+	case Mode::eArray:
+		out += "#include <array>\n";
+		out += "#include <cstdint>\n";
+		out += "\n";
+		out += "alignas(16) constexpr std::array<char, " + size + "> " + variable_name + " = { \n";
+		append_array(out, file);
+		out += "\n};\n";
+		break;
+
+	case Mode::eString:
+		out += "#include <span>\n";
+		out += "\n";
+		out += "alignas(16) inline constexpr char " + variable_name + "_data[" + size + " + 1] = \n";
+		append_string(out, file);
+		out += ";\n\n";
+		out += "constexpr std::span<char const, " + size + "> " + variable_name + "(" + variable_name + "_data, " + size + ");\n";
+		break;
+
+	case Mode::eEmbed:
+		// the name of #embed has no escapes, like the one of #include, a backslash is taken as it is
+		if (absolute.find_first_of("\"\n") != std::string::npos) {
+			throw std::runtime_error("a path with a quote or a line break can not be used with #embed");
+		}
+		out += "#include <span>\n";
+		out += "\n";
+		out += "alignas(16) inline constexpr char " + variable_name + "_data[] = {\n";
+		out += "#embed \"" + absolute + "\"\n";
+		out += "};\n\n";
+		out += "constexpr std::span<char const, " + size + "> " + variable_name + "(" + variable_name + "_data, " + size + ");\n";
+		break;
+
+	case Mode::eIncbin:
+		// a comdat group keeps a single copy when the header is included in several translation units
+		out += "#include <span>\n";
+		out += "\n";
+		out += "#if !defined(__ELF__)\n";
+		out += "#error \"embedfile --mode incbin needs an ELF target\"\n";
+		out += "#endif\n";
+		out += "\n";
+		out += "__asm__(\n";
+		out += "    \".pushsection .rodata." + variable_name + ",\\\"aG\\\",@progbits," + variable_name + "_embed,comdat\\n\"\n";
+		out += "    \".weak " + variable_name + "_data\\n\"\n";
+		out += "    \".balign 16\\n\"\n";
+		out += "    \"" + variable_name + "_data:\\n\"\n";
+		// escaped for the assembler string and again for the C++ string around it
+		out += "    \".incbin \\\"" + escape_string(escape_string(absolute)) + "\\\"\\n\"\n";
+		out += "    \".byte 0\\n\"\n";
+		out += "    \".popsection\\n\"\n";
+		out += ");\n";
+		out += "\n";
+		out += "extern \"C\" char const " + variable_name + "_data[];\n";
+		out += "\n";
+		out += "inline std::span<char const, " + size + "> const " + variable_name + "(" + variable_name + "_data, " + size + ");\n";
+		break;
+	}
+
+	return out;
+}
+
 int main(int const argc, char const * argv[])
 {
-	if (argc <= 3)
+	Mode mode = Mode::eArray;
+	std::vector<std::string> args;
+
+	for (int i = 1; i < argc; ++i)
 	{
-		cout << "Usage: [VariableName] [InputFileName] [OutputFileName]" << endl;
+		std::string_view const arg = argv[i];
+		if (arg == "--mode" && i + 1 < argc)
+		{
+			std::string_view const value = argv[++i];
+			if (value == "array") mode = Mode::eArray;
+			else if (value == "string") mode = Mode::eString;
+			else if (value == "embed") mode = Mode::eEmbed;
+			else if (value == "incbin") mode = Mode::eIncbin;
+			else {
+				cout << "Unknown mode: " << value << endl;
+				return 1;
+			}
+		}
+		else {
+			args.emplace_back(arg);
+		}
+	}
+
+	if (args.size() < 3)
+	{
+		cout << "Usage: [--mode array|string|embed|incbin] [VariableName] [InputFileName] [OutputFileName]" << endl;
 		return 1;
 	}
 
 	try {
-        std::string const variable_name = argv[1];
-        std::string const input_file_name = argv[2];
-        std::string const output_file_name = argv[3];
+        std::string const & variable_name = args[0];
+        std::string const & input_file_name = args[1];
+        std::string const & output_file_name = args[2];
 
 		auto const file = read_file(input_file_name);
 
 		fs::path p = output_file_name;
 		string filename = p.filename().string();
 
-		ofstream out(output_file_name);
+		// embed and incbin refer to the input by its path
+		auto const absolute = fs::absolute(input_file_name).generic_string();
 
+		// the output only depends on the content, the settings and the format version
+		uint64_t const settings[] = { format_version, static_cast<uint64_t>(mode),
+			checksum64(std::as_bytes(std::span(variable_name))),
+			mode == Mode::eEmbed || mode == Mode::eIncbin ? checksum64(std::as_bytes(std::span(absolute))) : 0 };
+		uint64_t const hash = checksum64(std::as_bytes(std::span(file)), checksum64(std::as_bytes(std::span(settings))));
 
-		if (!out.is_open()) {
-			throw std::runtime_error("failed to create file!");
+		char hash_line[64];
+		std::snprintf(hash_line, sizeof(hash_line), "/// @hash: %016llx", static_cast<unsigned long long>(hash));
+
+		// leave unchanged outputs alone so nothing depending on them is rebuilt
+		if (fs::exists(output_file_name) && read_hash_line(output_file_name) == hash_line) {
+			return 0;
 		}
 
-		// calculate time
-		// auto const now = std::chrono::system_clock::now();
-		// std::time_t const now_time = std::chrono::system_clock::to_time_t(now);
-
-		out << "///" << endl;
-		out << "/// @file: " << filename << endl;
-		std::time_t result = std::time(nullptr);
-		char str[128];
-		ctime_s(str, sizeof(str), &result);
-		out << "/// @date: " << str;
-		out << "/// @author: embedfile" << endl;
-		out << "/// @brief: " << input_file_name << endl;
-		out << "///" << endl;
-		out << endl;
-		out << "#pragma once" << endl;
-		out << endl;
-		out << "#include <array>" << endl;
-		out << "#include <cstdint>" << endl;
-		out << endl;
-		out << "constexpr std::array<char, " << file.size() << "> " << variable_name << " = { " << endl;
-
-		size_t i = 0;
-		while(i < file.size())
-		{
-			//out << "  ";
-			for (size_t j = 0; j < 16 && i+j < file.size(); ++j)
-			{
-				out << setw(4) << static_cast<int>(file[i+j]);
-				if (i+j < file.size() - 1)
-				{
-					out << ",";
-				}
-			}
+		auto const header = create_header(mode, variable_name, input_file_name, absolute, filename, hash_line, file);
 
-			out << " //";
-
-			for (size_t j = 0; j < 16 && i+j < file.size(); ++j)
-			{
-				char const sign = file[i+j];
-				if(sign >= ' ' && sign <= 'z' && sign != '\\') {
-					out << " " << sign;
-				}
-				else {
-					out << " .";
-				}
-			}
-
-			out << endl;
-			i += 16;
+		ofstream out(output_file_name, std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!out.is_open()) {
+			throw std::runtime_error("failed to create file!");
 		}
 
-		out << "};" << endl;
-
+		out.write(header.data(), static_cast<std::streamsize>(header.size()));
 		out.close();
+
+		if (!out) {
+			throw std::runtime_error("failed to write file!");
+		}
 	}
 	catch (exception const& e)
 	{
@@ -125,10 +294,3 @@ int main(int const argc, char const * argv[])
 
 	return 0;
 }
-
-
-
-
-
-
-
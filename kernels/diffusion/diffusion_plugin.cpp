@@ -0,0 +1,13 @@
+//
+// @file:   diffusion_plugin.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Exports the diffusion kernel from a library, for hot swapping
+//
+
+#include "kernel/diffusion_kernel.h"
+
+WSS_KERNEL_EXPORT WssKernel const * wssGetKernel()
+{
+    return getDiffusionKernel();
+}
@@ -0,0 +1,76 @@
+#!/usr/bin/env bash
+#
+# \file       bench_embedfile.sh
+# \author     FirePrincess
+# \date       2026-10-19
+#
+# Times embedfile on random inputs in every mode: generating the header and
+# compiling a translation unit that includes it.
+#
+#   scripts/bench_embedfile.sh Embedfile [SizeInMB...]
+#
+# CXX selects the compiler, g++ by default. OLD_EMBEDFILE adds a column for
+# another build, e.g. one without --mode. Arrays above ARRAY_COMPILE_MB,
+# 10 by default, are generated but not compiled, they take minutes.
+#
+
+set -euo pipefail
+
+if [[ $# -lt 1 ]]; then
+    echo "Usage: $0 Embedfile [SizeInMB...]"
+    exit 1
+fi
+
+embedfile=$(realpath "$1")
+shift
+sizes=("$@")
+if [[ ${#sizes[@]} -eq 0 ]]; then
+    sizes=(1 10 100)
+fi
+
+cxx=${CXX:-g++}
+array_compile_mb=${ARRAY_COMPILE_MB:-10}
+
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+cd "$work"
+
+# milliseconds of a command, n/a if it fails
+elapsed() {
+    local start=$EPOCHREALTIME
+    if ! "$@" > /dev/null 2>&1; then
+        echo "n/a"
+        return
+    fi
+    local end=$EPOCHREALTIME
+    awk -v s="${start/,/.}" -v e="${end/,/.}" 'BEGIN { printf "%.0f ms", (e - s) * 1000 }'
+}
+
+modes=(array string embed incbin)
+
+printf "%-12s %-10s %14s %14s %10s\n" "size" "mode" "generation" "compile" "header"
+for size in "${sizes[@]}"
+do
+    head -c $((size * 1024 * 1024)) /dev/urandom > input.bin
+
+    if [[ -n ${OLD_EMBEDFILE:-} ]]; then
+        rm -f old.h
+        printf "%-12s %-10s %14s %14s %10s\n" "$size MB" "old" "$(elapsed "$OLD_EMBEDFILE" data input.bin old.h)" "" ""
+    fi
+
+    for mode in "${modes[@]}"
+    do
+        # a header with the same hash would be left alone
+        rm -f "data_$mode.h"
+        generation=$(elapsed "$embedfile" --mode "$mode" data input.bin "data_$mode.h")
+
+        printf '#include "data_%s.h"\nint main() { return data[0] == 0 ? 0 : 1; }\n' "$mode" > "use_$mode.cpp"
+        compile=""
+        if [[ $mode != array || $size -le $array_compile_mb ]]; then
+            compile=$(elapsed "$cxx" -std=c++20 -O2 -c "use_$mode.cpp" -o "use_$mode.o")
+        fi
+
+        header=$(du -h "data_$mode.h" 2>/dev/null | cut -f1 || true)
+        printf "%-12s %-10s %14s %14s %10s\n" "$size MB" "$mode" "$generation" "$compile" "$header"
+    done
+done
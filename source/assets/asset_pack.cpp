@@ -0,0 +1,141 @@
+//
+// @file:   asset_pack.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Looks up entries of an asset pack, decompresses them on first use
+//
+
+#include "asset_pack.h"
+#include "assets_pack.h"
+#include "snapshot/checksum.h"
+
+#include <lz4.h>
+#include <algorithm>
+#include <stdexcept>
+
+
+namespace {
+
+bool hasChecksum(std::span<char const> const data, asset_pack::Entry const & entry)
+{
+    return checksum64(std::as_bytes(data)) == entry.checksum;
+}
+
+}
+
+
+AssetPack::AssetPack(std::span<char const> const data)
+    : mData(data)
+{
+    using namespace asset_pack;
+
+    if(data.size() < sizeof(Header)) {
+        throw std::runtime_error("asset pack is too small");
+    }
+
+    Header header;
+    std::copy_n(data.data(), sizeof(header), reinterpret_cast<char*>(&header));
+    if(header.magic != magic || header.version != version) {
+        throw std::runtime_error("unknown asset pack format");
+    }
+
+    size_t const entriesSize = sizeof(Entry) * header.entryCount;
+    if(sizeof(Header) + entriesSize > data.size()) {
+        throw std::runtime_error("asset pack is truncated");
+    }
+
+    mEntries = { reinterpret_cast<Entry const *>(data.data() + sizeof(Header)), header.entryCount };
+
+    size_t const namesBegin = sizeof(Header) + entriesSize;
+    size_t namesEnd = namesBegin;
+    for(auto const & entry : mEntries)
+    {
+        namesEnd = std::max<size_t>(namesEnd, namesBegin + entry.nameOffset + entry.nameSize);
+        if(entry.dataOffset > data.size() || entry.compressedSize > data.size() - entry.dataOffset) {
+            throw std::runtime_error("asset pack is truncated");
+        }
+    }
+
+    if(namesEnd > data.size()) {
+        throw std::runtime_error("asset pack is truncated");
+    }
+
+    mNames = std::string_view(data.data() + namesBegin, namesEnd - namesBegin);
+    mCache.resize(mEntries.size());
+    mChecked.resize(mEntries.size());
+}
+
+asset_pack::Entry const * AssetPack::find(std::string_view const name) const
+{
+    auto const it = std::lower_bound(mEntries.begin(), mEntries.end(), name,
+        [&](asset_pack::Entry const & entry, std::string_view const value) {
+            return mNames.substr(entry.nameOffset, entry.nameSize) < value;
+        });
+
+    if(it == mEntries.end() || mNames.substr(it->nameOffset, it->nameSize) != name) {
+        return nullptr;
+    }
+
+    return &*it;
+}
+
+std::span<char const> AssetPack::get(std::string_view const name)
+{
+    auto const entry = find(name);
+    if(entry == nullptr) {
+        return {};
+    }
+
+    auto const stored = mData.subspan(entry->dataOffset, entry->compressedSize);
+    size_t const index = static_cast<size_t>(entry - mEntries.data());
+
+    std::lock_guard lock(mMutex);
+
+    // entries that did not shrink are handed out in place, checked on first use like the others
+    if(entry->compressedSize == entry->size)
+    {
+        if(!mChecked[index]) {
+            if(!hasChecksum(stored, *entry)) {
+                throw std::runtime_error("asset " + std::string(name) + " is corrupted");
+            }
+            mChecked[index] = true;
+        }
+        return stored;
+    }
+
+    auto & cached = mCache[index];
+    if(!cached)
+    {
+        auto buffer = std::make_unique<char[]>(entry->size);
+        int const size = LZ4_decompress_safe(stored.data(), buffer.get(),
+            static_cast<int>(stored.size()), static_cast<int>(entry->size));
+        if(size != static_cast<int>(entry->size) || !hasChecksum({ buffer.get(), entry->size }, *entry)) {
+            throw std::runtime_error("failed to decompress asset " + std::string(name));
+        }
+
+        cached = std::move(buffer);
+    }
+
+    return { cached.get(), entry->size };
+}
+
+bool AssetPack::contains(std::string_view const name) const
+{
+    return find(name) != nullptr;
+}
+
+size_t AssetPack::size() const
+{
+    return mEntries.size();
+}
+
+std::string_view AssetPack::getName(size_t const index) const
+{
+    return mNames.substr(mEntries[index].nameOffset, mEntries[index].nameSize);
+}
+
+AssetPack& getBuiltinAssets()
+{
+    static AssetPack pack(assets_pack);
+    return pack;
+}
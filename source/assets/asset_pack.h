@@ -0,0 +1,54 @@
+//
+// @file:   asset_pack.h
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Looks up entries of an asset pack, decompresses them on first use
+//
+
+#pragma once
+
+#include "asset_pack_format.h"
+
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string_view>
+#include <vector>
+
+
+//
+// @class:  AssetPack
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  get() finds an entry with a binary search over the sorted index.
+//          Compressed entries are decompressed once and cached, the returned
+//          span stays valid as long as the pack lives. Every entry is
+//          checked against its checksum on first use.
+//
+class AssetPack
+{
+public:
+    explicit AssetPack(std::span<char const> const data);
+
+    // empty span if there is no entry with this name
+    std::span<char const> get(std::string_view const name);
+
+    bool contains(std::string_view const name) const;
+
+    size_t size() const;
+    std::string_view getName(size_t const index) const;
+
+private:
+    std::span<char const> mData;
+    std::span<asset_pack::Entry const> mEntries;
+    std::string_view mNames;
+
+    std::mutex mMutex;
+    std::vector<std::unique_ptr<char[]>> mCache;
+    std::vector<bool> mChecked;                 // of the entries stored uncompressed
+
+    asset_pack::Entry const * find(std::string_view const name) const;
+};
+
+// the pack built from the assets and shaders of this project
+AssetPack& getBuiltinAssets();
@@ -0,0 +1,45 @@
+//
+// @file:   asset_pack_format.h
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  File format of the asset pack, shared by assetpack and AssetPack
+//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+
+//
+// Pack layout:
+//
+//   Header
+//   Entry[entryCount]      sorted by name
+//   names                  not null terminated
+//   data                   every entry starts at a multiple of alignment
+//
+namespace asset_pack
+{
+    constexpr std::array<char, 8> magic = { 'W', 'S', 'S', 'P', 'A', 'C', 'K', '\0' };
+    constexpr uint32_t version = 1;
+    constexpr uint64_t alignment = 16;
+
+    struct Header {
+        std::array<char, 8> magic;
+        uint32_t version;
+        uint32_t entryCount;
+    };
+
+    struct Entry {
+        uint32_t nameOffset;
+        uint32_t nameSize;
+        uint64_t dataOffset;
+        uint64_t compressedSize;    // equal to size if the entry is stored uncompressed
+        uint64_t size;
+        uint64_t checksum;          // checksum64 of the uncompressed data
+    };
+
+    static_assert(sizeof(Header) == 16);
+    static_assert(sizeof(Entry) == 40);
+}
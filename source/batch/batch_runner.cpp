@@ -0,0 +1,293 @@
+//
+// @file:   batch_runner.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Runs the simulation without a window as fast as possible
+//
+
+#include "batch_runner.h"
+#include "kernel/kernel_host.h"
+#include "kernel/diffusion_kernel.h"
+#include "snapshot/world_snapshot.h"
+#include "raster/software_rasterizer.h"
+#include "recording/sim_recorder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double getSeconds(Clock::time_point const start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+std::string getFilename(std::string const & prefix, uint64_t const tick, char const * extension)
+{
+    char number[32];
+    std::snprintf(number, sizeof(number), "_%08llu", static_cast<unsigned long long>(tick));
+    return prefix + number + extension;
+}
+
+}
+
+
+BatchRunner::BatchRunner(BatchSettings const & settings)
+    : mSettings(settings),
+      mColormap(ColormapType::eViridis)
+{
+    mColormap.setAutomaticRange(true);
+}
+
+BatchRunner::~BatchRunner() = default;
+
+World const & BatchRunner::getWorld() const
+{
+    return mWorld;
+}
+
+std::vector<BatchPhase> const & BatchRunner::getPhases() const
+{
+    return mPhases;
+}
+
+BatchPhase & BatchRunner::getPhase(std::string const & name)
+{
+    auto it = std::find_if(mPhases.begin(), mPhases.end(), [&](BatchPhase const & phase) { return phase.name == name; });
+    if(it == mPhases.end()) {
+        mPhases.push_back({ name });
+        return mPhases.back();
+    }
+    return *it;
+}
+
+bool BatchRunner::run()
+{
+    // every phase is timed the same way
+    auto timed = [&](std::string const & name, auto && function) {
+        auto const start = Clock::now();
+        auto result = function();
+        auto & phase = getPhase(name);
+        phase.seconds += getSeconds(start);
+        phase.calls++;
+        return result;
+    };
+
+    // the stripes below are resolution cells wide
+    if(mSettings.resolution == 0) {
+        std::cout << "the resolution must be at least 1" << std::endl;
+        return false;
+    }
+
+    // the same world as the render path, with a striped initial temperature
+    timed("setup", [&]() {
+        mWorld = createSphereWorld(2.0f, mSettings.resolution);
+        auto & temperature = mWorld.addField("temperature");
+        for(size_t i = 0; i < temperature.values.size(); ++i) {
+            temperature.values[i] = (i / mSettings.resolution) % 20 < 10 ? 1.0f : 0.0f;
+        }
+        return true;
+    });
+
+    KernelHost host(mWorld);
+    bool const loaded = timed("kernel load", [&]() {
+        if(mSettings.kernelFile.empty()) {
+            host.setKernel(getDiffusionKernel());
+        }
+        else {
+            host.watchKernel(mSettings.kernelFile);
+        }
+        return host.getKernel() != nullptr;
+    });
+
+    if(!loaded) {
+        std::cout << "failed to load kernel " << mSettings.kernelFile << std::endl;
+        return false;
+    }
+
+    // statistics and the range of the colors come from the tick instead of a pass of their own
+    host.setStatisticsEnabled(mSettings.statisticsInterval > 0 || mSettings.imageInterval > 0 || !mSettings.recordFile.empty());
+
+    std::ofstream statisticsFile;
+    if(mSettings.statisticsInterval > 0 && !mSettings.statisticsFile.empty()) {
+        statisticsFile.open(mSettings.statisticsFile);
+        if(!statisticsFile.is_open()) {
+            std::cout << "failed to open statistics file " << mSettings.statisticsFile << std::endl;
+            return false;
+        }
+    }
+    std::ostream & statistics = statisticsFile.is_open() ? statisticsFile : std::cout;
+    if(mSettings.statisticsInterval > 0) {
+        statistics << "tick,time,field,min,max,mean\n";
+    }
+
+    std::unique_ptr<SimRecorder> recorder;
+    if(!mSettings.recordFile.empty())
+    {
+        try {
+            recorder = std::make_unique<SimRecorder>(mSettings.recordFile, mWorld.getCellCount());
+        }
+        catch(std::exception const & error) {
+            std::cout << error.what() << std::endl;
+            return false;
+        }
+    }
+
+    bool success = true;
+    auto const loopStart = Clock::now();
+
+    for(uint64_t i = 0; i < mSettings.ticks; ++i)
+    {
+        timed("step", [&]() { host.tick(mSettings.dt); return true; });
+
+        uint64_t const tick = mWorld.tick;
+        if(mSettings.statisticsInterval > 0 && tick % mSettings.statisticsInterval == 0) {
+            timed("statistics", [&]() { writeStatistics(statistics, host); return true; });
+        }
+        if(mSettings.snapshotInterval > 0 && tick % mSettings.snapshotInterval == 0) {
+            success = timed("snapshot", [&]() { return writeSnapshot(); }) && success;
+        }
+
+        // the image and the recording show the first field of the kernel, a hot swap may leave none
+        auto const * kernel = host.getKernel();
+        if(mSettings.imageInterval > 0 && tick % mSettings.imageInterval == 0 && kernel != nullptr && kernel->fieldCount > 0) {
+            success = timed("image", [&]() { return writeImage(kernel->fields[0].name, host); }) && success;
+        }
+        if(recorder && kernel != nullptr && kernel->fieldCount > 0) {
+            timed("record", [&]() {
+                if(updateColors(kernel->fields[0].name, host)) {
+                    recorder->record(tick, mColors);
+                }
+                return true;
+            });
+        }
+    }
+
+    mLoopSeconds = getSeconds(loopStart);
+    mTicks = mSettings.ticks;
+
+    // the frames still queued are written here, after the loop
+    if(recorder && !recorder->close()) {
+        std::cout << "failed to write recording " << mSettings.recordFile << std::endl;
+        success = false;
+    }
+
+    return success && statistics.good();
+}
+
+void BatchRunner::writeStatistics(std::ostream & out, KernelHost const & host) const
+{
+    for(auto const & field : mWorld.fields)
+    {
+        // the kernel fields were reduced during the tick, other fields need a pass of their own
+        auto const * statistics = host.findStatistics(field.name);
+        FieldSummary const summary = statistics != nullptr ? statistics->summary : reduceField(field.values, field.components);
+
+        out << mWorld.tick << ',' << mWorld.time << ',' << field.name << ','
+            << summary.min << ',' << summary.max << ',' << summary.getMean() << '\n';
+    }
+}
+
+bool BatchRunner::writeSnapshot() const
+{
+    auto const filename = getFilename(mSettings.snapshotPrefix, mWorld.tick, ".snapshot");
+    if(!WorldSnapshot::write(filename, mWorld.getView())) {
+        std::cout << "failed to write snapshot " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool BatchRunner::updateColors(std::string const & fieldName, KernelHost const & host)
+{
+    auto const view = mWorld.getView();
+    auto const * field = view.findField(fieldName);
+    if(field == nullptr) {
+        return false;
+    }
+
+    if(auto const * statistics = host.findStatistics(fieldName)) {
+        mColormap.setRange(getColorRange(statistics->summary));
+    }
+    else {
+        mColormap.setAutomaticRange(true);
+    }
+    mColors.resize(mWorld.getCellCount());
+    mColormap.apply(field->values, mColors, field->components);
+
+    return true;
+}
+
+bool BatchRunner::writeImage(std::string const & fieldName, KernelHost const & host)
+{
+    // the geometry does not change, only the colors
+    if(!mRasterizer)
+    {
+        mRasterizer = std::make_unique<SoftwareRasterizer>(1920, 1080);
+
+        auto const triangles = mWorld.getTriangles();
+        mVertices.resize(triangles.size());
+        for(size_t i = 0; i < triangles.size(); ++i) {
+            mVertices[i].pos = triangles[i];
+            mVertices[i].normal = glm::normalize(triangles[i]);
+        }
+    }
+
+    if(!updateColors(fieldName, host)) {
+        return false;
+    }
+
+    // the camera of the render path
+    SphereShaderObject::UnformBuffer uniforms = {};
+    uniforms.model = glm::mat4(1);
+    uniforms.view = glm::lookAt(glm::vec3(0.0f, -8.0f, 0.0f), glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+    uniforms.proj = glm::perspective(glm::radians(45.0f),
+        static_cast<float>(mRasterizer->getWidth()) / static_cast<float>(mRasterizer->getHeight()), 0.1f, 100'000.0f);
+    uniforms.proj[1][1] *= -1;
+
+    mRasterizer->clear();
+    mRasterizer->draw(mVertices, mColors, uniforms);
+
+    auto const filename = getFilename(mSettings.imagePrefix, mWorld.tick, ".png");
+    if(!::writeImage(filename, mRasterizer->getImage())) {
+        std::cout << "failed to write image " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void BatchRunner::printReport(std::ostream & out) const
+{
+    size_t const cellCount = mWorld.getCellCount();
+    double const ticksPerSecond = mLoopSeconds > 0.0 ? mTicks / mLoopSeconds : 0.0;
+
+    out << "batch: " << mTicks << " ticks of " << cellCount << " cells in "
+        << std::fixed << std::setprecision(3) << mLoopSeconds << " s\n";
+    out << "  " << std::setprecision(1) << ticksPerSecond << " ticks/s, "
+        << std::setprecision(0) << ticksPerSecond * cellCount << " cells/s\n";
+
+    for(auto const & phase : mPhases)
+    {
+        double const share = mLoopSeconds > 0.0 ? 100.0 * phase.seconds / mLoopSeconds : 0.0;
+        out << "  " << std::left << std::setw(12) << phase.name << std::right
+            << std::setprecision(3) << std::setw(12) << phase.seconds * 1000.0 << " ms"
+            << std::setw(10) << phase.calls << " calls"
+            << std::setw(12) << phase.seconds * 1000.0 / std::max<uint64_t>(phase.calls, 1) << " ms/call";
+
+        // setup and loading happen before the loop
+        if(phase.name != "setup" && phase.name != "kernel load") {
+            out << std::setprecision(1) << std::setw(8) << share << " %";
+        }
+        out << '\n';
+    }
+
+    out << std::defaultfloat;
+}
@@ -0,0 +1,98 @@
+//
+// @file:   batch_runner.h
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Runs the simulation without a window as fast as possible
+//
+
+#pragma once
+
+#include "world/world.h"
+#include "colormap/colormap.h"
+
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+class SoftwareRasterizer;
+class KernelHost;
+
+
+struct BatchSettings
+{
+    size_t resolution = 1000;           // the world has resolution * resolution cells
+    uint64_t ticks = 1000;
+    double dt = 0.1;
+
+    std::string kernelFile;             // empty for the built in diffusion kernel
+
+    uint64_t snapshotInterval = 0;      // ticks between snapshots, 0 for none
+    std::string snapshotPrefix = "snapshot";
+
+    uint64_t statisticsInterval = 0;    // ticks between field statistics, 0 for none
+    std::string statisticsFile;         // csv, empty for stdout
+
+    uint64_t imageInterval = 0;         // ticks between frames of the software rasterizer, 0 for none
+    std::string imagePrefix = "frame";
+
+    std::string recordFile;             // colors of every tick for --replay, empty for none
+};
+
+struct BatchPhase
+{
+    std::string name;
+    double seconds = 0.0;
+    uint64_t calls = 0;
+};
+
+//
+// @class:  BatchRunner
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Builds a world and advances it with a KernelHost, no RenderEngine
+//          is created. Snapshots, statistics, images and the recording are
+//          consumers of the world state between ticks, each is timed as its
+//          own phase.
+//
+class BatchRunner
+{
+public:
+    explicit BatchRunner(BatchSettings const & settings);
+    ~BatchRunner();
+
+    // false if the kernel could not be loaded or an output could not be written
+    bool run();
+
+    // ticks/s, cells/s and the time of every phase
+    void printReport(std::ostream & out) const;
+
+    World const & getWorld() const;
+    std::vector<BatchPhase> const & getPhases() const;
+
+private:
+    BatchSettings const mSettings;
+    World mWorld;
+
+    std::vector<BatchPhase> mPhases;
+    double mLoopSeconds = 0.0;
+    uint64_t mTicks = 0;
+
+    // created with the first image
+    std::unique_ptr<SoftwareRasterizer> mRasterizer;
+    std::vector<SphereShaderObject::VertexBufferElement> mVertices;
+
+    // of the images and the recording
+    std::vector<SphereShaderObject::ColorBufferElement> mColors;
+    Colormap mColormap;
+
+    BatchPhase & getPhase(std::string const & name);
+
+    void writeStatistics(std::ostream & out, KernelHost const & host) const;
+    bool writeSnapshot() const;
+    bool writeImage(std::string const & fieldName, KernelHost const & host);
+
+    // colormaps a field into mColors, false if the world has no such field
+    bool updateColors(std::string const & fieldName, KernelHost const & host);
+};
@@ -0,0 +1,279 @@
+//
+// @file:   colormap.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Maps scalar fields to the color buffer through lookup tables
+//
+
+#include "colormap.h"
+#include "tasks/parallel_for.h"
+
+#include <cmath>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// cells per chunk of work, large enough that starting a thread pays off
+constexpr size_t minChunkSize = 64 * 1024;
+
+// matplotlib viridis, every 32th entry
+std::array<glm::vec3, 9> const viridis = {
+    glm::vec3(0.267004f, 0.004874f, 0.329415f),
+    glm::vec3(0.282623f, 0.140926f, 0.457517f),
+    glm::vec3(0.253935f, 0.265254f, 0.529983f),
+    glm::vec3(0.206756f, 0.371758f, 0.553117f),
+    glm::vec3(0.163625f, 0.471133f, 0.558148f),
+    glm::vec3(0.127568f, 0.566949f, 0.550556f),
+    glm::vec3(0.134692f, 0.658636f, 0.517649f),
+    glm::vec3(0.477504f, 0.821444f, 0.318195f),
+    glm::vec3(0.993248f, 0.906157f, 0.143936f),
+};
+
+// Moreland's cool to warm
+std::array<glm::vec3, 5> const diverging = {
+    glm::vec3(0.230f, 0.299f, 0.754f),
+    glm::vec3(0.552f, 0.690f, 0.996f),
+    glm::vec3(0.865f, 0.865f, 0.865f),
+    glm::vec3(0.958f, 0.603f, 0.482f),
+    glm::vec3(0.706f, 0.016f, 0.150f),
+};
+
+// tableau 10
+std::array<glm::vec3, 10> const categorical = {
+    glm::vec3(0.122f, 0.467f, 0.706f),
+    glm::vec3(1.000f, 0.498f, 0.055f),
+    glm::vec3(0.173f, 0.627f, 0.173f),
+    glm::vec3(0.839f, 0.153f, 0.157f),
+    glm::vec3(0.580f, 0.404f, 0.741f),
+    glm::vec3(0.549f, 0.337f, 0.294f),
+    glm::vec3(0.890f, 0.467f, 0.761f),
+    glm::vec3(0.498f, 0.498f, 0.498f),
+    glm::vec3(0.737f, 0.741f, 0.133f),
+    glm::vec3(0.090f, 0.745f, 0.812f),
+};
+
+// hsv with full saturation and value, hue in degrees
+glm::vec3 hue(float const degrees)
+{
+    float const h = std::fmod(degrees, 360.0f) / 60.0f;
+    float const x = 1.0f - std::fabs(std::fmod(h, 2.0f) - 1.0f);
+
+    switch(static_cast<int>(h))
+    {
+        case 0: return glm::vec3(1.0f, x, 0.0f);
+        case 1: return glm::vec3(x, 1.0f, 0.0f);
+        case 2: return glm::vec3(0.0f, 1.0f, x);
+        case 3: return glm::vec3(0.0f, x, 1.0f);
+        case 4: return glm::vec3(x, 0.0f, 1.0f);
+        default: return glm::vec3(1.0f, 0.0f, x);
+    }
+}
+
+}
+
+
+Colormap::Colormap(ColormapType const type)
+    : mType(type)
+{
+    switch(type)
+    {
+        case ColormapType::eRainbow: {
+            std::vector<glm::vec3> colors(lutSize);
+            for(size_t i = 0; i < lutSize; ++i) {
+                colors[i] = hue(360.0f * i / lutSize);
+            }
+            createTable(colors, true);
+            break;
+        }
+        case ColormapType::eViridis:
+            createTable(viridis, true);
+            break;
+        case ColormapType::eDiverging:
+            createTable(diverging, true);
+            break;
+        case ColormapType::eCategorical:
+            createTable(categorical, false);
+            break;
+    }
+}
+
+void Colormap::createTable(std::span<glm::vec3 const> const colors, bool const interpolate)
+{
+    assert(!colors.empty());
+
+    for(size_t i = 0; i < lutSize; ++i)
+    {
+        glm::vec3 color = colors[i % colors.size()];
+        if(interpolate && colors.size() > 1)
+        {
+            float const t = static_cast<float>(i) / (lutSize - 1) * (colors.size() - 1);
+            size_t const k = std::min(static_cast<size_t>(t), colors.size() - 2);
+            color = glm::mix(colors[k], colors[k + 1], t - k);
+        }
+
+        mRed[i] = color.r;
+        mGreen[i] = color.g;
+        mBlue[i] = color.b;
+    }
+
+    for(size_t i = 0; i < lutSize; ++i)
+    {
+        size_t const next = std::min(i + 1, lutSize - 1);
+        mRedStep[i] = mRed[next] - mRed[i];
+        mGreenStep[i] = mGreen[next] - mGreen[i];
+        mBlueStep[i] = mBlue[next] - mBlue[i];
+    }
+}
+
+void Colormap::setRange(ColorRange const range)
+{
+    mRange = range;
+    mAutomatic = false;
+}
+
+void Colormap::setAutomaticRange(bool const automatic)
+{
+    mAutomatic = automatic;
+}
+
+ColorRange Colormap::getRange() const
+{
+    return mRange;
+}
+
+ColormapType Colormap::getType() const
+{
+    return mType;
+}
+
+glm::vec3 Colormap::map(float const value) const
+{
+    ColorBufferElement color;
+    if(mType == ColormapType::eCategorical) {
+        applyCategorical({ &value, 1 }, { &color, 1 }, 1, 0, 1);
+    }
+    else {
+        applyRange({ &value, 1 }, { &color, 1 }, 1, 0, 1);
+    }
+
+    return glm::vec3(color.r, color.g, color.b);
+}
+
+void Colormap::apply(std::span<float const> const values, std::span<ColorBufferElement> const colors, size_t const stride)
+{
+    assert(stride > 0);
+    assert(values.size() >= colors.size() * stride);
+
+    if(mAutomatic && mType != ColormapType::eCategorical) {
+        mRange = computeRange(values.first(colors.size() * stride), stride);
+    }
+
+    parallelFor(colors.size(), minChunkSize, [&](size_t const begin, size_t const end) {
+        if(mType == ColormapType::eCategorical) {
+            applyCategorical(values, colors, stride, begin, end);
+        }
+        else {
+            applyRange(values, colors, stride, begin, end);
+        }
+    });
+}
+
+void Colormap::applyRange(std::span<float const> const values, std::span<ColorBufferElement> const colors,
+    size_t const stride, size_t const begin, size_t const end) const
+{
+    float const maxIndex = static_cast<float>(lutSize - 1);
+    float const scale = mRange.max > mRange.min ? maxIndex / (mRange.max - mRange.min) : 0.0f;
+    float const offset = -mRange.min * scale;
+
+    size_t i = begin;
+
+#if defined(__AVX2__)
+    if(stride == 1)
+    {
+        __m256 const vScale = _mm256_set1_ps(scale);
+        __m256 const vOffset = _mm256_set1_ps(offset);
+        __m256 const vZero = _mm256_setzero_ps();
+        __m256 const vMax = _mm256_set1_ps(maxIndex);
+
+        // the lanes of the three channels are permuted and blended into 8 interleaved colors
+        static_assert(sizeof(ColorBufferElement) == 3 * sizeof(float));
+        __m256i const redOrder = _mm256_setr_epi32(0, 3, 6, 1, 4, 7, 2, 5);
+        __m256i const greenOrder = _mm256_setr_epi32(5, 0, 3, 6, 1, 4, 7, 2);
+        __m256i const blueOrder = _mm256_setr_epi32(2, 5, 0, 3, 6, 1, 4, 7);
+
+        for(; i + 8 <= end; i += 8)
+        {
+            // separate multiply and add like the scalar loop, an fma would round differently
+            // max_ps returns the second operand for NaN, so NaN maps to the first entry
+            __m256 t = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(values.data() + i), vScale), vOffset);
+            t = _mm256_min_ps(_mm256_max_ps(t, vZero), vMax);
+
+            __m256i const index = _mm256_cvttps_epi32(t);
+            __m256 const f = _mm256_sub_ps(t, _mm256_cvtepi32_ps(index));
+
+            __m256 const r = _mm256_add_ps(_mm256_i32gather_ps(mRed.data(), index, 4), _mm256_mul_ps(f, _mm256_i32gather_ps(mRedStep.data(), index, 4)));
+            __m256 const g = _mm256_add_ps(_mm256_i32gather_ps(mGreen.data(), index, 4), _mm256_mul_ps(f, _mm256_i32gather_ps(mGreenStep.data(), index, 4)));
+            __m256 const b = _mm256_add_ps(_mm256_i32gather_ps(mBlue.data(), index, 4), _mm256_mul_ps(f, _mm256_i32gather_ps(mBlueStep.data(), index, 4)));
+
+            __m256 const red = _mm256_permutevar8x32_ps(r, redOrder);
+            __m256 const green = _mm256_permutevar8x32_ps(g, greenOrder);
+            __m256 const blue = _mm256_permutevar8x32_ps(b, blueOrder);
+
+            // r0 g0 b0 r1 g1 b1 r2 g2 | b2 r3 g3 b3 r4 g4 b4 r5 | g5 b5 r6 g6 b6 r7 g7 b7
+            float * const out = &colors[i].r;
+            _mm256_storeu_ps(out, _mm256_blend_ps(_mm256_blend_ps(red, green, 0x92), blue, 0x24));
+            _mm256_storeu_ps(out + 8, _mm256_blend_ps(_mm256_blend_ps(blue, red, 0x92), green, 0x24));
+            _mm256_storeu_ps(out + 16, _mm256_blend_ps(_mm256_blend_ps(green, blue, 0x92), red, 0x24));
+        }
+    }
+#endif
+
+    for(; i < end; ++i)
+    {
+        float t = values[i * stride] * scale + offset;
+        t = t > 0.0f ? t : 0.0f;
+        t = t < maxIndex ? t : maxIndex;
+
+        size_t const index = static_cast<size_t>(t);
+        float const f = t - static_cast<float>(index);
+
+        colors[i].r = mRed[index] + f * mRedStep[index];
+        colors[i].g = mGreen[index] + f * mGreenStep[index];
+        colors[i].b = mBlue[index] + f * mBlueStep[index];
+    }
+}
+
+void Colormap::applyCategorical(std::span<float const> const values, std::span<ColorBufferElement> const colors,
+    size_t const stride, size_t const begin, size_t const end) const
+{
+    int64_t const count = static_cast<int64_t>(categorical.size());
+
+    for(size_t i = begin; i < end; ++i)
+    {
+        float const value = values[i * stride];
+        int64_t const category = std::isfinite(value) ? static_cast<int64_t>(std::floor(value)) : 0;
+        size_t const index = static_cast<size_t>(((category % count) + count) % count);
+
+        colors[i].r = mRed[index];
+        colors[i].g = mGreen[index];
+        colors[i].b = mBlue[index];
+    }
+}
+
+ColorRange computeRange(std::span<float const> const values, size_t const stride)
+{
+    return getColorRange(reduceField(values, stride));
+}
+
+ColorRange getColorRange(FieldSummary const & summary)
+{
+    if(!(summary.min <= summary.max)) {
+        return ColorRange();
+    }
+
+    return { summary.min, summary.max };
+}
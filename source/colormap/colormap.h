@@ -0,0 +1,86 @@
+//
+// @file:   colormap.h
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Maps scalar fields to the color buffer through lookup tables
+//
+
+#pragma once
+
+#include "sphere/sphere_shader_object.h"
+#include "reduction/field_reduction.h"
+
+#include <array>
+#include <span>
+
+
+enum class ColormapType {
+    eRainbow,           // hue from 0 to 360 degrees, like glm::rgbColor
+    eViridis,
+    eDiverging,         // blue - white - red
+    eCategorical,       // 10 distinct colors, values are taken as category ids
+};
+
+struct ColorRange
+{
+    float min = 0.0f;
+    float max = 1.0f;
+};
+
+//
+// @class:  Colormap
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Precomputed table of lutSize colors. apply() looks up and lerps
+//          the colors of all values on all cores, with AVX2 gathers where
+//          the compiler targets it. With an automatic range the minimum and
+//          maximum of the values are computed first on every call, callers
+//          that have the statistics of the field set the range instead.
+//
+class Colormap
+{
+public:
+    using ColorBufferElement = SphereShaderObject::ColorBufferElement;
+
+    static constexpr size_t lutSize = 256;
+
+    explicit Colormap(ColormapType const type = ColormapType::eViridis);
+
+    void setRange(ColorRange const range);
+    void setAutomaticRange(bool const automatic);
+
+    ColorRange getRange() const;
+    ColormapType getType() const;
+
+    // colors[i] = map(values[i * stride])
+    void apply(std::span<float const> const values, std::span<ColorBufferElement> const colors, size_t const stride = 1);
+
+    // a single value, for things that are not bandwidth bound
+    glm::vec3 map(float const value) const;
+
+private:
+    ColormapType mType;
+    ColorRange mRange;
+    bool mAutomatic = false;
+
+    // planar tables, the color of entry i and the step to entry i + 1
+    alignas(32) std::array<float, lutSize> mRed;
+    alignas(32) std::array<float, lutSize> mGreen;
+    alignas(32) std::array<float, lutSize> mBlue;
+    alignas(32) std::array<float, lutSize> mRedStep;
+    alignas(32) std::array<float, lutSize> mGreenStep;
+    alignas(32) std::array<float, lutSize> mBlueStep;
+
+    void createTable(std::span<glm::vec3 const> const colors, bool const interpolate);
+
+    void applyRange(std::span<float const> const values, std::span<ColorBufferElement> const colors,
+        size_t const stride, size_t const begin, size_t const end) const;
+    void applyCategorical(std::span<float const> const values, std::span<ColorBufferElement> const colors,
+        size_t const stride, size_t const begin, size_t const end) const;
+};
+
+// minimum and maximum of values[i * stride], an empty range gives { 0, 1 }
+ColorRange computeRange(std::span<float const> const values, size_t const stride = 1);
+
+// range of a summary, e.g. of the statistics of a KernelHost, without a pass over the values
+ColorRange getColorRange(FieldSummary const & summary);
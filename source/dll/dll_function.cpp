@@ -6,10 +6,20 @@
 //
 
 #include "dll_function.h"
+
+#ifdef _WIN32
 #include <windows.h>
+#else
+#include <dlfcn.h>
+#include <iostream>
+#endif
 
 struct DLLFunctionBase::Impl {
+#ifdef _WIN32
     HINSTANCE hProcIDDLL = nullptr;
+#else
+    void * handle = nullptr;
+#endif
 };
 
 
@@ -24,6 +34,8 @@ DLLFunctionBase::~DLLFunctionBase()
     reset();
 }
 
+#ifdef _WIN32
+
 void DLLFunctionBase::reset()
 {
     // mFilename = "";
@@ -31,6 +43,7 @@ void DLLFunctionBase::reset()
     // mFunction = nullptr;
     if(mImpl->hProcIDDLL != nullptr){
         FreeLibrary(mImpl->hProcIDDLL);
+        mImpl->hProcIDDLL = nullptr;
     }
 }
 
@@ -46,4 +59,28 @@ DLLFunctionBase::Function DLLFunctionBase::load(std::string const & filename, st
     return reinterpret_cast<Function>(GetProcAddress(mImpl->hProcIDDLL, functionName.c_str()));
 }
 
+#else
+
+void DLLFunctionBase::reset()
+{
+    if(mImpl->handle != nullptr){
+        dlclose(mImpl->handle);
+        mImpl->handle = nullptr;
+    }
+}
+
+DLLFunctionBase::Function DLLFunctionBase::load(std::string const & filename, std::string const & functionName)
+{
+    reset();
+
+    // RTLD_LOCAL keeps the symbols of two versions of the same library apart
+    mImpl->handle = dlopen(filename.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if(mImpl->handle == nullptr) {
+        std::cout << dlerror() << std::endl;
+        return nullptr;
+    }
+
+    return reinterpret_cast<Function>(dlsym(mImpl->handle, functionName.c_str()));
+}
 
+#endif
@@ -9,6 +9,7 @@
 
 #include <string>
 #include <memory>
+#include <type_traits>
 
 class DLLFunctionBase 
 {
@@ -97,6 +98,10 @@ bool DllFunction<TRet(TArgs...)>::loaded()
 template<typename TRet, typename... TArgs>
 inline TRet DllFunction<TRet(TArgs...)>::operator()(TArgs ...args) const {
     if(mFunction != nullptr) {
-        mFunction(args...);
+        return mFunction(args...);
+    }
+
+    if constexpr (!std::is_void_v<TRet>) {
+        return TRet{};
     }
 }
\ No newline at end of file
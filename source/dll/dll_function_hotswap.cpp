@@ -0,0 +1,263 @@
+//
+// @file:   dll_function_hotswap.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Watches a dll and reloads it on a thread of its own
+//
+
+#include "dll_function_hotswap.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <condition_variable>
+#include <iterator>
+
+#ifndef _WIN32
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#include <fcntl.h>
+#endif
+
+namespace fs = std::filesystem;
+
+
+// polls the modification time, on Windows and where inotify is not available
+struct DllHotswapBase::Watcher {
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool stop = false;
+
+#ifndef _WIN32
+    // inotify on the directory, a pipe wakes the thread up to stop it
+    int inotify = -1;
+    int stopPipe[2] = { -1, -1 };
+
+    void closeDescriptors() {
+        for(int * const fd : { &inotify, &stopPipe[0], &stopPipe[1] }) {
+            if(*fd >= 0) {
+                close(*fd);
+                *fd = -1;
+            }
+        }
+    }
+
+    ~Watcher() {
+        closeDescriptors();
+    }
+#endif
+};
+
+
+DllHotswapBase::DllHotswapBase(std::string const & filename, std::string const & functionName)
+    : mFilename(filename),
+      mFunctionName(functionName),
+      mWatcher(std::make_unique<Watcher>())
+{
+    // the first version is loaded right away
+    reload();
+
+#ifndef _WIN32
+    auto const directory = fs::absolute(mFilename).parent_path().string();
+
+    mWatcher->inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if(mWatcher->inotify < 0
+        || inotify_add_watch(mWatcher->inotify, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0
+        || pipe2(mWatcher->stopPipe, O_CLOEXEC) != 0) {
+        std::cout << "hotswap: can not watch " << directory << " with inotify, polling " << mFilename << std::endl;
+        mWatcher->closeDescriptors();
+    }
+#endif
+
+    mThread = std::thread(&DllHotswapBase::watch, this);
+}
+
+DllHotswapBase::~DllHotswapBase()
+{
+    if(mThread.joinable())
+    {
+        {
+            std::lock_guard lock(mWatcher->mutex);
+            mWatcher->stop = true;
+        }
+        mWatcher->condition.notify_all();
+#ifndef _WIN32
+        if(mWatcher->stopPipe[1] >= 0) {
+            char const byte = 0;
+            [[maybe_unused]] auto const written = write(mWatcher->stopPipe[1], &byte, 1);
+        }
+#endif
+        mThread.join();
+    }
+
+    mFunction.store(nullptr, std::memory_order_release);
+    update();
+
+    if(mCurrent) {
+        mCurrent->base.reset();
+        std::error_code error;
+        fs::remove(mCurrent->filename, error);
+    }
+}
+
+void DllHotswapBase::update(uint64_t const version)
+{
+    // cheap check for the caller's hot path
+    if(!mHasRetired.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    std::vector<std::unique_ptr<Library>> retired;
+    {
+        std::lock_guard lock(mMutex);
+
+        // a library replaced after the caller fetched its function is kept for the next call
+        auto const kept = std::partition(mRetired.begin(), mRetired.end(),
+            [&](std::unique_ptr<Library> const & library) { return library->replacedBy > version; });
+        std::move(kept, mRetired.end(), std::back_inserter(retired));
+        mRetired.erase(kept, mRetired.end());
+        mHasRetired.store(!mRetired.empty(), std::memory_order_release);
+    }
+
+    for(auto & library : retired) {
+        library->base.reset();
+        std::error_code error;
+        fs::remove(library->filename, error);
+    }
+}
+
+bool DllHotswapBase::reload()
+{
+    try
+    {
+        if(!fs::exists(mFilename) || fs::file_size(mFilename) == 0) {
+            return false;
+        }
+
+        // a copy, so the build can overwrite the original, with a new name
+        // each time, so the loader does not hand out the cached old version
+        auto library = std::make_unique<Library>();
+        library->filename = mFilename + "_copy" + std::to_string(getVersion());
+
+        fs::copy_file(mFilename, library->filename, fs::copy_options::overwrite_existing);
+
+        auto const function = library->base.load(library->filename, mFunctionName);
+        if(function == nullptr)
+        {
+            std::cout << "hotswap: " << mFunctionName << " not found in " << mFilename << std::endl;
+            library->base.reset();
+            std::error_code error;
+            fs::remove(library->filename, error);
+            return false;
+        }
+
+        // function, version, retirement, in this order: a caller that sees the
+        // version gets the new function and only then may free the old library
+        mFunction.store(function, std::memory_order_release);
+        uint64_t const version = mVersion.fetch_add(1, std::memory_order_acq_rel) + 1;
+
+        {
+            std::lock_guard lock(mMutex);
+            if(mCurrent) {
+                mCurrent->replacedBy = version;
+                mRetired.push_back(std::move(mCurrent));
+                mHasRetired.store(true, std::memory_order_release);
+            }
+            mCurrent = std::move(library);
+        }
+
+        std::cout << "hotswap: loaded " << mFilename << " version " << version << std::endl;
+        return true;
+    }
+    catch(std::exception const & e)
+    {
+        std::cout << e.what() << std::endl;
+        return false;
+    }
+}
+
+void DllHotswapBase::pollModificationTime()
+{
+    std::error_code error;
+    auto lastWrite = fs::last_write_time(mFilename, error);
+
+    std::unique_lock lock(mWatcher->mutex);
+    while(!mWatcher->condition.wait_for(lock, std::chrono::milliseconds(250), [&](){ return mWatcher->stop; }))
+    {
+        auto const write = fs::last_write_time(mFilename, error);
+        if(!error && write != lastWrite) {
+            lastWrite = write;
+            reload();
+        }
+    }
+}
+
+#ifdef _WIN32
+
+void DllHotswapBase::watch()
+{
+    pollModificationTime();
+}
+
+#else
+
+void DllHotswapBase::watch()
+{
+    if(mWatcher->inotify < 0) {
+        pollModificationTime();
+        return;
+    }
+
+    auto const name = fs::path(mFilename).filename().string();
+
+    // events are read into an aligned buffer, as inotify(7) suggests
+    alignas(inotify_event) char buffer[4096];
+
+    // reads all pending events, returns true if one of them is about the library
+    auto const readEvents = [&]() {
+        bool changed = false;
+        ssize_t size = 0;
+        while((size = read(mWatcher->inotify, buffer, sizeof(buffer))) > 0)
+        {
+            for(char * p = buffer; p < buffer + size; )
+            {
+                auto const * event = reinterpret_cast<inotify_event const *>(p);
+                if(event->len > 0 && name == event->name) {
+                    changed = true;
+                }
+                p += sizeof(inotify_event) + event->len;
+            }
+        }
+        return changed;
+    };
+
+    pollfd fds[2] = {
+        { mWatcher->inotify, POLLIN, 0 },
+        { mWatcher->stopPipe[0], POLLIN, 0 },
+    };
+
+    while(true)
+    {
+        if(poll(fds, 2, -1) < 0) {
+            continue;
+        }
+
+        if(fds[1].revents != 0) {
+            return;
+        }
+
+        if(!readEvents()) {
+            continue;
+        }
+
+        // wait until the linker is done writing
+        while(poll(fds, 1, 50) > 0) {
+            readEvents();
+        }
+
+        reload();
+    }
+}
+
+#endif
@@ -8,8 +8,76 @@
 #pragma once
 
 #include "dll_function.h"
-#include <filesystem>
-#include <fstream>
+
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <type_traits>
+
+
+//
+// @class:  DllHotswapBase
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Watches a dll on a thread of its own. When the file changes it
+//          copies and loads the new version on that thread and publishes the
+//          function with an atomic store before it publishes the version.
+//          The replaced libraries are kept until update() is called with a
+//          version at least as new as the one that replaced them, so a caller
+//          that fetched the function of that version no longer needs them.
+//
+class DllHotswapBase
+{
+public:
+    using Function = DLLFunctionBase::Function;
+
+    DllHotswapBase(std::string const & filename, std::string const & functionName);
+    ~DllHotswapBase();
+
+    DllHotswapBase(DllHotswapBase const &) = delete;
+    DllHotswapBase& operator=(DllHotswapBase const &) = delete;
+
+    Function get() const {
+        return mFunction.load(std::memory_order_acquire);
+    }
+
+    // number of versions loaded so far
+    uint64_t getVersion() const {
+        return mVersion.load(std::memory_order_acquire);
+    }
+
+    // frees the libraries replaced up to version, must not overlap with calls of their functions
+    void update(uint64_t const version = UINT64_MAX);
+
+private:
+    struct Library {
+        DLLFunctionBase base;
+        std::string filename;
+        uint64_t replacedBy = 0;    // version that retired it
+    };
+
+    std::string const mFilename;
+    std::string const mFunctionName;
+
+    std::atomic<Function> mFunction = nullptr;
+    std::atomic<uint64_t> mVersion = 0;
+
+    std::mutex mMutex;
+    std::unique_ptr<Library> mCurrent;
+    std::vector<std::unique_ptr<Library>> mRetired;
+    std::atomic<bool> mHasRetired = false;
+
+    struct Watcher;
+    std::unique_ptr<Watcher> mWatcher;
+    std::thread mThread;
+
+    bool reload();
+    void watch();
+    void pollModificationTime();
+};
 
 
 template<typename T>
@@ -19,7 +87,8 @@ class DllFunctionHotswap;
 // @class:  DllFunctionHotswap
 // @author: FirePrincess
 // @date:   2021-09-10
-// @brief:  Loads a dll and keeps a reference to a 
+// @brief:  Loads a dll and keeps a reference to a function of it, calling
+//          it costs one atomic load and an indirect call
 //
 template<typename TRet, typename... TArgs>
 class DllFunctionHotswap<TRet(TArgs...)>
@@ -31,75 +100,54 @@ public:
 
     TRet operator()(TArgs ...args) const;
 
-    void update();
-
-private:
-    std::string mFilename;
-    std::string mFunctionName;
+    bool loaded() const;
+    uint64_t getVersion() const;
 
-    DllFunction<TRet(TArgs...)> mFunc;
-
-    std::filesystem::file_time_type mLastWrite = {};
-    std::uintmax_t mFileSize = {};
-    int changed = 0;
+    void update(uint64_t const version = UINT64_MAX);
 
+private:
+    DllHotswapBase mBase;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
 // Implementation
 
 template<typename TRet, typename... TArgs>
-inline DllFunctionHotswap<TRet(TArgs...)>::DllFunctionHotswap(std::string const filename, 
+inline DllFunctionHotswap<TRet(TArgs...)>::DllFunctionHotswap(std::string const filename,
     std::string const functionName)
-    : mFilename(filename),
-      mFunctionName(functionName)
+    : mBase(filename, functionName)
 {
 
 }
 
 template<typename TRet, typename... TArgs>
-TRet DllFunctionHotswap<TRet(TArgs...)>::operator()(TArgs ...args) const
+inline TRet DllFunctionHotswap<TRet(TArgs...)>::operator()(TArgs ...args) const
 {
-    mFunc(args...);
+    // bit_cast, a reinterpret_cast between function pointer types warns with -Wcast-function-type
+    auto const function = std::bit_cast<Function>(mBase.get());
+    if(function != nullptr) {
+        return function(args...);
+    }
+
+    if constexpr (!std::is_void_v<TRet>) {
+        return TRet{};
+    }
 }
 
-void copyFile(std::string const & src, std::string const & dst)
+template<typename TRet, typename... TArgs>
+inline bool DllFunctionHotswap<TRet(TArgs...)>::loaded() const
 {
-  std::ifstream ist;
-  std::ofstream ost;
-
-  ist.open(src, std::ios::in | std::ios::binary);
-  ost.open(dst, std::ios::out | std::ios::binary);
-  ost << ist.rdbuf();
+    return mBase.get() != nullptr;
+}
 
-  ist.close();
-  ost.close();
+template<typename TRet, typename... TArgs>
+inline uint64_t DllFunctionHotswap<TRet(TArgs...)>::getVersion() const
+{
+    return mBase.getVersion();
 }
 
 template<typename TRet, typename... TArgs>
-void DllFunctionHotswap<TRet(TArgs...)>::update()
-{   
-    try 
-    {
-       if(std::filesystem::last_write_time(mFilename) != mLastWrite 
-        && std::filesystem::file_size(mFilename) != 0) 
-        {
-            mLastWrite = std::filesystem::last_write_time(mFilename);
-
-            mFunc.reset();
-            // copyFile(mFilename, mFilename + "_copy");
-
-            std::filesystem::remove(mFilename + "_copy");
-            std::filesystem::copy_file(mFilename, mFilename + "_copy");
-
-            std::cout << "orig:" << std::filesystem::file_size(mFilename) << std::endl;
-            std::cout << "copy:" << std::filesystem::file_size(mFilename + "_copy") << std::endl;
-
-            mFunc.load(mFilename + "_copy", mFunctionName);
-        }
-    }
-    catch(std::exception const & e) 
-    {
-        std::cout << e.what() << std::endl;
-    }
-}
\ No newline at end of file
+inline void DllFunctionHotswap<TRet(TArgs...)>::update(uint64_t const version)
+{
+    mBase.update(version);
+}
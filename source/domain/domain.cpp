@@ -0,0 +1,187 @@
+//
+// @file:   domain.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Splits a world into domains with halo cells, one per process
+//
+
+#include "domain.h"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <numeric>
+
+
+namespace {
+
+constexpr uint32_t noCell = std::numeric_limits<uint32_t>::max();
+
+// spreads the lower 16 bits to every second bit
+uint32_t spreadBits(uint32_t value)
+{
+    value &= 0xffff;
+    value = (value | (value << 8)) & 0x00ff00ff;
+    value = (value | (value << 4)) & 0x0f0f0f0f;
+    value = (value | (value << 2)) & 0x33333333;
+    value = (value | (value << 1)) & 0x55555555;
+    return value;
+}
+
+// cube face in the upper bits, morton code of the position on the face in the lower
+uint64_t getCubeKey(glm::vec3 const & direction)
+{
+    glm::vec3 const a = glm::abs(direction);
+
+    uint32_t face;
+    float u;
+    float v;
+    float major;
+    if(a.x >= a.y && a.x >= a.z) {
+        face = direction.x >= 0.0f ? 0 : 1;
+        major = a.x;
+        u = direction.y;
+        v = direction.z;
+    }
+    else if(a.y >= a.z) {
+        face = direction.y >= 0.0f ? 2 : 3;
+        major = a.y;
+        u = direction.x;
+        v = direction.z;
+    }
+    else {
+        face = direction.z >= 0.0f ? 4 : 5;
+        major = a.z;
+        u = direction.x;
+        v = direction.y;
+    }
+
+    auto const quantize = [major](float const value) {
+        return static_cast<uint32_t>(std::clamp((value / major + 1.0f) * 0.5f, 0.0f, 1.0f) * 65535.0f);
+    };
+
+    return (static_cast<uint64_t>(face) << 32) | spreadBits(quantize(u)) | (spreadBits(quantize(v)) << 1);
+}
+
+}
+
+
+std::vector<uint32_t> partitionWorld(WorldView const & world, uint32_t const domains)
+{
+    size_t const cells = world.getCellCount();
+
+    std::vector<uint64_t> keys(cells);
+    for(size_t cell = 0; cell < cells; ++cell) {
+        keys[cell] = getCubeKey(getCellDirection(world, cell));
+    }
+
+    std::vector<uint32_t> order(cells);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&keys](uint32_t const a, uint32_t const b) {
+        return keys[a] < keys[b];
+    });
+
+    std::vector<uint32_t> domainOfCell(cells);
+    for(size_t i = 0; i < cells; ++i) {
+        domainOfCell[order[i]] = static_cast<uint32_t>(i * std::max<uint32_t>(domains, 1) / cells);
+    }
+
+    return domainOfCell;
+}
+
+Domain createDomain(WorldView const & world, std::vector<uint32_t> const & domainOfCell, uint32_t const domains, uint32_t const id)
+{
+    size_t const cells = world.getCellCount();
+
+    Domain domain;
+    domain.id = id;
+    domain.count = domains;
+
+    for(uint32_t cell = 0; cell < cells; ++cell) {
+        if(domainOfCell[cell] == id) {
+            domain.globalCells.push_back(cell);
+        }
+    }
+    domain.ownedCount = static_cast<uint32_t>(domain.globalCells.size());
+
+    // the adjacency is symmetric, so the own cells next to a neighbour are exactly its halo from this domain
+    std::map<uint32_t, std::vector<uint32_t>> halos;
+    std::map<uint32_t, std::vector<uint32_t>> sends;
+    for(uint32_t local = 0; local < domain.ownedCount; ++local) {
+        for(auto const neighbour : world.getNeighbours(domain.globalCells[local]))
+        {
+            uint32_t const other = domainOfCell[neighbour];
+            if(other != id) {
+                halos[other].push_back(neighbour);
+                sends[other].push_back(local);
+            }
+        }
+    }
+
+    for(auto & [other, halo] : halos)
+    {
+        std::sort(halo.begin(), halo.end());
+        halo.erase(std::unique(halo.begin(), halo.end()), halo.end());
+
+        // local owned cells are in global order too
+        auto & send = sends[other];
+        std::sort(send.begin(), send.end());
+        send.erase(std::unique(send.begin(), send.end()), send.end());
+
+        DomainExchange exchange;
+        exchange.neighbour = other;
+        exchange.sendCells = std::move(send);
+        exchange.haloBegin = static_cast<uint32_t>(domain.globalCells.size());
+        exchange.haloCount = static_cast<uint32_t>(halo.size());
+        domain.exchanges.push_back(std::move(exchange));
+
+        domain.globalCells.insert(domain.globalCells.end(), halo.begin(), halo.end());
+    }
+
+    std::vector<uint32_t> localOfGlobal(cells, noCell);
+    for(uint32_t local = 0; local < domain.globalCells.size(); ++local) {
+        localOfGlobal[domain.globalCells[local]] = local;
+    }
+
+    // the local world, vertices are shared by the cells of the domain like in the global one
+    World & local = domain.world;
+    std::vector<uint32_t> localVertices(world.vertices.size(), noCell);
+    local.indices.reserve(domain.globalCells.size() * 6);
+    for(auto const cell : domain.globalCells) {
+        for(size_t k = 0; k < 6; ++k)
+        {
+            uint32_t const vertex = world.indices[cell * 6 + k];
+            if(localVertices[vertex] == noCell) {
+                localVertices[vertex] = static_cast<uint32_t>(local.vertices.size());
+                local.vertices.push_back(world.vertices[vertex]);
+            }
+            local.indices.push_back(localVertices[vertex]);
+        }
+    }
+
+    local.adjacencyOffsets.reserve(domain.globalCells.size() + 1);
+    local.adjacencyOffsets.push_back(0);
+    for(uint32_t cell = 0; cell < domain.globalCells.size(); ++cell)
+    {
+        if(cell < domain.ownedCount) {
+            for(auto const neighbour : world.getNeighbours(domain.globalCells[cell])) {
+                local.adjacency.push_back(localOfGlobal[neighbour]);
+            }
+        }
+        local.adjacencyOffsets.push_back(static_cast<uint32_t>(local.adjacency.size()));
+    }
+
+    for(auto const & field : world.fields)
+    {
+        auto & values = local.addField(std::string(field.name), field.components).values;
+        for(size_t cell = 0; cell < domain.globalCells.size(); ++cell) {
+            std::copy_n(field.values.begin() + static_cast<size_t>(domain.globalCells[cell]) * field.components,
+                field.components, values.begin() + cell * field.components);
+        }
+    }
+
+    local.tick = world.tick;
+    local.time = world.time;
+
+    return domain;
+}
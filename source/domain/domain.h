@@ -0,0 +1,52 @@
+//
+// @file:   domain.h
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Splits a world into domains with halo cells, one per process
+//
+
+#pragma once
+
+#include "world/world.h"
+
+#include <cstdint>
+#include <vector>
+
+
+// cells a domain sends to a neighbour domain and the halo cells it receives from it
+struct DomainExchange
+{
+    uint32_t neighbour = 0;                 // domain
+    std::vector<uint32_t> sendCells;        // local owned cells, in the order of the halo of the neighbour
+    uint32_t haloBegin = 0;                 // local cells received from the neighbour
+    uint32_t haloCount = 0;
+};
+
+//
+// @struct: Domain
+// @brief:  The part of a world one process simulates. The local world holds
+//          the owned cells first, then the halo cells grouped by the domain
+//          that owns them, both sorted by their global cell. Halo cells have
+//          no neighbours, the kernels only compute the owned cells and read
+//          the halo. Both sides of an exchange derive the same cell order
+//          from the global world, no index lists are sent.
+//
+struct Domain
+{
+    uint32_t id = 0;
+    uint32_t count = 1;
+
+    World world;
+    uint32_t ownedCount = 0;
+    std::vector<uint32_t> globalCells;      // global cell of every local cell
+
+    std::vector<DomainExchange> exchanges;  // by neighbour domain
+};
+
+// domain of every cell. Cells are ordered by the cube face their center falls on and along a
+// morton curve within the face, then cut into ranges of equal cell count. With 6 domains every
+// domain is roughly one cube face, other counts split or merge faces along the curve.
+std::vector<uint32_t> partitionWorld(WorldView const & world, uint32_t const domains);
+
+// the domain with its halo, fields are copied from the world for the owned and halo cells
+Domain createDomain(WorldView const & world, std::vector<uint32_t> const & domainOfCell, uint32_t const domains, uint32_t const id);
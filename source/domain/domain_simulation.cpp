@@ -0,0 +1,122 @@
+//
+// @file:   domain_simulation.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Advances one domain of a world, in step with the other domains
+//
+
+#include "domain_simulation.h"
+
+#include <algorithm>
+#include <chrono>
+
+
+DomainSimulation::DomainSimulation(Domain domain, HaloTransportSettings const & settings)
+    : mDomain(std::move(domain)),
+      mHost(mDomain.world),
+      mTransport(settings, mDomain.id)
+{
+    mHost.setComputedCellCount(mDomain.ownedCount);
+
+    mSendBuffers.resize(mDomain.exchanges.size());
+    mReceiveBuffers.resize(mDomain.exchanges.size());
+}
+
+bool DomainSimulation::connect()
+{
+    std::vector<uint32_t> neighbours;
+    for(auto const & exchange : mDomain.exchanges) {
+        neighbours.push_back(exchange.neighbour);
+    }
+
+    return mTransport.connect(neighbours);
+}
+
+KernelHost & DomainSimulation::getHost()
+{
+    return mHost;
+}
+
+Domain const & DomainSimulation::getDomain() const
+{
+    return mDomain;
+}
+
+World const & DomainSimulation::getWorld() const
+{
+    return mDomain.world;
+}
+
+double DomainSimulation::getExchangeSeconds() const
+{
+    return mExchangeSeconds;
+}
+
+uint64_t DomainSimulation::getSentBytes() const
+{
+    return mTransport.getSentBytes();
+}
+
+bool DomainSimulation::exchange()
+{
+    auto const & fields = mDomain.world.fields;
+
+    uint32_t components = 0;
+    for(auto const & field : fields) {
+        components += field.components;
+    }
+
+    // every message holds the cells of the first field, then of the second and so on
+    mMessages.clear();
+    for(size_t i = 0; i < mDomain.exchanges.size(); ++i)
+    {
+        auto const & exchange = mDomain.exchanges[i];
+
+        auto & send = mSendBuffers[i];
+        send.clear();
+        for(auto const & field : fields) {
+            for(auto const cell : exchange.sendCells) {
+                auto const begin = field.values.begin() + static_cast<size_t>(cell) * field.components;
+                send.insert(send.end(), begin, begin + field.components);
+            }
+        }
+
+        mReceiveBuffers[i].resize(static_cast<size_t>(exchange.haloCount) * components);
+        mMessages.push_back({ exchange.neighbour, std::as_bytes(std::span(send)), std::as_writable_bytes(std::span(mReceiveBuffers[i])) });
+    }
+
+    if(!mTransport.exchange(mMessages, mDomain.world.tick)) {
+        return false;
+    }
+
+    for(size_t i = 0; i < mDomain.exchanges.size(); ++i)
+    {
+        auto const & exchange = mDomain.exchanges[i];
+
+        auto source = mReceiveBuffers[i].begin();
+        for(auto & field : mDomain.world.fields) {
+            size_t const count = static_cast<size_t>(exchange.haloCount) * field.components;
+            std::copy_n(source, count, field.values.begin() + static_cast<size_t>(exchange.haloBegin) * field.components);
+            source += count;
+        }
+    }
+
+    return true;
+}
+
+bool DomainSimulation::tick(double const dt)
+{
+    if(!mDomain.exchanges.empty())
+    {
+        auto const start = std::chrono::steady_clock::now();
+        bool const ok = exchange();
+        mExchangeSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        if(!ok) {
+            return false;
+        }
+    }
+
+    mHost.tick(dt);
+    return true;
+}
@@ -0,0 +1,59 @@
+//
+// @file:   domain_simulation.h
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Advances one domain of a world, in step with the other domains
+//
+
+#pragma once
+
+#include "domain.h"
+#include "halo_transport.h"
+#include "kernel/kernel_host.h"
+
+#include <vector>
+
+
+//
+// @class:  DomainSimulation
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  A KernelHost on the local world of a domain. Before every tick the
+//          owned cells next to a neighbour are sent to it and the halo cells
+//          are received, then the host steps the owned cells only. With a
+//          single domain there is nothing to exchange and a tick is a tick of
+//          the host, so the same loop runs in one or many processes.
+//
+class DomainSimulation
+{
+public:
+    DomainSimulation(Domain domain, HaloTransportSettings const & settings);
+
+    // waits until all neighbour domains are connected
+    bool connect();
+
+    // exchanges the halo of all fields and advances the owned cells by one tick, false if the exchange failed
+    bool tick(double const dt);
+
+    KernelHost & getHost();
+    Domain const & getDomain() const;
+    World const & getWorld() const;
+
+    // seconds spent in exchanges and bytes sent so far
+    double getExchangeSeconds() const;
+    uint64_t getSentBytes() const;
+
+private:
+    Domain mDomain;
+    KernelHost mHost;
+    HaloTransport mTransport;
+
+    // staging per exchange of the domain
+    std::vector<std::vector<float>> mSendBuffers;
+    std::vector<std::vector<float>> mReceiveBuffers;
+    std::vector<HaloMessage> mMessages;
+
+    double mExchangeSeconds = 0.0;
+
+    bool exchange();
+};
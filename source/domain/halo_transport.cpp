@@ -0,0 +1,559 @@
+//
+// @file:   halo_transport.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Moves halo cells between the processes of neighbour domains
+//
+
+#include "halo_transport.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct MessageHeader
+{
+    uint64_t tag;
+    uint64_t bytes;
+};
+
+// lives at the start of a shared memory segment, the data follows on the next cache line
+struct RingHeader
+{
+    static constexpr uint32_t readyMagic = 0x57535352;     // "WSSR"
+
+    std::atomic<uint32_t> ready;
+    uint64_t capacity;
+
+    alignas(64) std::atomic<uint64_t> head;     // bytes written, only the producer stores
+    alignas(64) std::atomic<uint64_t> tail;     // bytes read, only the consumer stores
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "ring counters have to work across processes");
+
+constexpr size_t ringDataOffset = (sizeof(RingHeader) + 63) / 64 * 64;
+
+std::byte * getRingData(RingHeader * const ring)
+{
+    return reinterpret_cast<std::byte *>(ring) + ringDataOffset;
+}
+
+// copies as much as fits, returns the bytes written
+size_t writeRing(RingHeader * const ring, std::span<std::byte const> const bytes)
+{
+    uint64_t const head = ring->head.load(std::memory_order_relaxed);
+    uint64_t const tail = ring->tail.load(std::memory_order_acquire);
+
+    size_t const count = std::min<size_t>(bytes.size(), ring->capacity - (head - tail));
+    size_t const position = head % ring->capacity;
+    size_t const first = std::min<size_t>(count, ring->capacity - position);
+
+    std::memcpy(getRingData(ring) + position, bytes.data(), first);
+    std::memcpy(getRingData(ring), bytes.data() + first, count - first);
+
+    ring->head.store(head + count, std::memory_order_release);
+    return count;
+}
+
+// copies what is there, returns the bytes read
+size_t readRing(RingHeader * const ring, std::span<std::byte> const bytes)
+{
+    uint64_t const tail = ring->tail.load(std::memory_order_relaxed);
+    uint64_t const head = ring->head.load(std::memory_order_acquire);
+
+    size_t const count = std::min<size_t>(bytes.size(), head - tail);
+    size_t const position = tail % ring->capacity;
+    size_t const first = std::min<size_t>(count, ring->capacity - position);
+
+    std::memcpy(bytes.data(), getRingData(ring) + position, first);
+    std::memcpy(bytes.data() + first, getRingData(ring), count - first);
+
+    ring->tail.store(tail + count, std::memory_order_release);
+    return count;
+}
+
+}
+
+
+struct HaloTransport::Impl {
+    struct Channel {
+        uint32_t neighbour = 0;
+
+        RingHeader * out = nullptr;
+        RingHeader * in = nullptr;
+        size_t outSize = 0;
+        size_t inSize = 0;
+        std::string outName;
+
+        int socket = -1;
+
+        // state of the current exchange
+        std::vector<std::byte> sendBuffer;
+        std::vector<std::byte> receiveBuffer;
+        size_t sent = 0;
+        size_t received = 0;
+    };
+
+    HaloTransportSettings settings;
+    uint32_t domain = 0;
+    std::vector<Channel> channels;
+    uint64_t sentBytes = 0;
+
+    Channel * findChannel(uint32_t const neighbour);
+
+    bool openRings(Channel & channel, Clock::time_point const deadline);
+    bool openSockets(std::vector<uint32_t> const & neighbours, Clock::time_point const deadline);
+
+    // bytes moved, -1 if the channel broke
+    long long send(Channel & channel);
+    long long receive(Channel & channel);
+
+    void close();
+};
+
+
+HaloTransport::HaloTransport(HaloTransportSettings const & settings, uint32_t const domain)
+    : mImpl(std::make_unique<Impl>())
+{
+    mImpl->settings = settings;
+    mImpl->domain = domain;
+}
+
+HaloTransport::~HaloTransport()
+{
+    mImpl->close();
+}
+
+uint64_t HaloTransport::getSentBytes() const
+{
+    return mImpl->sentBytes;
+}
+
+HaloTransport::Impl::Channel * HaloTransport::Impl::findChannel(uint32_t const neighbour)
+{
+    for(auto & channel : channels) {
+        if(channel.neighbour == neighbour) {
+            return &channel;
+        }
+    }
+    return nullptr;
+}
+
+#ifdef _WIN32
+
+bool HaloTransport::connect(std::vector<uint32_t> const & neighbours)
+{
+    if(!neighbours.empty()) {
+        std::cout << "halo transport is not available on windows" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool HaloTransport::exchange(std::span<HaloMessage const> const messages, uint64_t const)
+{
+    return messages.empty();
+}
+
+void HaloTransport::Impl::close()
+{
+    channels.clear();
+}
+
+#else
+
+namespace {
+
+std::string getRingName(std::string const & session, uint32_t const from, uint32_t const to)
+{
+    return "/" + session + "_" + std::to_string(from) + "_" + std::to_string(to);
+}
+
+RingHeader * mapRing(int const fd, size_t const size)
+{
+    void * const data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    return data == MAP_FAILED ? nullptr : static_cast<RingHeader *>(data);
+}
+
+}
+
+bool HaloTransport::Impl::openRings(Channel & channel, Clock::time_point const deadline)
+{
+    // the outgoing ring is created here, a stale one of the same name is replaced
+    channel.outName = getRingName(settings.session, domain, channel.neighbour);
+    channel.outSize = ringDataOffset + settings.ringBytes;
+    shm_unlink(channel.outName.c_str());
+
+    int const outFd = shm_open(channel.outName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if(outFd < 0) {
+        std::cout << "failed to create shared memory " << channel.outName << std::endl;
+        return false;
+    }
+    bool const resized = ftruncate(outFd, static_cast<off_t>(channel.outSize)) == 0;
+    channel.out = resized ? mapRing(outFd, channel.outSize) : nullptr;
+    ::close(outFd);
+    if(channel.out == nullptr) {
+        std::cout << "failed to map shared memory " << channel.outName << std::endl;
+        return false;
+    }
+
+    // ftruncate filled it with zeros, the counters only have to be constructed
+    new (&channel.out->head) std::atomic<uint64_t>(0);
+    new (&channel.out->tail) std::atomic<uint64_t>(0);
+    channel.out->capacity = settings.ringBytes;
+    channel.out->ready.store(RingHeader::readyMagic, std::memory_order_release);
+
+    // the incoming ring is created by the neighbour, wait until it is complete
+    std::string const inName = getRingName(settings.session, channel.neighbour, domain);
+    while(Clock::now() < deadline)
+    {
+        int const inFd = shm_open(inName.c_str(), O_RDWR, 0600);
+        if(inFd >= 0)
+        {
+            struct stat info = {};
+            if(fstat(inFd, &info) == 0 && static_cast<size_t>(info.st_size) > ringDataOffset) {
+                channel.inSize = static_cast<size_t>(info.st_size);
+                channel.in = mapRing(inFd, channel.inSize);
+            }
+            ::close(inFd);
+        }
+
+        if(channel.in != nullptr)
+        {
+            while(channel.in->ready.load(std::memory_order_acquire) != RingHeader::readyMagic && Clock::now() < deadline) {
+                std::this_thread::yield();
+            }
+
+            // the mapping stays valid, nothing is left behind if a process dies later
+            shm_unlink(inName.c_str());
+            return channel.in->ready.load(std::memory_order_acquire) == RingHeader::readyMagic;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    std::cout << "timeout waiting for shared memory " << inName << std::endl;
+    return false;
+}
+
+bool HaloTransport::Impl::openSockets(std::vector<uint32_t> const & neighbours, Clock::time_point const deadline)
+{
+    auto const getHost = [this](uint32_t const id) {
+        return id < settings.hosts.size() ? settings.hosts[id] : std::string("127.0.0.1");
+    };
+
+    auto const configure = [](int const fd) {
+        int const one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    };
+
+    // listen first, so the lower domains can connect while this one connects to the higher ones
+    int const listener = socket(AF_INET, SOCK_STREAM, 0);
+    if(listener < 0) {
+        return false;
+    }
+    int const one = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(static_cast<uint16_t>(settings.basePort + domain));
+    if(bind(listener, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 || listen(listener, 64) != 0) {
+        std::cout << "failed to listen on port " << settings.basePort + domain << std::endl;
+        ::close(listener);
+        return false;
+    }
+
+    bool ok = true;
+    size_t lower = 0;
+    for(auto const neighbour : neighbours)
+    {
+        if(neighbour < domain) {
+            lower++;
+            continue;
+        }
+
+        addrinfo hints = {};
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo * info = nullptr;
+        std::string const port = std::to_string(settings.basePort + neighbour);
+        if(getaddrinfo(getHost(neighbour).c_str(), port.c_str(), &hints, &info) != 0) {
+            std::cout << "failed to resolve " << getHost(neighbour) << std::endl;
+            ok = false;
+            break;
+        }
+
+        // the neighbour may not listen yet
+        int fd = -1;
+        while(Clock::now() < deadline)
+        {
+            fd = socket(AF_INET, SOCK_STREAM, 0);
+            if(fd >= 0 && ::connect(fd, info->ai_addr, info->ai_addrlen) == 0) {
+                break;
+            }
+            if(fd >= 0) {
+                ::close(fd);
+                fd = -1;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        freeaddrinfo(info);
+
+        // the first bytes tell the neighbour which domain connected
+        if(fd < 0 || ::send(fd, &domain, sizeof(domain), 0) != sizeof(domain)) {
+            std::cout << "failed to connect to domain " << neighbour << std::endl;
+            if(fd >= 0) {
+                ::close(fd);
+            }
+            ok = false;
+            break;
+        }
+
+        configure(fd);
+        findChannel(neighbour)->socket = fd;
+    }
+
+    for(size_t accepted = 0; ok && accepted < lower; ++accepted)
+    {
+        pollfd request = { listener, POLLIN, 0 };
+        auto const remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count();
+        if(remaining <= 0 || poll(&request, 1, static_cast<int>(remaining)) <= 0) {
+            std::cout << "timeout waiting for the lower domains" << std::endl;
+            ok = false;
+            break;
+        }
+
+        int const fd = accept(listener, nullptr, nullptr);
+        uint32_t neighbour = 0;
+        Channel * const channel = fd >= 0 && recv(fd, &neighbour, sizeof(neighbour), MSG_WAITALL) == sizeof(neighbour)
+            ? findChannel(neighbour) : nullptr;
+        if(channel == nullptr || channel->socket >= 0) {
+            std::cout << "unexpected connection to domain " << domain << std::endl;
+            if(fd >= 0) {
+                ::close(fd);
+            }
+            ok = false;
+            break;
+        }
+
+        configure(fd);
+        channel->socket = fd;
+    }
+
+    ::close(listener);
+    return ok;
+}
+
+bool HaloTransport::connect(std::vector<uint32_t> const & neighbours)
+{
+    mImpl->close();
+
+    auto const deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(mImpl->settings.timeout));
+
+    for(auto const neighbour : neighbours) {
+        mImpl->channels.emplace_back().neighbour = neighbour;
+    }
+
+    bool ok = true;
+    if(mImpl->settings.type == HaloTransportType::eSharedMemory) {
+        for(auto & channel : mImpl->channels) {
+            ok = ok && mImpl->openRings(channel, deadline);
+        }
+    }
+    else {
+        ok = mImpl->openSockets(neighbours, deadline);
+    }
+
+    if(!ok) {
+        mImpl->close();
+    }
+    return ok;
+}
+
+long long HaloTransport::Impl::send(Channel & channel)
+{
+    std::span<std::byte const> const pending = std::span<std::byte const>(channel.sendBuffer).subspan(channel.sent);
+
+    if(channel.out != nullptr) {
+        return static_cast<long long>(writeRing(channel.out, pending));
+    }
+
+#ifdef MSG_NOSIGNAL
+    ssize_t const count = ::send(channel.socket, pending.data(), pending.size(), MSG_NOSIGNAL);
+#else
+    ssize_t const count = ::send(channel.socket, pending.data(), pending.size(), 0);
+#endif
+    if(count < 0) {
+        return errno == EAGAIN || errno == EWOULDBLOCK ? 0 : -1;
+    }
+    return count;
+}
+
+long long HaloTransport::Impl::receive(Channel & channel)
+{
+    std::span<std::byte> const pending = std::span<std::byte>(channel.receiveBuffer).subspan(channel.received);
+
+    if(channel.in != nullptr) {
+        return static_cast<long long>(readRing(channel.in, pending));
+    }
+
+    ssize_t const count = recv(channel.socket, pending.data(), pending.size(), 0);
+    if(count == 0) {
+        return -1;
+    }
+    if(count < 0) {
+        return errno == EAGAIN || errno == EWOULDBLOCK ? 0 : -1;
+    }
+    return count;
+}
+
+bool HaloTransport::exchange(std::span<HaloMessage const> const messages, uint64_t const tag)
+{
+    auto const deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(mImpl->settings.timeout));
+
+    std::vector<Impl::Channel *> active;
+    for(auto const & message : messages)
+    {
+        Impl::Channel * const channel = mImpl->findChannel(message.neighbour);
+        if(channel == nullptr) {
+            return false;
+        }
+
+        MessageHeader const header = { tag, message.send.size() };
+        channel->sendBuffer.resize(sizeof(header) + message.send.size());
+        std::memcpy(channel->sendBuffer.data(), &header, sizeof(header));
+        std::copy(message.send.begin(), message.send.end(), channel->sendBuffer.begin() + sizeof(header));
+        channel->receiveBuffer.resize(sizeof(header) + message.receive.size());
+        channel->sent = 0;
+        channel->received = 0;
+
+        active.push_back(channel);
+    }
+
+    size_t idle = 0;
+    while(true)
+    {
+        bool done = true;
+        bool progress = false;
+
+        for(auto * const channel : active)
+        {
+            if(channel->sent < channel->sendBuffer.size())
+            {
+                long long const count = mImpl->send(*channel);
+                if(count < 0) {
+                    return false;
+                }
+                channel->sent += static_cast<size_t>(count);
+                progress = progress || count > 0;
+            }
+
+            if(channel->received < channel->receiveBuffer.size())
+            {
+                long long const count = mImpl->receive(*channel);
+                if(count < 0) {
+                    return false;
+                }
+                channel->received += static_cast<size_t>(count);
+                progress = progress || count > 0;
+            }
+
+            done = done && channel->sent == channel->sendBuffer.size() && channel->received == channel->receiveBuffer.size();
+        }
+
+        if(done) {
+            break;
+        }
+
+        if(progress) {
+            idle = 0;
+            continue;
+        }
+
+        if(Clock::now() > deadline) {
+            std::cout << "timeout in the halo exchange of domain " << mImpl->domain << std::endl;
+            return false;
+        }
+
+        // spin shortly, neighbours usually arrive within microseconds, then give the core away
+        if(mImpl->settings.type == HaloTransportType::eSocket && idle > 64)
+        {
+            std::vector<pollfd> requests;
+            for(auto * const channel : active) {
+                short const events = static_cast<short>((channel->sent < channel->sendBuffer.size() ? POLLOUT : 0)
+                    | (channel->received < channel->receiveBuffer.size() ? POLLIN : 0));
+                if(events != 0) {
+                    requests.push_back({ channel->socket, events, 0 });
+                }
+            }
+            poll(requests.data(), requests.size(), 10);
+        }
+        else if(++idle > 1024) {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+
+    for(size_t i = 0; i < messages.size(); ++i)
+    {
+        MessageHeader header;
+        std::memcpy(&header, active[i]->receiveBuffer.data(), sizeof(header));
+        if(header.tag != tag || header.bytes != messages[i].receive.size()) {
+            std::cout << "domain " << mImpl->domain << " got tag " << header.tag << " with " << header.bytes
+                      << " bytes from domain " << messages[i].neighbour << ", expected tag " << tag
+                      << " with " << messages[i].receive.size() << " bytes" << std::endl;
+            return false;
+        }
+
+        std::copy(active[i]->receiveBuffer.begin() + sizeof(header), active[i]->receiveBuffer.end(), messages[i].receive.begin());
+        mImpl->sentBytes += messages[i].send.size();
+    }
+
+    return true;
+}
+
+void HaloTransport::Impl::close()
+{
+    for(auto & channel : channels)
+    {
+        if(channel.out != nullptr) {
+            munmap(channel.out, channel.outSize);
+            shm_unlink(channel.outName.c_str());
+        }
+        if(channel.in != nullptr) {
+            munmap(channel.in, channel.inSize);
+        }
+        if(channel.socket >= 0) {
+            ::close(channel.socket);
+        }
+    }
+
+    channels.clear();
+}
+
+#endif
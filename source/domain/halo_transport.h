@@ -0,0 +1,78 @@
+//
+// @file:   halo_transport.h
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Moves halo cells between the processes of neighbour domains
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+
+enum class HaloTransportType
+{
+    eSharedMemory,      // POSIX shared memory ring buffers, all domains on one machine
+    eSocket,            // TCP, stand in for domains on several machines
+};
+
+struct HaloTransportSettings
+{
+    HaloTransportType type = HaloTransportType::eSharedMemory;
+
+    // prefix of the shared memory names, unique per run so a crashed run can not interfere
+    std::string session = "wss";
+    size_t ringBytes = size_t(1) << 20;         // per direction and neighbour
+
+    std::vector<std::string> hosts;             // host of every domain, empty for all on localhost
+    uint16_t basePort = 47000;                  // domain i listens on basePort + i
+
+    double timeout = 30.0;                      // seconds until connect or exchange give up
+};
+
+struct HaloMessage
+{
+    uint32_t neighbour = 0;
+    std::span<std::byte const> send;
+    std::span<std::byte> receive;               // size has to match what the neighbour sends
+};
+
+//
+// @class:  HaloTransport
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  One channel per neighbour domain, either a pair of single
+//          producer single consumer rings in shared memory or a TCP
+//          connection. An exchange moves one message each way over every
+//          channel and makes progress on all of them at once, so two domains
+//          that both wait for free space can not dead lock. Every message
+//          carries a tag, usually the tick, and its size to catch domains
+//          that got out of step. POSIX only.
+//
+class HaloTransport
+{
+public:
+    HaloTransport(HaloTransportSettings const & settings, uint32_t const domain);
+    ~HaloTransport();
+
+    HaloTransport(HaloTransport const &) = delete;
+    HaloTransport& operator=(HaloTransport const &) = delete;
+
+    // opens the channels to the neighbour domains, waits until the neighbours did the same
+    bool connect(std::vector<uint32_t> const & neighbours);
+
+    // false on a timeout, a closed channel or a message with another tag or size
+    bool exchange(std::span<HaloMessage const> const messages, uint64_t const tag);
+
+    // bytes sent by all exchanges so far
+    uint64_t getSentBytes() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> mImpl;
+};
@@ -8,7 +8,10 @@
 #pragma once
 
 #include "include_glm.h"
+#include "memory/monotonic_arena.h"
+#include "telemetry/telemetry.h"
 #include <glm/gtc/constants.hpp>
+#include <memory_resource>
 
 // Vulkan Coordinate System
 //  z
@@ -21,9 +24,12 @@
 //
 //
 
-auto createSphereVertices(float const r = 0.5, size_t const n = 10)
+using SphereGrid = std::pmr::vector<std::pmr::vector<glm::vec3>>;
+
+inline SphereGrid createSphereVertices(float const r = 0.5, size_t const n = 10,
+    std::pmr::memory_resource * const resource = std::pmr::get_default_resource())
 {
-    std::vector<std::vector<glm::vec3>> data;
+    SphereGrid data(resource);
     data.resize(n);
     for(auto & elem : data) {
         elem.resize(n);
@@ -49,9 +55,17 @@ auto createSphereVertices(float const r = 0.5, size_t const n = 10)
     return data;
 }
 
-auto createPlaneVertices(float const r = 0.5, size_t const n = 10)
+// bytes createSphereVertices allocates, the n rows and their n vertices each, plus alignment padding
+inline size_t getSphereVerticesBytes(size_t const n)
 {
-    std::vector<std::vector<glm::vec3>> data;
+    using Row = SphereGrid::value_type;
+    return n * sizeof(Row) + alignof(Row) + n * (n * sizeof(glm::vec3) + alignof(glm::vec3));
+}
+
+inline SphereGrid createPlaneVertices(float const r = 0.5, size_t const n = 10,
+    std::pmr::memory_resource * const resource = std::pmr::get_default_resource())
+{
+    SphereGrid data(resource);
     data.resize(n);
     for(auto & elem : data) {
         elem.resize(n);
@@ -75,9 +89,11 @@ auto createPlaneVertices(float const r = 0.5, size_t const n = 10)
     return data;
 }
 
-std::vector<glm::vec3> flatSphereData(std::vector<std::vector<glm::vec3>> const & data)
+inline std::pmr::vector<glm::vec3> flatSphereData(SphereGrid const & data,
+    std::pmr::memory_resource * const resource = std::pmr::get_default_resource())
 {
-    std::vector<glm::vec3> res;
+    std::pmr::vector<glm::vec3> res(resource);
+    res.reserve(data.size() * (data.empty() ? 0 : data.front().size()));
     for(auto & elem : data) {
         for(auto & elem2 : elem) {
             res.push_back(elem2);
@@ -87,14 +103,16 @@ std::vector<glm::vec3> flatSphereData(std::vector<std::vector<glm::vec3>> const
     return res;
 }
 
-std::vector<glm::vec3> createSphereTriangles(std::vector<std::vector<glm::vec3>> const & data)
+inline std::pmr::vector<glm::vec3> createSphereTriangles(SphereGrid const & data,
+    std::pmr::memory_resource * const resource = std::pmr::get_default_resource())
 {
     size_t const n = data.size();
     for(auto & elem : data) {
         assert(elem.size() == n);
     }
 
-    std::vector<glm::vec3> res;
+    std::pmr::vector<glm::vec3> res(resource);
+    res.reserve(n * n * 6);
 
     for(size_t j = 0; j < n; ++j) {
         for(size_t i = 0; i < n; ++i) {
@@ -109,4 +127,19 @@ std::vector<glm::vec3> createSphereTriangles(std::vector<std::vector<glm::vec3>>
     }
 
     return res;
-}
\ No newline at end of file
+}
+
+// builds the triangles of a sphere, the vertex grid only lives in a temporary arena
+inline std::pmr::vector<glm::vec3> createSphereMesh(float const r = 0.5, size_t const n = 10,
+    std::pmr::memory_resource * const resource = std::pmr::get_default_resource())
+{
+    MonotonicArena arena(getSphereVerticesBytes(n));
+    auto const grid = createSphereVertices(r, n, &arena);
+    auto triangles = createSphereTriangles(grid, resource);
+
+    auto & telemetry = getTelemetry();
+    telemetry.getHistogram("mesh.sphere.bytes").record(triangles.size() * sizeof(glm::vec3));
+    telemetry.getHistogram("mesh.sphere.scratch_bytes").record(arena.getStatistics().peakBytes);
+
+    return triangles;
+}
@@ -0,0 +1,301 @@
+//
+// @file:   static_mesh.h
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Meshes of a fixed resolution, computed by the compiler
+//
+
+#pragma once
+
+#include "include_glm.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+
+// the std functions are not constexpr before C++26, these are exact enough for float vertices
+namespace constmath {
+
+constexpr double pi = 3.14159265358979323846;
+
+constexpr double sin(double x)
+{
+    // to [-pi, pi], then to [-pi/2, pi/2] where the series converges fast
+    double const turns = x / (2.0 * pi);
+    x -= 2.0 * pi * static_cast<double>(static_cast<int64_t>(turns >= 0.0 ? turns + 0.5 : turns - 0.5));
+    if(x > 0.5 * pi) {
+        x = pi - x;
+    }
+    else if(x < -0.5 * pi) {
+        x = -pi - x;
+    }
+
+    double const x2 = x * x;
+    double term = x;
+    double sum = x;
+    for(int k = 1; k < 12; ++k) {
+        term *= -x2 / static_cast<double>((2 * k) * (2 * k + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double cos(double const x)
+{
+    return sin(x + 0.5 * pi);
+}
+
+constexpr double sqrt(double const x)
+{
+    if(!(x > 0.0)) {
+        return 0.0;
+    }
+
+    double root = x > 1.0 ? x : 1.0;
+    for(int i = 0; i < 128; ++i)
+    {
+        double const next = 0.5 * (root + x / root);
+        if(next >= root) {
+            break;
+        }
+        root = next;
+    }
+    return root;
+}
+
+}
+
+
+//
+// @struct: StaticMesh
+// @brief:  Vertices and an index buffer of triangles, the sizes are template
+//          parameters, so a constexpr mesh is plain read only data.
+//
+template<size_t VertexCount, size_t IndexCount>
+struct StaticMesh
+{
+    std::array<glm::vec3, VertexCount> vertices = {};
+    std::array<uint32_t, IndexCount> indices = {};
+
+    // triangle list as drawn by the SphereShaderObject
+    constexpr std::array<glm::vec3, IndexCount> getTriangles() const
+    {
+        std::array<glm::vec3, IndexCount> triangles = {};
+        for(size_t i = 0; i < IndexCount; ++i) {
+            triangles[i] = vertices[indices[i]];
+        }
+        return triangles;
+    }
+};
+
+
+// cube of half size a, every face a grid of n * n quads, counter clockwise seen from outside
+template<size_t n>
+constexpr StaticMesh<6 * (n + 1) * (n + 1), 6 * n * n * 6> createStaticCube(float const a = 0.5f)
+{
+    static_assert(n > 0);
+
+    // normal, u and v of every face, u x v = normal
+    constexpr int axes[6][3][3] = {
+        { {  1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } },
+        { { -1, 0, 0 }, { 0, 0, 1 }, { 0, 1, 0 } },
+        { { 0,  1, 0 }, { 0, 0, 1 }, { 1, 0, 0 } },
+        { { 0, -1, 0 }, { 1, 0, 0 }, { 0, 0, 1 } },
+        { { 0, 0,  1 }, { 1, 0, 0 }, { 0, 1, 0 } },
+        { { 0, 0, -1 }, { 0, 1, 0 }, { 1, 0, 0 } },
+    };
+
+    StaticMesh<6 * (n + 1) * (n + 1), 6 * n * n * 6> mesh;
+
+    size_t vertex = 0;
+    size_t index = 0;
+    for(size_t face = 0; face < 6; ++face)
+    {
+        auto const & normal = axes[face][0];
+        auto const & u = axes[face][1];
+        auto const & v = axes[face][2];
+
+        uint32_t const first = static_cast<uint32_t>(vertex);
+        for(size_t j = 0; j <= n; ++j) {
+            for(size_t i = 0; i <= n; ++i)
+            {
+                float const s = -a + 2.0f * a * static_cast<float>(i) / static_cast<float>(n);
+                float const t = -a + 2.0f * a * static_cast<float>(j) / static_cast<float>(n);
+                mesh.vertices[vertex++] = glm::vec3(
+                    static_cast<float>(normal[0]) * a + static_cast<float>(u[0]) * s + static_cast<float>(v[0]) * t,
+                    static_cast<float>(normal[1]) * a + static_cast<float>(u[1]) * s + static_cast<float>(v[1]) * t,
+                    static_cast<float>(normal[2]) * a + static_cast<float>(u[2]) * s + static_cast<float>(v[2]) * t);
+            }
+        }
+
+        for(size_t j = 0; j < n; ++j) {
+            for(size_t i = 0; i < n; ++i)
+            {
+                uint32_t const p00 = first + static_cast<uint32_t>(j * (n + 1) + i);
+                uint32_t const p10 = p00 + 1;
+                uint32_t const p01 = p00 + static_cast<uint32_t>(n + 1);
+                uint32_t const p11 = p01 + 1;
+
+                mesh.indices[index++] = p00;
+                mesh.indices[index++] = p10;
+                mesh.indices[index++] = p11;
+
+                mesh.indices[index++] = p11;
+                mesh.indices[index++] = p01;
+                mesh.indices[index++] = p00;
+            }
+        }
+    }
+
+    return mesh;
+}
+
+// the same vertices and triangles as createSphereVertices and createSphereTriangles
+template<size_t n>
+constexpr StaticMesh<n * n, n * n * 6> createStaticUvSphere(float const r = 0.5f)
+{
+    static_assert(n > 1);
+
+    StaticMesh<n * n, n * n * 6> mesh;
+
+    for(size_t j = 0; j < n; ++j)
+    {
+        double const beta = constmath::pi / static_cast<double>(n - 1) * static_cast<double>(j);
+        double const z = constmath::cos(beta) * r;
+        double const subR = constmath::sin(beta) * r;
+
+        for(size_t i = 0; i < n; ++i)
+        {
+            double const alpha = 2.0 * constmath::pi / static_cast<double>(n) * static_cast<double>(i);
+            mesh.vertices[j * n + i] = glm::vec3(
+                static_cast<float>(constmath::cos(alpha) * (subR < 0.0 ? -subR : subR)),
+                static_cast<float>(constmath::sin(alpha) * (subR < 0.0 ? -subR : subR)),
+                static_cast<float>(z));
+        }
+    }
+
+    auto const vertex = [](size_t const j, size_t const i) {
+        return static_cast<uint32_t>((j % n) * n + (i % n));
+    };
+
+    size_t index = 0;
+    for(size_t j = 0; j < n; ++j) {
+        for(size_t i = 0; i < n; ++i)
+        {
+            mesh.indices[index++] = vertex(j, i);
+            mesh.indices[index++] = vertex(j + 1, i);
+            mesh.indices[index++] = vertex(j, i + 1);
+
+            mesh.indices[index++] = vertex(j + 1, i + 1);
+            mesh.indices[index++] = vertex(j, i + 1);
+            mesh.indices[index++] = vertex(j + 1, i);
+        }
+    }
+
+    return mesh;
+}
+
+constexpr size_t getIcosphereVertexCount(size_t const subdivisions)
+{
+    size_t faces = 20;
+    for(size_t i = 0; i < subdivisions; ++i) {
+        faces *= 4;
+    }
+    return faces / 2 + 2;
+}
+
+// icosahedron whose triangles are split into 4 per subdivision, the new vertices are pushed onto the sphere
+template<size_t subdivisions>
+constexpr StaticMesh<getIcosphereVertexCount(subdivisions), (getIcosphereVertexCount(subdivisions) - 2) * 2 * 3>
+    createStaticIcosphere(float const r = 0.5f)
+{
+    constexpr size_t vertexCount = getIcosphereVertexCount(subdivisions);
+    constexpr size_t indexCount = (vertexCount - 2) * 2 * 3;
+
+    constexpr double t = 1.6180339887498948482;
+    constexpr double corners[12][3] = {
+        { -1,  t,  0 }, {  1,  t,  0 }, { -1, -t,  0 }, {  1, -t,  0 },
+        {  0, -1,  t }, {  0,  1,  t }, {  0, -1, -t }, {  0,  1, -t },
+        {  t,  0, -1 }, {  t,  0,  1 }, { -t,  0, -1 }, { -t,  0,  1 },
+    };
+    constexpr uint32_t faces[20][3] = {
+        { 0, 11,  5 }, { 0,  5,  1 }, {  0,  1,  7 }, {  0,  7, 10 }, { 0, 10, 11 },
+        { 1,  5,  9 }, { 5, 11,  4 }, { 11, 10,  2 }, { 10,  7,  6 }, { 7,  1,  8 },
+        { 3,  9,  4 }, { 3,  4,  2 }, {  3,  2,  6 }, {  3,  6,  8 }, { 3,  8,  9 },
+        { 4,  9,  5 }, { 2,  4, 11 }, {  6,  2, 10 }, {  8,  6,  7 }, { 9,  8,  1 },
+    };
+
+    std::array<std::array<double, 3>, vertexCount> positions = {};
+    size_t vertices = 0;
+
+    auto const addVertex = [&](double const x, double const y, double const z) {
+        double const length = constmath::sqrt(x * x + y * y + z * z);
+        positions[vertices] = { x / length, y / length, z / length };
+        return static_cast<uint32_t>(vertices++);
+    };
+
+    for(auto const & corner : corners) {
+        addVertex(corner[0], corner[1], corner[2]);
+    }
+
+    std::array<uint32_t, indexCount> indices = {};
+    std::array<uint32_t, indexCount> next = {};
+    size_t triangles = 20;
+    for(size_t i = 0; i < 20; ++i) {
+        for(size_t k = 0; k < 3; ++k) {
+            indices[i * 3 + k] = faces[i][k];
+        }
+    }
+
+    // every edge is split once for both of its triangles, open addressing with key 0 for empty slots
+    constexpr size_t slots = indexCount < 64 ? 64 : indexCount * 2;
+    std::array<uint64_t, slots> keys = {};
+    std::array<uint32_t, slots> midpoints = {};
+
+    auto const getMidpoint = [&](uint32_t const a, uint32_t const b) {
+        uint64_t const key = (static_cast<uint64_t>(a < b ? a : b) << 32 | (a < b ? b : a)) + 1;
+        size_t slot = static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) % slots;
+        while(keys[slot] != 0 && keys[slot] != key) {
+            slot = (slot + 1) % slots;
+        }
+
+        if(keys[slot] == 0) {
+            keys[slot] = key;
+            midpoints[slot] = addVertex(positions[a][0] + positions[b][0], positions[a][1] + positions[b][1],
+                positions[a][2] + positions[b][2]);
+        }
+        return midpoints[slot];
+    };
+
+    for(size_t level = 0; level < subdivisions; ++level)
+    {
+        keys = {};
+        for(size_t i = 0; i < triangles; ++i)
+        {
+            uint32_t const a = indices[i * 3];
+            uint32_t const b = indices[i * 3 + 1];
+            uint32_t const c = indices[i * 3 + 2];
+            uint32_t const ab = getMidpoint(a, b);
+            uint32_t const bc = getMidpoint(b, c);
+            uint32_t const ca = getMidpoint(c, a);
+
+            uint32_t const split[12] = { a, ab, ca,  b, bc, ab,  c, ca, bc,  ab, bc, ca };
+            for(size_t k = 0; k < 12; ++k) {
+                next[i * 12 + k] = split[k];
+            }
+        }
+
+        indices = next;
+        triangles *= 4;
+    }
+
+    StaticMesh<vertexCount, indexCount> mesh;
+    for(size_t i = 0; i < vertexCount; ++i) {
+        mesh.vertices[i] = glm::vec3(static_cast<float>(positions[i][0] * r), static_cast<float>(positions[i][1] * r),
+            static_cast<float>(positions[i][2] * r));
+    }
+    mesh.indices = indices;
+
+    return mesh;
+}
@@ -0,0 +1,43 @@
+//
+// @file:   static_meshes.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  The meshes of the common bodies, stored as read only data
+//
+
+#include "static_meshes.h"
+#include "static_mesh.h"
+
+
+namespace {
+
+constexpr auto cube = createStaticCube<1>(0.5f);
+constexpr auto icosphere = createStaticIcosphere<3>(1.0f);
+constexpr auto sphere = createStaticUvSphere<100>(2.0f);
+constexpr auto sphereTriangles = sphere.getTriangles();
+
+static_assert(icosphere.vertices.size() == 642 && icosphere.indices.size() == 1280 * 3);
+static_assert(sphereTriangles.size() == 100 * 100 * 6);
+
+}
+
+
+StaticMeshView getStaticCubeMesh()
+{
+    return { cube.vertices, cube.indices };
+}
+
+StaticMeshView getStaticIcosphereMesh()
+{
+    return { icosphere.vertices, icosphere.indices };
+}
+
+StaticMeshView getStaticSphereMesh()
+{
+    return { sphere.vertices, sphere.indices };
+}
+
+std::span<glm::vec3 const> getStaticSphereTriangles()
+{
+    return sphereTriangles;
+}
@@ -0,0 +1,34 @@
+//
+// @file:   static_meshes.h
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  The meshes of the common bodies, stored as read only data
+//
+
+#pragma once
+
+#include "include_glm.h"
+
+#include <cstdint>
+#include <span>
+
+
+struct StaticMeshView
+{
+    std::span<glm::vec3 const> vertices;
+    std::span<uint32_t const> indices;
+};
+
+// the meshes are computed by the compiler, startup does no mesh work and all processes share the pages
+
+// half size 0.5, one quad per face like createCubeVertices
+StaticMeshView getStaticCubeMesh();
+
+// radius 1, 3 subdivisions, 642 vertices
+StaticMeshView getStaticIcosphereMesh();
+
+// radius 2, 100 * 100 vertices, the body of the render path
+StaticMeshView getStaticSphereMesh();
+
+// triangle list of getStaticSphereMesh, the same as createSphereMesh(2.0f, 100)
+std::span<glm::vec3 const> getStaticSphereTriangles();
@@ -0,0 +1,56 @@
+//
+// @file:   diffusion_kernel.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Heat diffusion over the cell graph, the built in kernel
+//
+
+#include "diffusion_kernel.h"
+
+namespace {
+
+constexpr float diffusionRate = 0.2f;
+
+WssFieldDescriptor const fields[] = {
+    { "temperature", 1, 0.0f },
+};
+
+void step(WssKernelContext const * context, uint64_t const cellBegin, uint64_t const cellEnd)
+{
+    auto const & temperature = context->fields[0];
+    float const rate = static_cast<float>(context->dt) * diffusionRate;
+
+    for(uint64_t cell = cellBegin; cell < cellEnd; ++cell)
+    {
+        uint32_t const begin = context->adjacencyOffsets[cell];
+        uint32_t const end = context->adjacencyOffsets[cell + 1];
+
+        float sum = 0.0f;
+        for(uint32_t k = begin; k < end; ++k) {
+            sum += temperature.read[context->adjacency[k]];
+        }
+
+        float const value = temperature.read[cell];
+        float const mean = end > begin ? sum / static_cast<float>(end - begin) : value;
+        temperature.write[cell] = value + rate * (mean - value);
+    }
+}
+
+WssKernel const kernel = {
+    WSS_KERNEL_ABI_VERSION,
+    1,
+    "diffusion",
+    fields,
+    sizeof(fields) / sizeof(fields[0]),
+    step,
+    nullptr,
+    0,
+    nullptr,
+};
+
+}
+
+WssKernel const * getDiffusionKernel()
+{
+    return &kernel;
+}
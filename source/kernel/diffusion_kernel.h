@@ -0,0 +1,12 @@
+//
+// @file:   diffusion_kernel.h
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Heat diffusion over the cell graph, the built in kernel
+//
+
+#pragma once
+
+#include "kernel_abi.h"
+
+WssKernel const * getDiffusionKernel();
@@ -0,0 +1,102 @@
+//
+// @file:   kernel_abi.h
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Interface between the host and hot swappable simulation kernels
+//
+
+#pragma once
+
+#include <cstdint>
+
+
+//
+// A kernel library exports
+//
+//   extern "C" WssKernel const * wssGetKernel();
+//
+// The returned struct lists the fields the kernel works on. The host owns
+// the memory of all fields, keeps a read and a write buffer of each and
+// swaps them after every tick. When a new version of the kernel lists other
+// fields the host migrates its state before the first tick of the new
+// version: fields are matched by name, new fields are filled with their
+// default value, fields with another component count keep the components
+// both versions have, fields no kernel uses are kept for later versions.
+//
+// Particles are kept the same way. The world owns a number of particles and
+// the kernel lists the attributes it works on, e.g. a position or a mass.
+// Attributes are migrated like fields, and when the world adds or removes
+// particles between two ticks the attributes are resized, new particles get
+// the default values. Kernels do not add or remove particles themselves.
+//
+// Only plain C types cross the boundary, so host and kernel may be built
+// with different compilers.
+//
+
+#define WSS_KERNEL_ABI_VERSION 2
+
+#ifdef _WIN32
+#define WSS_KERNEL_EXPORT extern "C" __declspec(dllexport)
+#else
+#define WSS_KERNEL_EXPORT extern "C" __attribute__((visibility("default")))
+#endif
+
+extern "C" {
+
+struct WssFieldDescriptor
+{
+    char const * name;
+    uint32_t components;
+    float defaultValue;
+};
+
+struct WssFieldBuffer
+{
+    float const * read;             // state of the last tick
+    float * write;                  // state of this tick
+    uint32_t components;
+};
+
+struct WssKernelContext
+{
+    uint64_t cellCount;
+    uint32_t const * adjacencyOffsets;          // cellCount + 1
+    uint32_t const * adjacency;
+
+    WssFieldBuffer const * fields;              // in the order of WssKernel::fields
+    uint32_t fieldCount;
+
+    uint64_t particleCount;
+    WssFieldBuffer const * particleAttributes;  // in the order of WssKernel::particleAttributes
+    uint32_t particleAttributeCount;
+
+    uint64_t tick;
+    double time;
+    double dt;
+};
+
+struct WssKernel
+{
+    uint32_t abiVersion;                        // WSS_KERNEL_ABI_VERSION
+    uint32_t layoutVersion;                     // bumped by the kernel when its fields or attributes change
+    char const * name;
+
+    WssFieldDescriptor const * fields;
+    uint32_t fieldCount;
+
+    // computes the cells [cellBegin, cellEnd), may run on several threads at once.
+    // Every component of every cell in the range has to be written.
+    void (*step)(WssKernelContext const * context, uint64_t cellBegin, uint64_t cellEnd);
+
+    WssFieldDescriptor const * particleAttributes;
+    uint32_t particleAttributeCount;
+
+    // computes the particles [particleBegin, particleEnd) in the same tick as the cells, may run
+    // on several threads at once. Fields are only read. Every component of every particle in the
+    // range has to be written. Null for kernels without particles, their attributes stay as they are.
+    void (*stepParticles)(WssKernelContext const * context, uint64_t particleBegin, uint64_t particleEnd);
+};
+
+using WssGetKernelFunction = WssKernel const * (*)();
+
+}
@@ -0,0 +1,329 @@
+//
+// @file:   kernel_host.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Runs a simulation kernel on the fields of a world
+//
+
+#include "kernel_host.h"
+#include "tasks/parallel_for.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+
+namespace {
+
+// cells per call of step, large enough that a thread pays off
+constexpr size_t minCellsPerChunk = 16 * 1024;
+constexpr size_t minParticlesPerChunk = 16 * 1024;
+
+// with statistics a chunk is stepped in blocks that are reduced while they are still in the cache
+constexpr size_t cellsPerReductionBlock = 4 * 1024;
+
+}
+
+
+KernelHost::KernelHost(World & world)
+    : mWorld(world),
+      mWorkingSetGauge(getTelemetry().getGauge("sim.working_set_bytes")),
+      mTickCounter(getTelemetry().getCounter("sim.ticks"))
+{
+
+}
+
+void KernelHost::setKernel(WssKernel const * const kernel)
+{
+    mLibrary.reset();
+    swapKernel(kernel);
+}
+
+void KernelHost::watchKernel(std::string const & filename)
+{
+    mLibrary = std::make_unique<DllFunctionHotswap<WssKernel const *()>>(filename, "wssGetKernel");
+    mLibraryVersion = mLibrary->getVersion();
+    swapKernel((*mLibrary)());
+}
+
+void KernelHost::setStatisticsEnabled(bool const enabled)
+{
+    mStatisticsEnabled = enabled;
+    mStatisticsValid = false;
+}
+
+std::span<FieldStatistics const> KernelHost::getStatistics() const
+{
+    return mStatisticsValid ? mReducer.getStatistics() : std::span<FieldStatistics const>();
+}
+
+FieldStatistics const * KernelHost::findStatistics(std::string_view const name) const
+{
+    return mStatisticsValid ? mReducer.findStatistics(name) : nullptr;
+}
+
+void KernelHost::setComputedCellCount(size_t const count)
+{
+    mComputedCellCount = count;
+}
+
+WssKernel const * KernelHost::getKernel() const
+{
+    return mKernel;
+}
+
+uint64_t KernelHost::getKernelChanges() const
+{
+    return mKernelChanges;
+}
+
+size_t KernelHost::getWorkingSetSize() const
+{
+    size_t size = 0;
+    for(auto const & field : mWorld.fields) {
+        size += field.values.size() * sizeof(float);
+    }
+    for(auto const & buffer : mWriteBuffers) {
+        size += buffer.size() * sizeof(float);
+    }
+    for(auto const & attribute : mWorld.particleAttributes) {
+        size += attribute.values.size() * sizeof(float);
+    }
+    for(auto const & buffer : mParticleWriteBuffers) {
+        size += buffer.size() * sizeof(float);
+    }
+
+    return size;
+}
+
+void KernelHost::swapKernel(WssKernel const * const kernel)
+{
+    if(kernel == mKernel) {
+        return;
+    }
+
+    // the previous kernel may live in a library that is about to be freed, so it is not kept
+    if(kernel == nullptr) {
+        mKernel = nullptr;
+        return;
+    }
+
+    if(kernel->abiVersion != WSS_KERNEL_ABI_VERSION) {
+        std::cout << "kernel " << kernel->name << " has abi version " << kernel->abiVersion
+                  << ", expected " << WSS_KERNEL_ABI_VERSION << std::endl;
+        mKernel = nullptr;
+        return;
+    }
+
+    mKernel = kernel;
+    mKernelChanges++;
+
+    // the descriptor is copied, the old library may be gone by the time the next one arrives
+    auto const copyLayout = [](WssFieldDescriptor const * const fields, uint32_t const count) {
+        std::vector<FieldLayout> layout;
+        for(uint32_t i = 0; i < count; ++i) {
+            layout.push_back({ fields[i].name, std::max<uint32_t>(fields[i].components, 1), fields[i].defaultValue });
+        }
+        return layout;
+    };
+
+    mLayout = copyLayout(kernel->fields, kernel->fieldCount);
+    mParticleLayout = copyLayout(kernel->particleAttributes, kernel->particleAttributeCount);
+    migrate();
+}
+
+size_t KernelHost::migrateField(std::vector<WorldField> & fields, size_t const count, FieldLayout const & layout)
+{
+    auto it = std::find_if(fields.begin(), fields.end(),
+        [&](WorldField const & field) { return field.name == layout.name; });
+
+    if(it == fields.end())
+    {
+        fields.push_back({ layout.name, layout.components, std::vector<float>(count * layout.components, layout.defaultValue) });
+        it = fields.end() - 1;
+    }
+    else if(it->components != layout.components)
+    {
+        // keep the components both layouts have
+        std::vector<float> values(count * layout.components, layout.defaultValue);
+        uint32_t const common = std::min(it->components, layout.components);
+        size_t const kept = std::min(count, it->values.size() / it->components);
+        for(size_t i = 0; i < kept; ++i) {
+            std::copy_n(it->values.begin() + i * it->components, common, values.begin() + i * layout.components);
+        }
+
+        it->values = std::move(values);
+        it->components = layout.components;
+    }
+
+    return static_cast<size_t>(it - fields.begin());
+}
+
+void KernelHost::migrate()
+{
+    size_t const cellCount = mWorld.getCellCount();
+
+    mFieldIndices.clear();
+    mWriteBuffers.resize(mLayout.size());
+
+    // new fields move the others at most once per swap, references into
+    // mWorld.fields are fetched again after a tick
+    mWorld.fields.reserve(mWorld.fields.size() + mLayout.size());
+
+    for(size_t i = 0; i < mLayout.size(); ++i) {
+        mFieldIndices.push_back(migrateField(mWorld.fields, cellCount, mLayout[i]));
+        mWriteBuffers[i].resize(mWorld.fields[mFieldIndices.back()].values.size());
+    }
+
+    mParticleIndices.clear();
+    mParticleWriteBuffers.resize(mParticleLayout.size());
+
+    for(auto const & layout : mParticleLayout) {
+        mParticleIndices.push_back(migrateField(mWorld.particleAttributes, mWorld.particleCount, layout));
+    }
+    resizeParticles();
+
+    std::vector<std::string> names;
+    mStatisticsGauges.clear();
+    for(auto const & layout : mLayout)
+    {
+        names.push_back(layout.name);
+
+        auto & telemetry = getTelemetry();
+        std::string const prefix = "sim.field." + layout.name;
+        mStatisticsGauges.push_back({
+            telemetry.getGauge(prefix + ".min_micro"),
+            telemetry.getGauge(prefix + ".max_micro"),
+            telemetry.getGauge(prefix + ".mean_micro"),
+        });
+    }
+
+    mReducer.setFields(names);
+    mStatisticsValid = false;
+}
+
+void KernelHost::resizeParticles()
+{
+    for(size_t i = 0; i < mParticleIndices.size(); ++i)
+    {
+        auto & attribute = mWorld.particleAttributes[mParticleIndices[i]];
+        size_t const size = mWorld.particleCount * attribute.components;
+
+        // particles added by the world start with the default values
+        attribute.values.resize(size, mParticleLayout[i].defaultValue);
+        mParticleWriteBuffers[i].resize(size);
+    }
+}
+
+void KernelHost::tick(double const dt)
+{
+    if(mLibrary)
+    {
+        auto const version = mLibrary->getVersion();
+        if(version != mLibraryVersion) {
+            mLibraryVersion = version;
+            swapKernel((*mLibrary)());
+        }
+
+        // the kernel is from this version or a newer one, only the libraries
+        // it replaced are freed, a reload running meanwhile keeps its predecessor
+        mLibrary->update(mLibraryVersion);
+    }
+
+    if(mKernel == nullptr) {
+        return;
+    }
+
+    mBuffers.clear();
+    for(size_t i = 0; i < mFieldIndices.size(); ++i) {
+        auto & field = mWorld.fields[mFieldIndices[i]];
+        mBuffers.push_back({ field.values.data(), mWriteBuffers[i].data(), field.components });
+    }
+
+    // the world may have added or removed particles since the last tick
+    resizeParticles();
+
+    mParticleBuffers.clear();
+    for(size_t i = 0; i < mParticleIndices.size(); ++i) {
+        auto & attribute = mWorld.particleAttributes[mParticleIndices[i]];
+        mParticleBuffers.push_back({ attribute.values.data(), mParticleWriteBuffers[i].data(), attribute.components });
+    }
+
+    WssKernelContext context = {};
+    context.cellCount = mWorld.getCellCount();
+    context.adjacencyOffsets = mWorld.adjacencyOffsets.data();
+    context.adjacency = mWorld.adjacency.data();
+    context.fields = mBuffers.data();
+    context.fieldCount = static_cast<uint32_t>(mBuffers.size());
+    context.particleCount = mWorld.particleCount;
+    context.particleAttributes = mParticleBuffers.data();
+    context.particleAttributeCount = static_cast<uint32_t>(mParticleBuffers.size());
+    context.tick = mWorld.tick;
+    context.time = mWorld.time;
+    context.dt = dt;
+
+    size_t const computedCellCount = std::min(context.cellCount, mComputedCellCount);
+    if(mStatisticsEnabled) {
+        mReducer.begin(getParallelChunkCount(computedCellCount, minCellsPerChunk));
+    }
+
+    // kernels only write the cells of their range, so ranges run in parallel
+    parallelForChunks(computedCellCount, minCellsPerChunk, [&](size_t const chunk, size_t const begin, size_t const end) {
+        if(!mStatisticsEnabled) {
+            mKernel->step(&context, begin, end);
+            return;
+        }
+
+        for(size_t blockBegin = begin; blockBegin < end; blockBegin += cellsPerReductionBlock)
+        {
+            size_t const blockEnd = std::min(end, blockBegin + cellsPerReductionBlock);
+            mKernel->step(&context, blockBegin, blockEnd);
+
+            for(size_t i = 0; i < mBuffers.size(); ++i) {
+                size_t const components = mBuffers[i].components;
+                mReducer.reduce(chunk, i, { mBuffers[i].write, computedCellCount * components }, components, blockBegin, blockEnd);
+            }
+        }
+    });
+
+    // the particles read the fields of the last tick, like the cells
+    bool const stepParticles = mKernel->stepParticles != nullptr && context.particleCount > 0;
+    if(stepParticles) {
+        parallelForChunks(context.particleCount, minParticlesPerChunk, [&](size_t, size_t const begin, size_t const end) {
+            mKernel->stepParticles(&context, begin, end);
+        });
+    }
+
+    if(mStatisticsEnabled)
+    {
+        mReducer.end();
+        mStatisticsValid = true;
+
+        auto const statistics = mReducer.getStatistics();
+        for(size_t i = 0; i < statistics.size(); ++i)
+        {
+            auto const & summary = statistics[i].summary;
+            if(summary.count > 0) {
+                mStatisticsGauges[i][0].set(static_cast<int64_t>(std::llround(summary.min * 1e6)));
+                mStatisticsGauges[i][1].set(static_cast<int64_t>(std::llround(summary.max * 1e6)));
+                mStatisticsGauges[i][2].set(static_cast<int64_t>(std::llround(summary.getMean() * 1e6)));
+            }
+        }
+    }
+
+    // the written state becomes the state of the world
+    for(size_t i = 0; i < mFieldIndices.size(); ++i) {
+        mWorld.fields[mFieldIndices[i]].values.swap(mWriteBuffers[i]);
+    }
+    if(stepParticles) {
+        for(size_t i = 0; i < mParticleIndices.size(); ++i) {
+            mWorld.particleAttributes[mParticleIndices[i]].values.swap(mParticleWriteBuffers[i]);
+        }
+    }
+
+    mWorld.tick++;
+    mWorld.time += dt;
+
+    mTickCounter.add();
+    mWorkingSetGauge.set(static_cast<int64_t>(getWorkingSetSize()));
+}
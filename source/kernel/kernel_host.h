@@ -0,0 +1,111 @@
+//
+// @file:   kernel_host.h
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Runs a simulation kernel on the fields of a world
+//
+
+#pragma once
+
+#include "kernel_abi.h"
+#include "world/world.h"
+#include "dll/dll_function_hotswap.h"
+#include "telemetry/telemetry.h"
+#include "reduction/field_reduction.h"
+
+#include <array>
+#include <memory>
+
+
+//
+// @class:  KernelHost
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Owns the write buffers of the fields, the read buffers are the
+//          fields of the world. A kernel loaded from a library is swapped at
+//          the start of a tick, the fields are migrated if its layout changed.
+//          A migration may add fields to the world, so references to its
+//          fields and views of it are fetched again after every tick. The
+//          attributes of the particles are migrated the same way and follow
+//          the particle count of the world.
+//          The cells of a tick are split into ranges that run on all cores.
+//          With statistics enabled every range reduces the first component of
+//          the fields it just wrote, no extra pass over the fields is needed.
+//
+class KernelHost
+{
+public:
+    explicit KernelHost(World & world);
+
+    // built in kernel, replaces a watched library
+    void setKernel(WssKernel const * const kernel);
+
+    // loads wssGetKernel from the library and reloads it whenever it changes
+    void watchKernel(std::string const & filename);
+
+    // only the first cells are stepped, the rest are read only like the halo of a domain
+    void setComputedCellCount(size_t const count);
+
+    // advances the world by one tick
+    void tick(double const dt);
+
+    WssKernel const * getKernel() const;
+
+    // number of kernels used so far
+    uint64_t getKernelChanges() const;
+
+    // bytes of all fields and particle attributes, read and write buffers
+    size_t getWorkingSetSize() const;
+
+    // statistics of the kernel fields, fused into the tick and exported as telemetry gauges
+    void setStatisticsEnabled(bool const enabled);
+
+    // of the last tick, empty before the first tick with statistics
+    std::span<FieldStatistics const> getStatistics() const;
+    FieldStatistics const * findStatistics(std::string_view const name) const;
+
+private:
+    struct FieldLayout {
+        std::string name;
+        uint32_t components;
+        float defaultValue;
+    };
+
+    World & mWorld;
+
+    WssKernel const * mKernel = nullptr;
+    std::vector<FieldLayout> mLayout;
+    std::vector<FieldLayout> mParticleLayout;
+    uint64_t mKernelChanges = 0;
+    size_t mComputedCellCount = SIZE_MAX;
+
+    std::unique_ptr<DllFunctionHotswap<WssKernel const *()>> mLibrary;
+    uint64_t mLibraryVersion = 0;
+
+    // write buffer and world field index of every kernel field
+    std::vector<std::vector<float>> mWriteBuffers;
+    std::vector<size_t> mFieldIndices;
+    std::vector<WssFieldBuffer> mBuffers;
+
+    // the same for every particle attribute of the kernel
+    std::vector<std::vector<float>> mParticleWriteBuffers;
+    std::vector<size_t> mParticleIndices;
+    std::vector<WssFieldBuffer> mParticleBuffers;
+
+    TelemetryGauge mWorkingSetGauge;
+    TelemetryCounter mTickCounter;
+
+    bool mStatisticsEnabled = false;
+    bool mStatisticsValid = false;
+    FieldReducer mReducer;
+
+    // min, max and mean of every field in millionths
+    std::vector<std::array<TelemetryGauge, 3>> mStatisticsGauges;
+
+    void swapKernel(WssKernel const * const kernel);
+    void migrate();
+    void resizeParticles();
+
+    // index of the values named like layout in fields, added or converted to its component count
+    static size_t migrateField(std::vector<WorldField> & fields, size_t const count, FieldLayout const & layout);
+};
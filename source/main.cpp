@@ -10,28 +10,51 @@
 #include "vulkan_particle_engine/object/simple_object/hello_triangle.h"
 #include "sphere/sphere_shader_object.h"
 #include "geometry/cube.h"
-#include "geometry/sphere.h"
-
+#include "geometry/static_meshes.h"
+#include "recording/sim_recorder.h"
+#include "recording/sim_replay.h"
+#include "kernel/kernel_host.h"
+#include "colormap/colormap.h"
+#include "raster/software_rasterizer.h"
+#include "batch/batch_runner.h"
+#include "telemetry/telemetry_writer.h"
+#include "tasks/task_graph.h"
+
+#include <charconv>
 #include <iostream>
-#include <glm/gtx/color_space.hpp>
+#include <limits>
+#include <memory>
+#include <string_view>
+#include <vector>
 
 using namespace std;
 
 
+// the whole argument as a number of at least minimum, no sign for unsigned types and nothing after it
+template<typename T>
+bool parseNumber(std::string_view const text, T & value, T const minimum = 0)
+{
+    T parsed = 0;
+    auto const [end, error] = std::from_chars(text.data(), text.data() + text.size(), parsed);
+    if(error != std::errc() || end != text.data() + text.size() || parsed < minimum) {
+        return false;
+    }
+
+    value = parsed;
+    return true;
+}
+
+
 std::vector<glm::vec3> rainbow(size_t const size)
 {
+    Colormap const colormap(ColormapType::eRainbow);
+
     std::vector<glm::vec3> data;
     data.reserve(size);
 
-    float hue = 0.0f;
-    float sat = 1.0f;
-    float value = 1.0f;
     for(size_t i = 0; i < size; ++i)
     {
-        auto const color = glm::rgbColor(glm::vec3(hue, sat, value));
-        hue += 360.0f / size;
-
-        data.push_back(color);
+        data.push_back(colormap.map(static_cast<float>(i) / size));
     }
 
     return data;
@@ -56,6 +79,57 @@ public:
         return mShaderObject;
     }
 
+    size_t getCellCount() const {
+        return cube_colors2.size();
+    }
+
+    // shows the colors of a recording instead of the rainbow
+    void setReplay(SimReplay & replay)
+    {
+        mShaderObject.updateColorBuffer.set<&SimReplay::updateColorBuffer>(replay);
+    }
+
+    // shows a field of the world instead of the rainbow, the range comes from the statistics of the host
+    void setField(World const & world, std::string const & name, KernelHost & host)
+    {
+        mWorld = &world;
+        mHost = &host;
+        mFieldName = name;
+        host.setStatisticsEnabled(true);
+        mColormap.setAutomaticRange(true);
+        mShaderObject.updateColorBuffer.set<&Cube::updateFieldColors>(*this);
+    }
+
+    // records the colors of the field once per tick of the world, see setField
+    void setRecorder(SimRecorder & recorder)
+    {
+        mRecorder = &recorder;
+    }
+
+    void updateFieldColors(std::span<SphereShaderObject::ColorBufferElement> data)
+    {
+        auto const view = mWorld->getView();
+        auto const field = view.findField(mFieldName);
+        if(field == nullptr) {
+            return;
+        }
+
+        assert(data.size() * field->components == field->values.size());
+        if(auto const * statistics = mHost->findStatistics(mFieldName)) {
+            mColormap.setRange(getColorRange(statistics->summary));
+        }
+        else {
+            mColormap.setAutomaticRange(true);
+        }
+        mColormap.apply(field->values, data, field->components);
+
+        // a frame without a tick shows the same colors
+        if(mRecorder != nullptr && mWorld->tick != mRecordedTick) {
+            mRecorder->record(mWorld->tick, data);
+            mRecordedTick = mWorld->tick;
+        }
+    }
+
     void initVertexData(std::span<SphereShaderObject::VertexBufferElement> data)
     {
         assert(data.size() == cube_vertices.size());
@@ -92,7 +166,7 @@ private:
     std::vector<AdvancedShader::VertexBufferElement> const vertexData;
 
     // std::array<glm::vec3, 36> const cube_vertices = createCubeTriangles();
-    std::vector<glm::vec3> const cube_vertices = createSphereTriangles(createSphereVertices(2.0f, 100));
+    std::span<glm::vec3 const> const cube_vertices = getStaticSphereTriangles();
 
     std::vector<glm::vec3> const cube_colors2 = rainbow(cube_vertices.size() / 6);
 
@@ -110,6 +184,14 @@ private:
 
     glm::vec3 mPos;
 
+    World const * mWorld = nullptr;
+    KernelHost const * mHost = nullptr;
+    std::string mFieldName;
+    Colormap mColormap = Colormap(ColormapType::eViridis);
+
+    SimRecorder * mRecorder = nullptr;
+    uint64_t mRecordedTick = std::numeric_limits<uint64_t>::max();
+
     glm::mat4 const & mView;
     glm::mat4 const & mProj;
 
@@ -117,38 +199,234 @@ private:
 };
 
 
-int main()
+int main(int const argc, char const * argv[])
 {
     cout << "#######------- World Sphere Sim -------#######" << endl;
 
+    std::string replayFile;
+    std::string recordFile;
+    std::string kernelFile;
+    std::string renderFile;
+    std::string telemetryFile;
+    int telemetryInterval = 1000;
+
+    bool batch = false;
+    BatchSettings batchSettings;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        std::string const arg = argv[i];
+        bool const hasValue = i + 1 < argc;
+        bool valid = true;
+        if(arg == "--replay" && hasValue) {
+            replayFile = argv[++i];
+        }
+        else if(arg == "--record" && hasValue) {
+            recordFile = argv[++i];
+        }
+        else if(arg == "--kernel" && hasValue) {
+            kernelFile = argv[++i];
+        }
+        else if(arg == "--render" && hasValue) {
+            renderFile = argv[++i];
+        }
+        else if(arg == "--telemetry" && hasValue) {
+            telemetryFile = argv[++i];
+        }
+        else if(arg == "--telemetry-interval" && hasValue) {
+            valid = parseNumber(argv[++i], telemetryInterval, 1);
+        }
+        else if(arg == "--batch" && hasValue) {
+            batch = true;
+            valid = parseNumber(argv[++i], batchSettings.ticks);
+        }
+        else if(arg == "--resolution" && hasValue) {
+            valid = parseNumber(argv[++i], batchSettings.resolution, size_t(1));
+        }
+        else if(arg == "--snapshot-every" && hasValue) {
+            valid = parseNumber(argv[++i], batchSettings.snapshotInterval);
+        }
+        else if(arg == "--snapshot-prefix" && hasValue) {
+            batchSettings.snapshotPrefix = argv[++i];
+        }
+        else if(arg == "--stats-every" && hasValue) {
+            valid = parseNumber(argv[++i], batchSettings.statisticsInterval);
+        }
+        else if(arg == "--stats-file" && hasValue) {
+            batchSettings.statisticsFile = argv[++i];
+        }
+        else if(arg == "--image-every" && hasValue) {
+            valid = parseNumber(argv[++i], batchSettings.imageInterval);
+        }
+        else if(arg == "--image-prefix" && hasValue) {
+            batchSettings.imagePrefix = argv[++i];
+        }
+        else {
+            valid = false;
+        }
+
+        if(!valid)
+        {
+            if(i < argc && arg != argv[i]) {
+                cout << "invalid value " << argv[i] << " of " << arg << endl;
+            }
+            cout << "Usage: [--replay Recording] [--kernel KernelLibrary [--record Recording]] [--render Image.png|Image.ppm]" << endl;
+            cout << "       [--telemetry File.csv|File.json] [--telemetry-interval Milliseconds]" << endl;
+            cout << "       --batch Ticks [--kernel KernelLibrary] [--resolution N]" << endl;
+            cout << "               [--snapshot-every Ticks] [--snapshot-prefix Prefix]" << endl;
+            cout << "               [--stats-every Ticks] [--stats-file File.csv]" << endl;
+            cout << "               [--image-every Ticks] [--image-prefix Prefix] [--record Recording]" << endl;
+            cout << "  Numbers are decimal, the interval and the resolution at least 1." << endl;
+            cout << "  --record writes the colors of every tick for --replay, which needs a" << endl;
+            cout << "  recording of the window or of a batch run with --resolution 100." << endl;
+            return 1;
+        }
+    }
+
+    // counters, gauges and histograms of all subsystems, written until main returns
+    std::unique_ptr<TelemetryWriter> telemetryWriter;
+    if(!telemetryFile.empty())
+    {
+        telemetryWriter = std::make_unique<TelemetryWriter>(telemetryFile, std::chrono::milliseconds(telemetryInterval));
+        if(!telemetryWriter->opened()) {
+            cout << "failed to create " << telemetryFile << endl;
+            return 1;
+        }
+    }
+
+    // no window and no Vulkan device, the world is advanced on all cores
+    if(batch)
+    {
+        batchSettings.kernelFile = kernelFile;
+        batchSettings.recordFile = recordFile;
+
+        BatchRunner runner(batchSettings);
+        bool const success = runner.run();
+        runner.printReport(cout);
+        return success ? 0 : 1;
+    }
+
     glm::mat4 view = glm::mat4(1);
     glm::mat4 proj = glm::mat4(1);
 
     Cube cube = Cube({0.0f, 0.0f, 1.2f}, {0.4f, 0.7f, 0.1f}, view, proj);
 
-    SimpleShader shader;
-    HelloTriangle obj(shader);
+    SimReplay replay;
+    if(!replayFile.empty())
+    {
+        if(!replay.open(replayFile) || replay.getCellCount() != cube.getCellCount()) {
+            cout << "failed to open recording " << replayFile << endl;
+            return 1;
+        }
+        cube.setReplay(replay);
+    }
 
-    RenderEngine renderEngine;
-	renderEngine.add(obj);
-	renderEngine.add(cube.get());
+    // the kernel is reloaded whenever the library is rebuilt, the world keeps its state
+    World world = createSphereWorld(2.0f, 100);
+    KernelHost kernelHost(world);
+    if(!kernelFile.empty())
+    {
+        auto & temperature = world.addField("temperature");
+        for(size_t i = 0; i < temperature.values.size(); ++i) {
+            temperature.values[i] = (i / 100) % 20 < 10 ? 1.0f : 0.0f;
+        }
 
+        kernelHost.watchKernel(kernelFile);
+        cube.setField(world, "temperature", kernelHost);
+    }
 
     uint64_t count = 0;
-    auto lbdStartOfNextFrame = [&](){
+    auto const updateCamera = [&](float const aspect) {
         glm::vec3 posEye =  {0.0f, -8.0f, 0.0f};
         glm::vec3 posView = {0.0f, 0.0f, 0.0f};
 
         view = glm::lookAt(posEye, posView, glm::vec3(0.0f, 0.0f, 1.0f));
         view = glm::rotate(view, count++ * 0.0003f, {0.0f, 0.0f, 1.0f});
-        proj = glm::perspective(glm::radians(45.0f), 
-            static_cast<float>(renderEngine.getSwapChainExtent().width) / static_cast<float>(renderEngine.getSwapChainExtent().height), 
-            0.1f, 100'000.0f);
+        proj = glm::perspective(glm::radians(45.0f), aspect, 0.1f, 100'000.0f);
         proj[1][1] *= -1; // invert Y for Vulkan
     };
 
+    // one frame drawn on the CPU, for machines without a GPU
+    if(!renderFile.empty())
+    {
+        SoftwareRasterizer rasterizer(1920, 1080);
+        updateCamera(static_cast<float>(rasterizer.getWidth()) / static_cast<float>(rasterizer.getHeight()));
+
+        rasterizer.clear();
+        rasterizer.draw(cube.get());
+        if(!writeImage(renderFile, rasterizer.getImage())) {
+            cout << "failed to write " << renderFile << endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    // the colors of the field, only a simulation has ticks to record
+    std::unique_ptr<SimRecorder> recorder;
+    if(!recordFile.empty())
+    {
+        if(kernelFile.empty()) {
+            cout << "--record needs --kernel" << endl;
+            return 1;
+        }
+
+        try {
+            recorder = std::make_unique<SimRecorder>(recordFile, cube.getCellCount());
+        }
+        catch(std::exception const & error) {
+            cout << error.what() << endl;
+            return 1;
+        }
+        cube.setRecorder(*recorder);
+    }
+
+    SimpleShader shader;
+    HelloTriangle obj(shader);
+
+    RenderEngine renderEngine;
+	renderEngine.add(obj);
+	renderEngine.add(cube.get());
+
+
+    // camera, simulation and replay touch different data, they run in parallel. The buffers of the
+    // sphere are filled from them as tasks of their own, its draw only copies them into the mapped memory
+    float aspect = 1.0f;
+    TaskGraph frameTasks;
+    std::vector<TaskGraph::TaskId> frameInputs;
+    frameInputs.push_back(frameTasks.add([&]() { updateCamera(aspect); }));
+
+    if(!kernelFile.empty()) {
+        frameInputs.push_back(frameTasks.add([&]() { kernelHost.tick(0.1); }));
+    }
+
+    // play the recording in a loop
+    if(!replayFile.empty()) {
+        frameInputs.push_back(frameTasks.add([&]() {
+            if(!replay.next()) {
+                replay.seek(replay.getFirstTick());
+            }
+        }));
+    }
+
+    cube.get().addUpdateTasks(frameTasks, frameInputs);
+
+    auto lbdStartOfNextFrame = [&](){
+        aspect = static_cast<float>(renderEngine.getSwapChainExtent().width) / static_cast<float>(renderEngine.getSwapChainExtent().height);
+        frameTasks.run();
+    };
+
     renderEngine.startOfNextFrame.add(lbdStartOfNextFrame);
     renderEngine.run();
 
+    auto const arenaStatistics = cube.get().getFrameArenaStatistics();
+    cout << "frame arena: " << arenaStatistics.allocations << " allocations, "
+         << arenaStatistics.getAllocationsAvoided() << " avoided, "
+         << arenaStatistics.peakBytes << " bytes peak" << endl;
+
+    if(recorder && !recorder->close()) {
+        cout << "failed to write recording " << recordFile << endl;
+        return 1;
+    }
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,60 @@
+//
+// @file:   frame_arena.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Per frame linear allocator, one arena for each swapchain image
+//
+
+#include "frame_arena.h"
+
+#include <cassert>
+
+
+FrameArena::FrameArena(size_t const frameCount, size_t const blockSize)
+    : mBlockSize(blockSize)
+{
+    resize(frameCount);
+}
+
+void FrameArena::resize(size_t const frameCount)
+{
+    assert(frameCount > 0);
+
+    mArenas.clear();
+    for(size_t i = 0; i < frameCount; ++i) {
+        mArenas.push_back(std::make_unique<MonotonicArena>(mBlockSize));
+    }
+
+    mCurrent = 0;
+}
+
+void FrameArena::beginFrame(size_t const imageIndex)
+{
+    mCurrent = imageIndex % mArenas.size();
+    mArenas[mCurrent]->reset();
+}
+
+std::pmr::memory_resource& FrameArena::get()
+{
+    return *mArenas[mCurrent];
+}
+
+std::pmr::memory_resource& FrameArena::get(size_t const imageIndex)
+{
+    return *mArenas[imageIndex % mArenas.size()];
+}
+
+size_t FrameArena::size() const
+{
+    return mArenas.size();
+}
+
+ArenaStatistics FrameArena::getStatistics() const
+{
+    ArenaStatistics res;
+    for(auto const & arena : mArenas) {
+        res += arena->getStatistics();
+    }
+
+    return res;
+}
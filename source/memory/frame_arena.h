@@ -0,0 +1,46 @@
+//
+// @file:   frame_arena.h
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Per frame linear allocator, one arena for each swapchain image
+//
+
+#pragma once
+
+#include "monotonic_arena.h"
+
+#include <memory>
+
+
+//
+// @class:  FrameArena
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Keeps one MonotonicArena per swapchain image. beginFrame() resets
+//          only the arena of the given image, so temporaries of the frames
+//          still in flight stay valid until their image comes around again.
+//
+class FrameArena
+{
+public:
+    explicit FrameArena(size_t const frameCount = 3, size_t const blockSize = MonotonicArena::defaultBlockSize);
+
+    // changes the number of buffered frames, releases all memory
+    void resize(size_t const frameCount);
+
+    void beginFrame(size_t const imageIndex);
+
+    std::pmr::memory_resource& get();
+    std::pmr::memory_resource& get(size_t const imageIndex);
+
+    size_t size() const;
+
+    // statistics summed over all frames, the peak is the highest of a single frame
+    ArenaStatistics getStatistics() const;
+
+private:
+    size_t const mBlockSize;
+    size_t mCurrent = 0;
+
+    std::vector<std::unique_ptr<MonotonicArena>> mArenas;
+};
@@ -0,0 +1,121 @@
+//
+// @file:   monotonic_arena.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Bump allocator with reusable blocks, usable through std::pmr
+//
+
+#include "monotonic_arena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+
+ArenaStatistics& ArenaStatistics::operator+=(ArenaStatistics const & other)
+{
+    allocations += other.allocations;
+    upstreamAllocations += other.upstreamAllocations;
+    usedBytes += other.usedBytes;
+    peakBytes = std::max(peakBytes, other.peakBytes);
+    capacityBytes += other.capacityBytes;
+
+    return *this;
+}
+
+
+MonotonicArena::MonotonicArena(size_t const blockSize, std::pmr::memory_resource * const upstream)
+    : mBlockSize(blockSize),
+      mUpstream(upstream)
+{
+
+}
+
+MonotonicArena::~MonotonicArena()
+{
+    release();
+}
+
+void MonotonicArena::reset()
+{
+    mCurrentBlock = 0;
+    mOffset = 0;
+    mStatistics.usedBytes = 0;
+}
+
+void MonotonicArena::release()
+{
+    for(auto const & block : mBlocks) {
+        mUpstream->deallocate(block.data, block.size, alignof(std::max_align_t));
+    }
+
+    mBlocks.clear();
+    mStatistics.capacityBytes = 0;
+    reset();
+}
+
+ArenaStatistics const & MonotonicArena::getStatistics() const
+{
+    return mStatistics;
+}
+
+void* MonotonicArena::allocateFromBlock(Block const & block, size_t const bytes, size_t const alignment)
+{
+    auto const base = reinterpret_cast<std::uintptr_t>(block.data);
+    auto const aligned = (base + mOffset + alignment - 1) & ~(std::uintptr_t(alignment) - 1);
+    size_t const end = (aligned - base) + bytes;
+
+    if(end > block.size) {
+        return nullptr;
+    }
+
+    mStatistics.usedBytes += end - mOffset;
+    mStatistics.peakBytes = std::max(mStatistics.peakBytes, mStatistics.usedBytes);
+    mOffset = end;
+
+    return reinterpret_cast<void*>(aligned);
+}
+
+void* MonotonicArena::do_allocate(size_t bytes, size_t alignment)
+{
+    mStatistics.allocations++;
+
+    // try the current block
+    if(mCurrentBlock < mBlocks.size()) {
+        if(auto p = allocateFromBlock(mBlocks[mCurrentBlock], bytes, alignment)) {
+            return p;
+        }
+    }
+
+    // try the blocks kept from before the last reset
+    for(size_t i = mCurrentBlock + 1; i < mBlocks.size(); ++i) {
+        mCurrentBlock = i;
+        mOffset = 0;
+        if(auto p = allocateFromBlock(mBlocks[i], bytes, alignment)) {
+            return p;
+        }
+    }
+
+    // get a new block, big requests get a block of their own size
+    Block block;
+    block.size = std::max(mBlockSize, bytes + alignment);
+    block.data = static_cast<std::byte*>(mUpstream->allocate(block.size, alignof(std::max_align_t)));
+
+    mStatistics.upstreamAllocations++;
+    mStatistics.capacityBytes += block.size;
+
+    mBlocks.push_back(block);
+    mCurrentBlock = mBlocks.size() - 1;
+    mOffset = 0;
+
+    return allocateFromBlock(mBlocks.back(), bytes, alignment);
+}
+
+void MonotonicArena::do_deallocate(void*, size_t, size_t)
+{
+    // memory is given back with reset()
+}
+
+bool MonotonicArena::do_is_equal(std::pmr::memory_resource const & other) const noexcept
+{
+    return this == &other;
+}
@@ -0,0 +1,83 @@
+//
+// @file:   monotonic_arena.h
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Bump allocator with reusable blocks, usable through std::pmr
+//
+
+#pragma once
+
+#include <memory_resource>
+#include <vector>
+#include <cstddef>
+
+
+//
+// @struct: ArenaStatistics
+// @brief:  Counters collected by an arena
+//
+struct ArenaStatistics
+{
+    size_t allocations = 0;             // requests served by the arena
+    size_t upstreamAllocations = 0;     // blocks requested from the upstream resource
+    size_t usedBytes = 0;               // bytes handed out since the last reset
+    size_t peakBytes = 0;               // highest usedBytes ever reached, of any one arena when combined
+    size_t capacityBytes = 0;           // bytes owned by the arena
+
+    size_t getAllocationsAvoided() const {
+        return allocations > upstreamAllocations ? allocations - upstreamAllocations : 0;
+    }
+
+    ArenaStatistics& operator+=(ArenaStatistics const & other);
+};
+
+
+//
+// @class:  MonotonicArena
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Hands out memory by bumping a pointer, deallocate is a no-op.
+//          reset() rewinds the arena but keeps the blocks, so a warmed up
+//          arena never touches the upstream resource again.
+//
+class MonotonicArena : public std::pmr::memory_resource
+{
+public:
+    static constexpr size_t defaultBlockSize = 64 * 1024;
+
+    explicit MonotonicArena(size_t const blockSize = defaultBlockSize,
+        std::pmr::memory_resource * const upstream = std::pmr::new_delete_resource());
+    ~MonotonicArena();
+
+    MonotonicArena(MonotonicArena const &) = delete;
+    MonotonicArena& operator=(MonotonicArena const &) = delete;
+
+    // rewinds the arena, all memory handed out becomes invalid
+    void reset();
+
+    // rewinds the arena and returns all blocks to the upstream resource
+    void release();
+
+    ArenaStatistics const & getStatistics() const;
+
+private:
+    struct Block {
+        std::byte * data = nullptr;
+        size_t size = 0;
+    };
+
+    size_t const mBlockSize;
+    std::pmr::memory_resource * const mUpstream;
+
+    std::vector<Block> mBlocks;
+    size_t mCurrentBlock = 0;
+    size_t mOffset = 0;
+
+    ArenaStatistics mStatistics;
+
+    void* do_allocate(size_t bytes, size_t alignment) final;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) final;
+    bool do_is_equal(std::pmr::memory_resource const & other) const noexcept final;
+
+    void* allocateFromBlock(Block const & block, size_t const bytes, size_t const alignment);
+};
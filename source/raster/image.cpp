@@ -0,0 +1,186 @@
+//
+// @file:   image.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  RGBA8 image and writers for PPM and PNG files
+//
+
+#include "image.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <fstream>
+
+
+namespace {
+
+std::array<uint32_t, 256> createCrcTable()
+{
+    std::array<uint32_t, 256> table;
+    for(uint32_t i = 0; i < 256; ++i)
+    {
+        uint32_t c = i;
+        for(int k = 0; k < 8; ++k) {
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        }
+        table[i] = c;
+    }
+    return table;
+}
+
+uint32_t crc32(uint8_t const * data, size_t const size, uint32_t crc = 0)
+{
+    static std::array<uint32_t, 256> const table = createCrcTable();
+
+    crc = ~crc;
+    for(size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+void appendBigEndian(std::vector<uint8_t> & out, uint32_t const value)
+{
+    out.push_back(static_cast<uint8_t>(value >> 24));
+    out.push_back(static_cast<uint8_t>(value >> 16));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+void appendChunk(std::vector<uint8_t> & out, char const (&type)[5], std::vector<uint8_t> const & data)
+{
+    appendBigEndian(out, static_cast<uint32_t>(data.size()));
+
+    size_t const start = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data.begin(), data.end());
+
+    appendBigEndian(out, crc32(out.data() + start, out.size() - start));
+}
+
+std::vector<uint8_t> getRgbRows(Image const & image, bool const filterBytes)
+{
+    std::vector<uint8_t> rows;
+    rows.reserve(size_t(image.height) * (size_t(image.width) * 3 + 1));
+
+    for(uint32_t y = 0; y < image.height; ++y)
+    {
+        if(filterBytes) {
+            rows.push_back(0);
+        }
+        for(uint32_t x = 0; x < image.width; ++x)
+        {
+            uint32_t const color = image.at(x, y);
+            rows.push_back(static_cast<uint8_t>(color));
+            rows.push_back(static_cast<uint8_t>(color >> 8));
+            rows.push_back(static_cast<uint8_t>(color >> 16));
+        }
+    }
+
+    return rows;
+}
+
+bool writeFile(std::string const & filename, std::vector<uint8_t> const & data)
+{
+    std::ofstream file(filename, std::ios::binary);
+    file.write(reinterpret_cast<char const *>(data.data()), static_cast<std::streamsize>(data.size()));
+    return file.good();
+}
+
+}
+
+
+Image::Image(uint32_t const width, uint32_t const height, uint32_t const color)
+    : width(width), height(height), pixels(size_t(width) * height, color)
+{
+
+}
+
+bool writePPM(std::string const & filename, Image const & image)
+{
+    std::string const header = "P6\n" + std::to_string(image.width) + " " + std::to_string(image.height) + "\n255\n";
+
+    std::vector<uint8_t> data(header.begin(), header.end());
+    auto const rows = getRgbRows(image, false);
+    data.insert(data.end(), rows.begin(), rows.end());
+
+    return writeFile(filename, data);
+}
+
+bool writePNG(std::string const & filename, Image const & image)
+{
+    static constexpr uint8_t signature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+    std::vector<uint8_t> data(std::begin(signature), std::end(signature));
+
+    std::vector<uint8_t> header;
+    appendBigEndian(header, image.width);
+    appendBigEndian(header, image.height);
+    header.push_back(8);        // bit depth
+    header.push_back(2);        // RGB
+    header.push_back(0);        // deflate
+    header.push_back(0);        // adaptive filters
+    header.push_back(0);        // no interlace
+    appendChunk(data, "IHDR", header);
+
+    // zlib stream of stored deflate blocks
+    auto const rows = getRgbRows(image, true);
+
+    std::vector<uint8_t> zlib;
+    zlib.reserve(rows.size() + rows.size() / 65535 * 5 + 16);
+    zlib.push_back(0x78);
+    zlib.push_back(0x01);
+
+    size_t offset = 0;
+    do
+    {
+        size_t const size = std::min<size_t>(rows.size() - offset, 65535);
+        bool const last = offset + size == rows.size();
+
+        zlib.push_back(last ? 1 : 0);
+        zlib.push_back(static_cast<uint8_t>(size));
+        zlib.push_back(static_cast<uint8_t>(size >> 8));
+        zlib.push_back(static_cast<uint8_t>(~size));
+        zlib.push_back(static_cast<uint8_t>(~size >> 8));
+        zlib.insert(zlib.end(), rows.begin() + offset, rows.begin() + offset + size);
+
+        offset += size;
+    }
+    while(offset < rows.size());
+
+    // adler32, in blocks small enough that the sums do not overflow
+    uint32_t a = 1;
+    uint32_t b = 0;
+    for(size_t i = 0; i < rows.size(); )
+    {
+        size_t const end = std::min(rows.size(), i + 5552);
+        for(; i < end; ++i) {
+            a += rows[i];
+            b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+    }
+    appendBigEndian(zlib, (b << 16) | a);
+
+    appendChunk(data, "IDAT", zlib);
+    appendChunk(data, "IEND", {});
+
+    return writeFile(filename, data);
+}
+
+bool writeImage(std::string const & filename, Image const & image)
+{
+    auto const endsWith = [&](std::string const & extension) {
+        return filename.size() >= extension.size()
+            && std::equal(extension.rbegin(), extension.rend(), filename.rbegin(),
+                [](char const a, char const b) { return a == std::tolower(static_cast<unsigned char>(b)); });
+    };
+
+    if(endsWith(".png")) {
+        return writePNG(filename, image);
+    }
+
+    return writePPM(filename, image);
+}
@@ -0,0 +1,43 @@
+//
+// @file:   image.h
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  RGBA8 image and writers for PPM and PNG files
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+struct Image
+{
+    uint32_t width = 0;
+    uint32_t height = 0;
+
+    // row major, top row first, packed by packColor
+    std::vector<uint32_t> pixels;
+
+    Image() = default;
+    Image(uint32_t const width, uint32_t const height, uint32_t const color = 0);
+
+    uint32_t & at(uint32_t const x, uint32_t const y) { return pixels[size_t(y) * width + x]; }
+    uint32_t at(uint32_t const x, uint32_t const y) const { return pixels[size_t(y) * width + x]; }
+};
+
+// r in the lowest byte, alpha in the highest
+inline uint32_t packColor(uint8_t const r, uint8_t const g, uint8_t const b, uint8_t const a = 255)
+{
+    return uint32_t(r) | (uint32_t(g) << 8) | (uint32_t(b) << 16) | (uint32_t(a) << 24);
+}
+
+// binary P6, alpha is dropped
+bool writePPM(std::string const & filename, Image const & image);
+
+// 8 bit RGB, stored without compression so no zlib is needed
+bool writePNG(std::string const & filename, Image const & image);
+
+// picks the format from the extension, .png or .ppm
+bool writeImage(std::string const & filename, Image const & image);
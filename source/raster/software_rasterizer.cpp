@@ -0,0 +1,441 @@
+//
+// @file:   software_rasterizer.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Draws the buffers of a SphereShaderObject on the CPU
+//
+
+#include "software_rasterizer.h"
+#include "tasks/parallel_for.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+
+namespace {
+
+// triangles per chunk of the setup, small meshes stay on one thread
+constexpr size_t minTrianglesPerChunk = 16 * 1024;
+
+// vertices are clipped against x and y only if they leave this range of
+// normalized device coordinates, which keeps the fixed point math in 64 bit
+constexpr float guardBand = 8.0f;
+
+struct ClipVertex {
+    glm::vec4 position;
+    glm::vec3 color;
+};
+
+uint8_t toByte(float const value)
+{
+    float const clamped = value > 0.0f ? (value < 1.0f ? value : 1.0f) : 0.0f;
+    return static_cast<uint8_t>(clamped * 255.0f + 0.5f);
+}
+
+uint32_t toColor(glm::vec3 const & color)
+{
+    return packColor(toByte(color.r), toByte(color.g), toByte(color.b));
+}
+
+float getChannel(uint32_t const color, int const channel)
+{
+    return static_cast<float>((color >> (channel * 8)) & 0xFF);
+}
+
+// distance to the clip planes, the vertex is inside if it is >= 0
+float getDistance(glm::vec4 const & v, int const plane)
+{
+    switch(plane)
+    {
+        case 0: return v.z;                         // near, Vulkan depth starts at 0
+        case 1: return guardBand * v.w - v.x;
+        case 2: return guardBand * v.w + v.x;
+        case 3: return guardBand * v.w - v.y;
+        default: return guardBand * v.w + v.y;
+    }
+}
+
+// Sutherland Hodgman against one plane, returns the new vertex count
+size_t clipPolygon(ClipVertex const * in, size_t const count, ClipVertex * out, int const plane)
+{
+    size_t outCount = 0;
+    for(size_t i = 0; i < count; ++i)
+    {
+        auto const & a = in[i];
+        auto const & b = in[(i + 1) % count];
+        float const da = getDistance(a.position, plane);
+        float const db = getDistance(b.position, plane);
+
+        if(da >= 0.0f) {
+            out[outCount++] = a;
+        }
+        if((da >= 0.0f) != (db >= 0.0f))
+        {
+            float const t = da / (da - db);
+            out[outCount].position = a.position + (b.position - a.position) * t;
+            out[outCount].color = a.color + (b.color - a.color) * t;
+            outCount++;
+        }
+    }
+    return outCount;
+}
+
+}
+
+
+SoftwareRasterizer::SoftwareRasterizer(uint32_t const width, uint32_t const height, uint32_t const tileSize)
+    : mTileSize(std::max<uint32_t>(tileSize, 8)),
+      mTilesX((width + mTileSize - 1) / mTileSize),
+      mTilesY((height + mTileSize - 1) / mTileSize),
+      mClearColor(packColor(0, 0, 0)),
+      mImage(width, height),
+      mDepth(size_t(width) * height, 1.0f)
+{
+
+}
+
+void SoftwareRasterizer::setClearColor(glm::vec3 const & color)
+{
+    mClearColor = toColor(color);
+}
+
+void SoftwareRasterizer::clear()
+{
+    std::fill(mImage.pixels.begin(), mImage.pixels.end(), mClearColor);
+    std::fill(mDepth.begin(), mDepth.end(), 1.0f);
+}
+
+Image const & SoftwareRasterizer::getImage() const
+{
+    return mImage;
+}
+
+uint32_t SoftwareRasterizer::getWidth() const
+{
+    return mImage.width;
+}
+
+uint32_t SoftwareRasterizer::getHeight() const
+{
+    return mImage.height;
+}
+
+void SoftwareRasterizer::draw(SphereShaderObject & object)
+{
+    // the init delegates run once, like for the first frame of every swapchain image
+    if(mObject != &object || mVertices.size() != object.getVertexBufferSize() || mColors.size() != object.getColorBufferSize())
+    {
+        mObject = &object;
+        mVertices.assign(object.getVertexBufferSize(), {});
+        mColors.assign(object.getColorBufferSize(), {});
+        mUniforms.assign(1, {});
+
+        if(object.initVertexBuffer) {
+            object.initVertexBuffer(mVertices);
+        }
+        if(object.initColorBuffer) {
+            object.initColorBuffer(mColors);
+        }
+    }
+
+    if(object.updateVertexBuffer) {
+        object.updateVertexBuffer(mVertices);
+    }
+    if(object.updateColorBuffer) {
+        object.updateColorBuffer(mColors);
+    }
+    if(object.updateUniformBuffer) {
+        object.updateUniformBuffer(mUniforms);
+    }
+
+    draw(mVertices, mColors, mUniforms[0]);
+}
+
+void SoftwareRasterizer::draw(std::span<VertexBufferElement const> const vertices,
+    std::span<ColorBufferElement const> const colors,
+    UnformBuffer const & uniforms)
+{
+    size_t const triangleCount = vertices.size() / 3;
+    size_t const threads = getThreadPool().getThreadCount();
+    size_t const chunks = std::clamp<size_t>(triangleCount / minTrianglesPerChunk, 1, threads);
+    size_t const chunkSize = (triangleCount + chunks - 1) / chunks;
+
+    glm::mat4 const transform = uniforms.proj * uniforms.view * uniforms.model;
+
+    // bins keep their memory from frame to frame
+    if(mBins.size() < chunks) {
+        mBins.resize(chunks);
+    }
+    for(auto & bin : mBins)
+    {
+        bin.triangles.clear();
+        bin.tiles.resize(size_t(mTilesX) * mTilesY);
+        for(auto & tile : bin.tiles) {
+            tile.clear();
+        }
+    }
+
+    // one chunk of triangles per thread, so every bin has a single writer
+    parallelFor(chunks, 1, [&](size_t const begin, size_t const end) {
+        for(size_t chunk = begin; chunk < end; ++chunk) {
+            size_t const first = std::min(triangleCount, chunk * chunkSize);
+            size_t const last = std::min(triangleCount, first + chunkSize);
+            setupTriangles(mBins[chunk], vertices, colors, transform, first, last);
+        }
+    });
+
+    // tiles differ a lot in cost, so threads take the next free one
+    std::atomic<uint32_t> nextTile = 0;
+    uint32_t const tileCount = mTilesX * mTilesY;
+    parallelFor(std::min<size_t>(threads, tileCount), 1, [&](size_t const begin, size_t const end) {
+        for(size_t worker = begin; worker < end; ++worker) {
+            for(uint32_t tile = nextTile++; tile < tileCount; tile = nextTile++) {
+                drawTile(tile);
+            }
+        }
+    });
+}
+
+void SoftwareRasterizer::setupTriangles(Bin & bin, std::span<VertexBufferElement const> const vertices,
+    std::span<ColorBufferElement const> const colors, glm::mat4 const & transform,
+    size_t const begin, size_t const end) const
+{
+    for(size_t triangle = begin; triangle < end; ++triangle)
+    {
+        glm::vec4 clip[3];
+        glm::vec3 color[3];
+        for(size_t k = 0; k < 3; ++k)
+        {
+            size_t const index = triangle * 3 + k;
+            clip[k] = transform * glm::vec4(vertices[index].pos, 1.0f);
+
+            // same lookup as the vertex shader
+            size_t const colorIndex = index / 6;
+            if(colorIndex < colors.size()) {
+                color[k] = glm::vec3(colors[colorIndex].r, colors[colorIndex].g, colors[colorIndex].b);
+            }
+            else {
+                color[k] = glm::vec3(0.0f, 0.0f, 0.0f);
+            }
+        }
+
+        // all vertices outside of the same plane of the view volume
+        bool outside = false;
+        bool needsClipping = false;
+        for(int axis = 0; axis < 3 && !outside; ++axis)
+        {
+            int below = 0;
+            int above = 0;
+            for(auto const & v : clip) {
+                float const lower = axis == 2 ? 0.0f : -v.w;
+                below += v[axis] < lower;
+                above += v[axis] > v.w;
+            }
+            outside = below == 3 || above == 3;
+        }
+        if(outside) {
+            continue;
+        }
+
+        for(int plane = 0; plane < 5; ++plane) {
+            for(auto const & v : clip) {
+                needsClipping = needsClipping || getDistance(v, plane) < 0.0f;
+            }
+        }
+
+        if(!needsClipping)
+        {
+            addTriangle(bin, clip, color);
+            continue;
+        }
+
+        // every plane adds at most one vertex
+        ClipVertex polygon[2][8];
+        size_t count = 3;
+        for(size_t k = 0; k < 3; ++k) {
+            polygon[0][k] = { clip[k], color[k] };
+        }
+
+        int current = 0;
+        for(int plane = 0; plane < 5 && count >= 3; ++plane) {
+            count = clipPolygon(polygon[current], count, polygon[1 - current], plane);
+            current = 1 - current;
+        }
+
+        for(size_t k = 2; k < count; ++k)
+        {
+            glm::vec4 const fanClip[3] = { polygon[current][0].position, polygon[current][k - 1].position, polygon[current][k].position };
+            glm::vec3 const fanColor[3] = { polygon[current][0].color, polygon[current][k - 1].color, polygon[current][k].color };
+            addTriangle(bin, fanClip, fanColor);
+        }
+    }
+}
+
+void SoftwareRasterizer::addTriangle(Bin & bin, glm::vec4 const (&clip)[3], glm::vec3 const (&color)[3]) const
+{
+    Triangle t;
+    t.padding = 0;
+
+    float const width = static_cast<float>(mImage.width);
+    float const height = static_cast<float>(mImage.height);
+
+    for(int k = 0; k < 3; ++k)
+    {
+        float const invW = 1.0f / clip[k].w;
+        float const x = (clip[k].x * invW * 0.5f + 0.5f) * width;
+        float const y = (clip[k].y * invW * 0.5f + 0.5f) * height;
+
+        t.x[k] = static_cast<int32_t>(std::lround(x * subPixelSize));
+        t.y[k] = static_cast<int32_t>(std::lround(y * subPixelSize));
+        t.z[k] = clip[k].z * invW;
+        t.invW[k] = invW;
+        t.color[k] = toColor(color[k]);
+    }
+
+    int64_t const area = int64_t(t.x[1] - t.x[0]) * (t.y[2] - t.y[0]) - int64_t(t.y[1] - t.y[0]) * (t.x[2] - t.x[0]);
+    if(area == 0) {
+        return;
+    }
+
+    // no culling, both windings are drawn with a positive area
+    if(area < 0)
+    {
+        std::swap(t.x[1], t.x[2]);
+        std::swap(t.y[1], t.y[2]);
+        std::swap(t.z[1], t.z[2]);
+        std::swap(t.invW[1], t.invW[2]);
+        std::swap(t.color[1], t.color[2]);
+    }
+
+    // pixels whose centers lie in the bounding box
+    int32_t const half = subPixelSize / 2;
+    int32_t const minX = std::max<int32_t>(0, (std::min({ t.x[0], t.x[1], t.x[2] }) - half + subPixelSize - 1) >> subPixelBits);
+    int32_t const minY = std::max<int32_t>(0, (std::min({ t.y[0], t.y[1], t.y[2] }) - half + subPixelSize - 1) >> subPixelBits);
+    int32_t const maxX = std::min<int32_t>(mImage.width - 1, (std::max({ t.x[0], t.x[1], t.x[2] }) - half) >> subPixelBits);
+    int32_t const maxY = std::min<int32_t>(mImage.height - 1, (std::max({ t.y[0], t.y[1], t.y[2] }) - half) >> subPixelBits);
+
+    // small triangles often cover no pixel center at all
+    if(minX > maxX || minY > maxY) {
+        return;
+    }
+
+    uint32_t const index = static_cast<uint32_t>(bin.triangles.size());
+    bin.triangles.push_back(t);
+
+    for(uint32_t ty = minY / mTileSize; ty <= maxY / mTileSize; ++ty) {
+        for(uint32_t tx = minX / mTileSize; tx <= maxX / mTileSize; ++tx) {
+            bin.tiles[size_t(ty) * mTilesX + tx].push_back(index);
+        }
+    }
+}
+
+void SoftwareRasterizer::drawTile(uint32_t const tile)
+{
+    int32_t const tileX = static_cast<int32_t>((tile % mTilesX) * mTileSize);
+    int32_t const tileY = static_cast<int32_t>((tile / mTilesX) * mTileSize);
+    int32_t const tileMaxX = std::min<int32_t>(tileX + mTileSize, mImage.width) - 1;
+    int32_t const tileMaxY = std::min<int32_t>(tileY + mTileSize, mImage.height) - 1;
+
+    int32_t const half = subPixelSize / 2;
+    size_t const width = mImage.width;
+
+    // bins in order, so triangles are drawn in the order of the vertex buffer
+    for(auto const & bin : mBins)
+    {
+        for(uint32_t const index : bin.tiles[tile])
+        {
+            Triangle const & t = bin.triangles[index];
+
+            int32_t const minX = std::max(tileX, (std::min({ t.x[0], t.x[1], t.x[2] }) - half + subPixelSize - 1) >> subPixelBits);
+            int32_t const minY = std::max(tileY, (std::min({ t.y[0], t.y[1], t.y[2] }) - half + subPixelSize - 1) >> subPixelBits);
+            int32_t const maxX = std::min(tileMaxX, (std::max({ t.x[0], t.x[1], t.x[2] }) - half) >> subPixelBits);
+            int32_t const maxY = std::min(tileMaxY, (std::max({ t.y[0], t.y[1], t.y[2] }) - half) >> subPixelBits);
+
+            if(minX > maxX || minY > maxY) {
+                continue;
+            }
+
+            // edge k is opposite of vertex k, its value is the barycentric weight of vertex k times the area
+            int64_t const px = int64_t(minX) * subPixelSize + half;
+            int64_t const py = int64_t(minY) * subPixelSize + half;
+
+            int64_t rowEdge[3];
+            int64_t stepX[3];
+            int64_t stepY[3];
+            for(int k = 0; k < 3; ++k)
+            {
+                int const a = (k + 1) % 3;
+                int const b = (k + 2) % 3;
+                int64_t const dx = t.x[b] - t.x[a];
+                int64_t const dy = t.y[b] - t.y[a];
+
+                // top left rule, pixels on other edges belong to the neighbour
+                bool const topLeft = (dy == 0 && dx > 0) || dy < 0;
+
+                rowEdge[k] = dx * (py - t.y[a]) - dy * (px - t.x[a]) - (topLeft ? 0 : 1);
+                stepX[k] = -dy * subPixelSize;
+                stepY[k] = dx * subPixelSize;
+            }
+
+            int64_t const area = int64_t(t.x[1] - t.x[0]) * (t.y[2] - t.y[0]) - int64_t(t.y[1] - t.y[0]) * (t.x[2] - t.x[0]);
+            float const invArea = 1.0f / static_cast<float>(area);
+
+            // depth is linear in screen space
+            float const dz1 = (t.z[1] - t.z[0]) * invArea;
+            float const dz2 = (t.z[2] - t.z[0]) * invArea;
+            float const zStepX = dz1 * stepX[1] + dz2 * stepX[2];
+            float const zStepY = dz1 * stepY[1] + dz2 * stepY[2];
+            float rowZ = t.z[0] + dz1 * rowEdge[1] + dz2 * rowEdge[2];
+
+            bool const flat = t.color[0] == t.color[1] && t.color[0] == t.color[2];
+
+            for(int32_t y = minY; y <= maxY; ++y)
+            {
+                int64_t e0 = rowEdge[0];
+                int64_t e1 = rowEdge[1];
+                int64_t e2 = rowEdge[2];
+                float z = rowZ;
+
+                uint32_t * pixels = mImage.pixels.data() + y * width;
+                float * depth = mDepth.data() + y * width;
+
+                for(int32_t x = minX; x <= maxX; ++x)
+                {
+                    if((e0 | e1 | e2) >= 0 && z < depth[x] && z <= 1.0f)
+                    {
+                        depth[x] = z;
+
+                        if(flat) {
+                            pixels[x] = t.color[0];
+                        }
+                        else {
+                            // perspective correct, like the interpolation of fragColor
+                            float const w0 = static_cast<float>(e0) * t.invW[0];
+                            float const w1 = static_cast<float>(e1) * t.invW[1];
+                            float const w2 = static_cast<float>(e2) * t.invW[2];
+                            float const invSum = 1.0f / (w0 + w1 + w2);
+
+                            uint8_t channels[3];
+                            for(int c = 0; c < 3; ++c) {
+                                float const value = (w0 * getChannel(t.color[0], c) + w1 * getChannel(t.color[1], c) + w2 * getChannel(t.color[2], c)) * invSum;
+                                channels[c] = static_cast<uint8_t>(std::clamp(value + 0.5f, 0.0f, 255.0f));
+                            }
+                            pixels[x] = packColor(channels[0], channels[1], channels[2]);
+                        }
+                    }
+
+                    e0 += stepX[0];
+                    e1 += stepX[1];
+                    e2 += stepX[2];
+                    z += zStepX;
+                }
+
+                rowEdge[0] += stepY[0];
+                rowEdge[1] += stepY[1];
+                rowEdge[2] += stepY[2];
+                rowZ += zStepY;
+            }
+        }
+    }
+}
@@ -0,0 +1,98 @@
+//
+// @file:   software_rasterizer.h
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Draws the buffers of a SphereShaderObject on the CPU
+//
+
+#pragma once
+
+#include "image.h"
+#include "sphere/sphere_shader_object.h"
+
+#include <span>
+#include <vector>
+
+
+//
+// @class:  SoftwareRasterizer
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Headless replacement for the sphere pipeline, used where no GPU
+//          exists. Vertices are a triangle list, vertex i takes the color
+//          colors[i / 6] like the vertex shader does. Triangles are set up
+//          and sorted into screen tiles on all cores, then every tile is
+//          filled by one thread with a depth test, so no pixel is shared.
+//          Clipping follows Vulkan: depth 0 to 1, y pointing down.
+//
+class SoftwareRasterizer
+{
+public:
+    using VertexBufferElement = SphereShaderObject::VertexBufferElement;
+    using ColorBufferElement = SphereShaderObject::ColorBufferElement;
+    using UnformBuffer = SphereShaderObject::UnformBuffer;
+
+    SoftwareRasterizer(uint32_t const width, uint32_t const height, uint32_t const tileSize = 64);
+
+    void setClearColor(glm::vec3 const & color);
+
+    // clears the image and the depth buffer
+    void clear();
+
+    void draw(std::span<VertexBufferElement const> const vertices,
+        std::span<ColorBufferElement const> const colors,
+        UnformBuffer const & uniforms);
+
+    // fills the buffers through the init and update delegates of the object, then draws them
+    void draw(SphereShaderObject & object);
+
+    Image const & getImage() const;
+
+    uint32_t getWidth() const;
+    uint32_t getHeight() const;
+
+private:
+    // 8 sub pixel bits
+    static constexpr int32_t subPixelBits = 8;
+    static constexpr int32_t subPixelSize = 1 << subPixelBits;
+
+    // screen space triangle, 64 bytes
+    struct Triangle {
+        int32_t x[3];                   // fixed point
+        int32_t y[3];
+        float z[3];                     // depth
+        float invW[3];                  // for perspective correct colors
+        uint32_t color[3];              // packed
+        uint32_t padding;
+    };
+
+    // triangles of one chunk of the vertex buffer and their tile lists
+    struct Bin {
+        std::vector<Triangle> triangles;
+        std::vector<std::vector<uint32_t>> tiles;
+    };
+
+    uint32_t const mTileSize;
+    uint32_t const mTilesX;
+    uint32_t const mTilesY;
+
+    uint32_t mClearColor;
+
+    Image mImage;
+    std::vector<float> mDepth;
+    std::vector<Bin> mBins;
+
+    // buffers filled by the delegates of mObject
+    SphereShaderObject const * mObject = nullptr;
+    std::vector<VertexBufferElement> mVertices;
+    std::vector<ColorBufferElement> mColors;
+    std::vector<UnformBuffer> mUniforms;
+
+    void setupTriangles(Bin & bin, std::span<VertexBufferElement const> const vertices,
+        std::span<ColorBufferElement const> const colors, glm::mat4 const & transform,
+        size_t const begin, size_t const end) const;
+
+    void addTriangle(Bin & bin, glm::vec4 const (&clip)[3], glm::vec3 const (&color)[3]) const;
+
+    void drawTile(uint32_t const tile);
+};
@@ -0,0 +1,716 @@
+//
+// @file:   triangle_bvh.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Bounding volume hierarchy over mesh triangles for picking and line of sight
+//
+
+#include "triangle_bvh.h"
+#include "tasks/parallel_for.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <numeric>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+namespace {
+
+constexpr size_t binCount = 16;
+constexpr float traversalCost = 1.0f;           // relative to a triangle test
+
+// the traversal stack has maxDepth entries, below medianDepth the nodes are split
+// at the median, so even a degenerated mesh stays within it
+constexpr size_t maxDepth = 64;
+constexpr size_t medianDepth = 32;
+
+constexpr uint32_t noNode = std::numeric_limits<uint32_t>::max();
+constexpr size_t minPacketsPerChunk = 64;
+
+struct Bounds
+{
+    glm::vec3 min = glm::vec3(std::numeric_limits<float>::infinity());
+    glm::vec3 max = glm::vec3(-std::numeric_limits<float>::infinity());
+
+    void add(glm::vec3 const & point) {
+        min = glm::min(min, point);
+        max = glm::max(max, point);
+    }
+
+    void add(Bounds const & other) {
+        min = glm::min(min, other.min);
+        max = glm::max(max, other.max);
+    }
+
+    float getArea() const {
+        glm::vec3 const size = max - min;
+        if(!(size.x >= 0.0f)) {
+            return 0.0f;
+        }
+        return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+    }
+};
+
+// huge instead of infinite for axis parallel rays, so an origin on a slab gives 0 instead of 0 * inf
+float getInverse(float const value)
+{
+    return 1.0f / (std::abs(value) > 1e-30f ? value : std::copysign(1e-30f, value));
+}
+
+bool hitsBox(glm::vec3 const & min, glm::vec3 const & max, glm::vec3 const & origin, glm::vec3 const & inverse,
+    float const maxDistance)
+{
+    float entry = 0.0f;
+    float exit = maxDistance;
+    for(int axis = 0; axis < 3; ++axis)
+    {
+        float const t0 = (min[axis] - origin[axis]) * inverse[axis];
+        float const t1 = (max[axis] - origin[axis]) * inverse[axis];
+        entry = std::max(entry, std::min(t0, t1));
+        exit = std::min(exit, std::max(t0, t1));
+    }
+    return entry <= exit;
+}
+
+}
+
+
+Ray createPickingRay(glm::vec2 const & ndc, glm::mat4 const & viewProjection)
+{
+    glm::mat4 const inverse = glm::inverse(viewProjection);
+    glm::vec4 const nearPoint = inverse * glm::vec4(ndc.x, ndc.y, 0.0f, 1.0f);
+    glm::vec4 const farPoint = inverse * glm::vec4(ndc.x, ndc.y, 1.0f, 1.0f);
+
+    // distance 1 is the far plane
+    Ray ray;
+    ray.origin = glm::vec3(nearPoint) / nearPoint.w;
+    ray.direction = glm::vec3(farPoint) / farPoint.w - ray.origin;
+    ray.maxDistance = 1.0f;
+    return ray;
+}
+
+
+TriangleBvh::TriangleBvh(std::span<glm::vec3 const> const vertices, std::span<uint32_t const> const indices)
+{
+    build(vertices, indices);
+}
+
+TriangleBvh::TriangleBvh(std::span<glm::vec3 const> const triangles)
+{
+    build(triangles);
+}
+
+void TriangleBvh::build(std::span<glm::vec3 const> const vertices, std::span<uint32_t const> const indices)
+{
+    buildTree(vertices, std::vector<uint32_t>(indices.begin(), indices.begin() + indices.size() / 3 * 3));
+}
+
+void TriangleBvh::build(std::span<glm::vec3 const> const triangles)
+{
+    std::vector<uint32_t> indices(triangles.size() / 3 * 3);
+    std::iota(indices.begin(), indices.end(), 0);
+    buildTree(triangles, std::move(indices));
+}
+
+void TriangleBvh::buildTree(std::span<glm::vec3 const> const vertices, std::vector<uint32_t> indices)
+{
+    size_t const triangleCount = indices.size() / 3;
+
+    mNodes.clear();
+    mParents.clear();
+    mIndices = std::move(indices);
+    mTriangles.resize(triangleCount);
+    mTriangleIds.resize(triangleCount);
+    mLeafOfTriangle.assign(triangleCount, noNode);
+
+    if(triangleCount == 0) {
+        return;
+    }
+
+    // in mesh order first, the bounds of the edge form so the boxes hold what the intersection sees
+    std::vector<Bounds> bounds(triangleCount);
+    std::vector<glm::vec3> centers(triangleCount);
+    for(size_t triangle = 0; triangle < triangleCount; ++triangle)
+    {
+        setTriangle(triangle, vertices);
+        auto const & data = mTriangles[triangle];
+        bounds[triangle].add(data.v0);
+        bounds[triangle].add(data.v0 + data.e1);
+        bounds[triangle].add(data.v0 + data.e2);
+        centers[triangle] = (bounds[triangle].min + bounds[triangle].max) * 0.5f;
+    }
+
+    std::vector<uint32_t> order(triangleCount);
+    std::iota(order.begin(), order.end(), 0);
+
+    mNodes.reserve(triangleCount * 2);
+    mParents.reserve(triangleCount * 2);
+
+    struct Range {
+        uint32_t parent;
+        uint32_t begin;
+        uint32_t end;
+        uint32_t depth;
+        bool second;
+    };
+
+    // the first child is built right away, the second once the subtree of the first is done
+    std::vector<Range> pending;
+    pending.push_back({ noNode, 0, static_cast<uint32_t>(triangleCount), 0, false });
+
+    while(!pending.empty())
+    {
+        Range range = pending.back();
+        pending.pop_back();
+
+        while(true)
+        {
+            uint32_t const node = static_cast<uint32_t>(mNodes.size());
+            mNodes.push_back({});
+            mParents.push_back(range.parent);
+            if(range.second) {
+                mNodes[range.parent].offset = node;
+            }
+
+            Bounds box;
+            Bounds centerBox;
+            for(uint32_t i = range.begin; i < range.end; ++i) {
+                box.add(bounds[order[i]]);
+                centerBox.add(centers[order[i]]);
+            }
+
+            size_t const count = range.end - range.begin;
+            glm::vec3 const extent = centerBox.max - centerBox.min;
+
+            // binned surface area heuristic, cost of a split relative to the triangle tests of a leaf
+            float bestCost = std::numeric_limits<float>::infinity();
+            int bestAxis = -1;
+            size_t bestBin = 0;
+            if(count > 1 && range.depth < medianDepth)
+            {
+                float const area = std::max(box.getArea(), std::numeric_limits<float>::min());
+                for(int axis = 0; axis < 3; ++axis)
+                {
+                    if(!(extent[axis] > 0.0f)) {
+                        continue;
+                    }
+
+                    float const scale = static_cast<float>(binCount) / extent[axis];
+                    std::array<Bounds, binCount> binBounds;
+                    std::array<size_t, binCount> binCounts = {};
+                    for(uint32_t i = range.begin; i < range.end; ++i)
+                    {
+                        size_t const bin = std::min(binCount - 1,
+                            static_cast<size_t>((centers[order[i]][axis] - centerBox.min[axis]) * scale));
+                        binBounds[bin].add(bounds[order[i]]);
+                        ++binCounts[bin];
+                    }
+
+                    // area times count of everything right of a split
+                    std::array<float, binCount> rightCosts = {};
+                    Bounds right;
+                    size_t rightCount = 0;
+                    for(size_t bin = binCount - 1; bin > 0; --bin) {
+                        right.add(binBounds[bin]);
+                        rightCount += binCounts[bin];
+                        rightCosts[bin - 1] = right.getArea() * static_cast<float>(rightCount);
+                    }
+
+                    Bounds left;
+                    size_t leftCount = 0;
+                    for(size_t bin = 0; bin + 1 < binCount; ++bin)
+                    {
+                        left.add(binBounds[bin]);
+                        leftCount += binCounts[bin];
+                        if(leftCount == 0 || leftCount == count) {
+                            continue;
+                        }
+
+                        float const cost = traversalCost + (left.getArea() * static_cast<float>(leftCount) + rightCosts[bin]) / area;
+                        if(cost < bestCost) {
+                            bestCost = cost;
+                            bestAxis = axis;
+                            bestBin = bin;
+                        }
+                    }
+                }
+            }
+
+            auto & current = mNodes[node];
+            current.min = box.min;
+            current.max = box.max;
+
+            if(count == 1 || (count <= maxLeafSize && !(bestCost < static_cast<float>(count))))
+            {
+                current.offset = range.begin;
+                current.count = static_cast<uint16_t>(count);
+                current.axis = 0;
+                for(uint32_t i = range.begin; i < range.end; ++i) {
+                    mLeafOfTriangle[order[i]] = node;
+                }
+                break;
+            }
+
+            uint32_t middle = range.begin;
+            if(bestAxis >= 0)
+            {
+                float const scale = static_cast<float>(binCount) / extent[bestAxis];
+                auto const split = std::partition(order.begin() + range.begin, order.begin() + range.end,
+                    [&](uint32_t const triangle) {
+                        return std::min(binCount - 1, static_cast<size_t>((centers[triangle][bestAxis] - centerBox.min[bestAxis]) * scale)) <= bestBin;
+                    });
+                middle = static_cast<uint32_t>(split - order.begin());
+            }
+
+            // no useful split, or too deep, half of the triangles on each side of the median
+            if(middle == range.begin || middle == range.end)
+            {
+                bestAxis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+                middle = range.begin + static_cast<uint32_t>(count / 2);
+                std::nth_element(order.begin() + range.begin, order.begin() + middle, order.begin() + range.end,
+                    [&](uint32_t const a, uint32_t const b) {
+                        return centers[a][bestAxis] < centers[b][bestAxis];
+                    });
+            }
+
+            current.count = 0;
+            current.axis = static_cast<uint16_t>(bestAxis);
+
+            pending.push_back({ node, middle, range.end, range.depth + 1, true });
+            range = { node, range.begin, middle, range.depth + 1, false };
+        }
+    }
+
+    // triangles in leaf order, the leaves reference ranges of it
+    std::vector<Triangle> triangles(triangleCount);
+    std::vector<uint32_t> leafIndices(triangleCount * 3);
+    for(size_t slot = 0; slot < triangleCount; ++slot)
+    {
+        triangles[slot] = mTriangles[order[slot]];
+        std::copy_n(mIndices.begin() + order[slot] * 3, 3, leafIndices.begin() + slot * 3);
+    }
+    mTriangles = std::move(triangles);
+    mIndices = std::move(leafIndices);
+    mTriangleIds = std::move(order);
+}
+
+void TriangleBvh::setTriangle(size_t const slot, std::span<glm::vec3 const> const vertices)
+{
+    glm::vec3 const & a = vertices[mIndices[slot * 3]];
+    glm::vec3 const & b = vertices[mIndices[slot * 3 + 1]];
+    glm::vec3 const & c = vertices[mIndices[slot * 3 + 2]];
+    mTriangles[slot] = { a, b - a, c - a };
+}
+
+void TriangleBvh::refit(std::span<glm::vec3 const> const vertices)
+{
+    for(size_t slot = 0; slot < mTriangles.size(); ++slot) {
+        setTriangle(slot, vertices);
+    }
+
+    // children follow their parents, so backwards every node sees its final children
+    for(size_t node = mNodes.size(); node-- > 0; )
+    {
+        if(mNodes[node].count > 0) {
+            refitLeaf(static_cast<uint32_t>(node));
+        }
+        else {
+            refitInner(static_cast<uint32_t>(node));
+        }
+    }
+}
+
+void TriangleBvh::refit(std::span<glm::vec3 const> const vertices, std::span<uint32_t const> const triangles)
+{
+    std::vector<uint32_t> leaves;
+    leaves.reserve(triangles.size());
+    for(auto const triangle : triangles) {
+        leaves.push_back(mLeafOfTriangle[triangle]);
+    }
+    std::sort(leaves.begin(), leaves.end());
+    leaves.erase(std::unique(leaves.begin(), leaves.end()), leaves.end());
+
+    for(auto const leaf : leaves)
+    {
+        auto const & node = mNodes[leaf];
+        for(size_t slot = node.offset; slot < node.offset + node.count; ++slot) {
+            setTriangle(slot, vertices);
+        }
+
+        // the ancestors only change as long as the boxes below them change
+        bool changed = refitLeaf(leaf);
+        for(uint32_t parent = mParents[leaf]; changed && parent != noNode; parent = mParents[parent]) {
+            changed = refitInner(parent);
+        }
+    }
+}
+
+bool TriangleBvh::refitLeaf(uint32_t const node)
+{
+    auto & leaf = mNodes[node];
+
+    Bounds box;
+    for(size_t slot = leaf.offset; slot < leaf.offset + leaf.count; ++slot)
+    {
+        auto const & triangle = mTriangles[slot];
+        box.add(triangle.v0);
+        box.add(triangle.v0 + triangle.e1);
+        box.add(triangle.v0 + triangle.e2);
+    }
+
+    bool const changed = !(box.min == leaf.min) || !(box.max == leaf.max);
+    leaf.min = box.min;
+    leaf.max = box.max;
+    return changed;
+}
+
+bool TriangleBvh::refitInner(uint32_t const node)
+{
+    auto & inner = mNodes[node];
+    auto const & first = mNodes[node + 1];
+    auto const & second = mNodes[inner.offset];
+
+    glm::vec3 const min = glm::min(first.min, second.min);
+    glm::vec3 const max = glm::max(first.max, second.max);
+
+    bool const changed = !(min == inner.min) || !(max == inner.max);
+    inner.min = min;
+    inner.max = max;
+    return changed;
+}
+
+RayHit TriangleBvh::intersect(Ray const & ray) const
+{
+    RayHit hit;
+    if(mNodes.empty()) {
+        return hit;
+    }
+
+    glm::vec3 const inverse(getInverse(ray.direction.x), getInverse(ray.direction.y), getInverse(ray.direction.z));
+    float distance = ray.maxDistance;
+
+    std::array<uint32_t, maxDepth> stack;
+    size_t stackSize = 0;
+    uint32_t index = 0;
+
+    while(true)
+    {
+        auto const & node = mNodes[index];
+        if(hitsBox(node.min, node.max, ray.origin, inverse, distance))
+        {
+            if(node.count == 0)
+            {
+                bool const backwards = ray.direction[node.axis] < 0.0f;
+                stack[stackSize++] = backwards ? index + 1 : node.offset;
+                index = backwards ? node.offset : index + 1;
+                continue;
+            }
+
+            // Moeller Trumbore, both sides of a triangle count
+            for(size_t slot = node.offset; slot < node.offset + node.count; ++slot)
+            {
+                auto const & triangle = mTriangles[slot];
+                glm::vec3 const p = glm::cross(ray.direction, triangle.e2);
+                float const determinant = glm::dot(triangle.e1, p);
+                if(determinant == 0.0f) {
+                    continue;
+                }
+
+                float const inverseDeterminant = 1.0f / determinant;
+                glm::vec3 const s = ray.origin - triangle.v0;
+                float const u = glm::dot(s, p) * inverseDeterminant;
+                if(u < 0.0f || u > 1.0f) {
+                    continue;
+                }
+
+                glm::vec3 const q = glm::cross(s, triangle.e1);
+                float const v = glm::dot(ray.direction, q) * inverseDeterminant;
+                if(v < 0.0f || u + v > 1.0f) {
+                    continue;
+                }
+
+                float const t = glm::dot(triangle.e2, q) * inverseDeterminant;
+                if(t > 0.0f && t < distance)
+                {
+                    distance = t;
+                    hit.triangle = mTriangleIds[slot];
+                    hit.distance = t;
+                    hit.u = u;
+                    hit.v = v;
+                }
+            }
+        }
+
+        if(stackSize == 0) {
+            break;
+        }
+        index = stack[--stackSize];
+    }
+
+    return hit;
+}
+
+bool TriangleBvh::isOccluded(Ray const & ray) const
+{
+    if(mNodes.empty()) {
+        return false;
+    }
+
+    glm::vec3 const inverse(getInverse(ray.direction.x), getInverse(ray.direction.y), getInverse(ray.direction.z));
+
+    std::array<uint32_t, maxDepth> stack;
+    size_t stackSize = 0;
+    uint32_t index = 0;
+
+    while(true)
+    {
+        auto const & node = mNodes[index];
+        if(hitsBox(node.min, node.max, ray.origin, inverse, ray.maxDistance))
+        {
+            if(node.count == 0)
+            {
+                stack[stackSize++] = node.offset;
+                index = index + 1;
+                continue;
+            }
+
+            for(size_t slot = node.offset; slot < node.offset + node.count; ++slot)
+            {
+                auto const & triangle = mTriangles[slot];
+                glm::vec3 const p = glm::cross(ray.direction, triangle.e2);
+                float const determinant = glm::dot(triangle.e1, p);
+                if(determinant == 0.0f) {
+                    continue;
+                }
+
+                float const inverseDeterminant = 1.0f / determinant;
+                glm::vec3 const s = ray.origin - triangle.v0;
+                float const u = glm::dot(s, p) * inverseDeterminant;
+                glm::vec3 const q = glm::cross(s, triangle.e1);
+                float const v = glm::dot(ray.direction, q) * inverseDeterminant;
+                float const t = glm::dot(triangle.e2, q) * inverseDeterminant;
+                if(u >= 0.0f && v >= 0.0f && u + v <= 1.0f && t > 0.0f && t < ray.maxDistance) {
+                    return true;
+                }
+            }
+        }
+
+        if(stackSize == 0) {
+            return false;
+        }
+        index = stack[--stackSize];
+    }
+}
+
+bool TriangleBvh::isVisible(glm::vec3 const & from, glm::vec3 const & to) const
+{
+    // a little short of the target, so the surface the target lies on does not hide it
+    Ray ray;
+    ray.origin = from;
+    ray.direction = to - from;
+    ray.maxDistance = 1.0f - 1e-4f;
+    return !isOccluded(ray);
+}
+
+void TriangleBvh::intersect(std::span<Ray const> const rays, std::span<RayHit> const hits) const
+{
+    assert(hits.size() == rays.size());
+
+    size_t const packets = (rays.size() + 3) / 4;
+    parallelFor(packets, minPacketsPerChunk, [&](size_t const begin, size_t const end) {
+        for(size_t packet = begin; packet < end; ++packet)
+        {
+            size_t const first = packet * 4;
+            intersectPacket(rays.data() + first, hits.data() + first, std::min<size_t>(4, rays.size() - first));
+        }
+    });
+}
+
+#if defined(__SSE2__)
+
+// four rays at once, a node is entered if any of them hits its box
+void TriangleBvh::intersectPacket(Ray const * const rays, RayHit * const hits, size_t const count) const
+{
+    for(size_t lane = 0; lane < count; ++lane) {
+        hits[lane] = RayHit();
+    }
+    if(mNodes.empty()) {
+        return;
+    }
+
+    // unused lanes get a negative distance, they never hit anything
+    alignas(16) float values[10][4];
+    for(size_t lane = 0; lane < 4; ++lane)
+    {
+        Ray const ray = lane < count ? rays[lane] : Ray{ glm::vec3(0.0f), glm::vec3(1.0f), -1.0f };
+        for(int axis = 0; axis < 3; ++axis)
+        {
+            values[axis][lane] = ray.origin[axis];
+            values[3 + axis][lane] = ray.direction[axis];
+            values[6 + axis][lane] = getInverse(ray.direction[axis]);
+        }
+        values[9][lane] = ray.maxDistance;
+    }
+
+    __m128 const originX = _mm_load_ps(values[0]);
+    __m128 const originY = _mm_load_ps(values[1]);
+    __m128 const originZ = _mm_load_ps(values[2]);
+    __m128 const directionX = _mm_load_ps(values[3]);
+    __m128 const directionY = _mm_load_ps(values[4]);
+    __m128 const directionZ = _mm_load_ps(values[5]);
+    __m128 const inverseX = _mm_load_ps(values[6]);
+    __m128 const inverseY = _mm_load_ps(values[7]);
+    __m128 const inverseZ = _mm_load_ps(values[8]);
+    __m128 distance = _mm_load_ps(values[9]);
+
+    __m128 const zero = _mm_setzero_ps();
+    __m128 const one = _mm_set1_ps(1.0f);
+    __m128 hitU = zero;
+    __m128 hitV = zero;
+    std::array<uint32_t, 4> triangles;
+    triangles.fill(RayHit::noTriangle);
+
+    // the packet is ordered by its first ray
+    bool const backwards[3] = { rays[0].direction.x < 0.0f, rays[0].direction.y < 0.0f, rays[0].direction.z < 0.0f };
+
+    std::array<uint32_t, maxDepth> stack;
+    size_t stackSize = 0;
+    uint32_t index = 0;
+
+    while(true)
+    {
+        auto const & node = mNodes[index];
+
+        __m128 const x0 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.min.x), originX), inverseX);
+        __m128 const x1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.max.x), originX), inverseX);
+        __m128 const y0 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.min.y), originY), inverseY);
+        __m128 const y1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.max.y), originY), inverseY);
+        __m128 const z0 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.min.z), originZ), inverseZ);
+        __m128 const z1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.max.z), originZ), inverseZ);
+
+        __m128 const entry = _mm_max_ps(_mm_max_ps(_mm_min_ps(x0, x1), _mm_min_ps(y0, y1)), _mm_max_ps(_mm_min_ps(z0, z1), zero));
+        __m128 const exit = _mm_min_ps(_mm_min_ps(_mm_max_ps(x0, x1), _mm_max_ps(y0, y1)), _mm_min_ps(_mm_max_ps(z0, z1), distance));
+
+        if(_mm_movemask_ps(_mm_cmple_ps(entry, exit)) != 0)
+        {
+            if(node.count == 0)
+            {
+                bool const flip = backwards[node.axis];
+                stack[stackSize++] = flip ? index + 1 : node.offset;
+                index = flip ? node.offset : index + 1;
+                continue;
+            }
+
+            for(size_t slot = node.offset; slot < node.offset + node.count; ++slot)
+            {
+                auto const & triangle = mTriangles[slot];
+                __m128 const e1x = _mm_set1_ps(triangle.e1.x);
+                __m128 const e1y = _mm_set1_ps(triangle.e1.y);
+                __m128 const e1z = _mm_set1_ps(triangle.e1.z);
+                __m128 const e2x = _mm_set1_ps(triangle.e2.x);
+                __m128 const e2y = _mm_set1_ps(triangle.e2.y);
+                __m128 const e2z = _mm_set1_ps(triangle.e2.z);
+
+                // p = direction x e2
+                __m128 const px = _mm_sub_ps(_mm_mul_ps(directionY, e2z), _mm_mul_ps(directionZ, e2y));
+                __m128 const py = _mm_sub_ps(_mm_mul_ps(directionZ, e2x), _mm_mul_ps(directionX, e2z));
+                __m128 const pz = _mm_sub_ps(_mm_mul_ps(directionX, e2y), _mm_mul_ps(directionY, e2x));
+                __m128 const determinant = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+                __m128 const inverseDeterminant = _mm_div_ps(one, determinant);
+
+                __m128 const sx = _mm_sub_ps(originX, _mm_set1_ps(triangle.v0.x));
+                __m128 const sy = _mm_sub_ps(originY, _mm_set1_ps(triangle.v0.y));
+                __m128 const sz = _mm_sub_ps(originZ, _mm_set1_ps(triangle.v0.z));
+                __m128 const u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, px), _mm_mul_ps(sy, py)), _mm_mul_ps(sz, pz)), inverseDeterminant);
+
+                // q = s x e1
+                __m128 const qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+                __m128 const qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+                __m128 const qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+                __m128 const v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(directionX, qx), _mm_mul_ps(directionY, qy)), _mm_mul_ps(directionZ, qz)), inverseDeterminant);
+                __m128 const t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), inverseDeterminant);
+
+                __m128 const hit = _mm_and_ps(
+                    _mm_and_ps(_mm_and_ps(_mm_cmpneq_ps(determinant, zero), _mm_cmpge_ps(u, zero)),
+                        _mm_and_ps(_mm_cmpge_ps(v, zero), _mm_cmple_ps(_mm_add_ps(u, v), one))),
+                    _mm_and_ps(_mm_cmpgt_ps(t, zero), _mm_cmplt_ps(t, distance)));
+
+                int const mask = _mm_movemask_ps(hit);
+                if(mask == 0) {
+                    continue;
+                }
+
+                distance = _mm_or_ps(_mm_and_ps(hit, t), _mm_andnot_ps(hit, distance));
+                hitU = _mm_or_ps(_mm_and_ps(hit, u), _mm_andnot_ps(hit, hitU));
+                hitV = _mm_or_ps(_mm_and_ps(hit, v), _mm_andnot_ps(hit, hitV));
+                for(size_t lane = 0; lane < 4; ++lane) {
+                    if(mask & (1 << lane)) {
+                        triangles[lane] = mTriangleIds[slot];
+                    }
+                }
+            }
+        }
+
+        if(stackSize == 0) {
+            break;
+        }
+        index = stack[--stackSize];
+    }
+
+    alignas(16) float distances[4];
+    alignas(16) float us[4];
+    alignas(16) float vs[4];
+    _mm_store_ps(distances, distance);
+    _mm_store_ps(us, hitU);
+    _mm_store_ps(vs, hitV);
+
+    for(size_t lane = 0; lane < count; ++lane) {
+        if(triangles[lane] != RayHit::noTriangle) {
+            hits[lane].triangle = triangles[lane];
+            hits[lane].distance = distances[lane];
+            hits[lane].u = us[lane];
+            hits[lane].v = vs[lane];
+        }
+    }
+}
+
+#else
+
+void TriangleBvh::intersectPacket(Ray const * const rays, RayHit * const hits, size_t const count) const
+{
+    for(size_t lane = 0; lane < count; ++lane) {
+        hits[lane] = intersect(rays[lane]);
+    }
+}
+
+#endif
+
+float TriangleBvh::getCost() const
+{
+    if(mNodes.empty()) {
+        return 0.0f;
+    }
+
+    auto const getArea = [](Node const & node) {
+        Bounds box;
+        box.min = node.min;
+        box.max = node.max;
+        return box.getArea();
+    };
+
+    float const rootArea = getArea(mNodes.front());
+    if(!(rootArea > 0.0f)) {
+        return static_cast<float>(mTriangles.size());
+    }
+
+    float cost = 0.0f;
+    for(auto const & node : mNodes) {
+        cost += getArea(node) / rootArea * (node.count == 0 ? traversalCost : static_cast<float>(node.count));
+    }
+    return cost;
+}
@@ -0,0 +1,134 @@
+//
+// @file:   triangle_bvh.h
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Bounding volume hierarchy over mesh triangles for picking and line of sight
+//
+
+#pragma once
+
+#include "include_glm.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+
+struct Ray
+{
+    glm::vec3 origin = glm::vec3(0.0f);
+    glm::vec3 direction = glm::vec3(0.0f, 0.0f, 1.0f);     // distances are in units of its length
+    float maxDistance = std::numeric_limits<float>::infinity();
+};
+
+struct RayHit
+{
+    static constexpr uint32_t noTriangle = std::numeric_limits<uint32_t>::max();
+
+    uint32_t triangle = noTriangle;     // in the mesh the bvh was built from, the cell of a world is triangle / 2
+    float distance = std::numeric_limits<float>::infinity();
+    float u = 0.0f;                     // barycentric weights of the second and third vertex
+    float v = 0.0f;
+
+    bool hasHit() const {
+        return triangle != noTriangle;
+    }
+};
+
+// ray through a point in normalized device coordinates, in the space viewProjection maps from,
+// pass proj * view * model to pick in the space of the mesh. Starts at the near plane, depth 0 in Vulkan
+Ray createPickingRay(glm::vec2 const & ndc, glm::mat4 const & viewProjection);
+
+
+//
+// @class:  TriangleBvh
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Binned surface area heuristic build, the nodes are flattened in
+//          depth first order, 32 bytes each, so the first child follows its
+//          parent and only the second needs an index. Leaves hold up to
+//          maxLeafSize triangles, stored in leaf order as a vertex and two
+//          edges, ready for the intersection. Batches of rays are traversed
+//          in packets of 4 with SSE, on all cores. refit() moves the boxes
+//          with the vertices, e.g. after a terrain or LOD change, and keeps
+//          the tree; once getCost() grew far above its value after the
+//          build, a new build pays off.
+//
+class TriangleBvh
+{
+public:
+    static constexpr size_t maxLeafSize = 8;
+
+    TriangleBvh() = default;
+
+    // indexed mesh, 3 indices per triangle, like a World or a StaticMeshView
+    TriangleBvh(std::span<glm::vec3 const> const vertices, std::span<uint32_t const> const indices);
+
+    // triangle list, 3 vertices per triangle, like the vertex buffer of the SphereShaderObject
+    explicit TriangleBvh(std::span<glm::vec3 const> const triangles);
+
+    void build(std::span<glm::vec3 const> const vertices, std::span<uint32_t const> const indices);
+    void build(std::span<glm::vec3 const> const triangles);
+
+    // new positions of the vertices of the build, same count and same triangles
+    void refit(std::span<glm::vec3 const> const vertices);
+
+    // only the given triangles moved, updates the boxes on their way to the root
+    void refit(std::span<glm::vec3 const> const vertices, std::span<uint32_t const> const triangles);
+
+    // closest hit within maxDistance
+    RayHit intersect(Ray const & ray) const;
+
+    // any hit within maxDistance, stops at the first one
+    bool isOccluded(Ray const & ray) const;
+
+    // no triangle between the two points, the end points themselves do not count
+    bool isVisible(glm::vec3 const & from, glm::vec3 const & to) const;
+
+    // closest hit of every ray, hits has the size of rays
+    void intersect(std::span<Ray const> const rays, std::span<RayHit> const hits) const;
+
+    size_t getTriangleCount() const {
+        return mTriangles.size();
+    }
+
+    size_t getNodeCount() const {
+        return mNodes.size();
+    }
+
+    // expected cost of a ray relative to one triangle test
+    float getCost() const;
+
+private:
+    struct Node {
+        glm::vec3 min;
+        uint32_t offset;            // first triangle of a leaf, second child of an inner node
+        glm::vec3 max;
+        uint16_t count;             // triangles of a leaf, 0 for inner nodes
+        uint16_t axis;              // split axis of an inner node, the child on the near side is visited first
+    };
+
+    struct Triangle {
+        glm::vec3 v0;
+        glm::vec3 e1;
+        glm::vec3 e2;
+    };
+
+    std::vector<Node> mNodes;
+    std::vector<Triangle> mTriangles;           // leaf order
+    std::vector<uint32_t> mIndices;             // 3 vertices per triangle, leaf order
+    std::vector<uint32_t> mTriangleIds;         // mesh triangle of a leaf order triangle
+
+    // for the incremental refit
+    std::vector<uint32_t> mParents;
+    std::vector<uint32_t> mLeafOfTriangle;      // per mesh triangle
+
+    void buildTree(std::span<glm::vec3 const> const vertices, std::vector<uint32_t> indices);
+    void setTriangle(size_t const slot, std::span<glm::vec3 const> const vertices);
+    bool refitLeaf(uint32_t const node);
+    bool refitInner(uint32_t const node);
+
+    void intersectPacket(Ray const * const rays, RayHit * const hits, size_t const count) const;
+};
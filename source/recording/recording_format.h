@@ -0,0 +1,107 @@
+//
+// @file:   recording_format.h
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  File format of simulation recordings
+//
+
+#pragma once
+
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+
+
+//
+// File layout:
+//
+//   FileHeader
+//   ChunkHeader + lz4 payload      keyframe: all cells
+//   ChunkHeader + lz4 payload      delta: changed cell ids + their values
+//   ...
+//   ChunkHeader + IndexEntry[]     tick and offset of every keyframe
+//   Footer                         offset of the index chunk
+//
+// A recording that was not closed has no index, the reader then rebuilds it
+// by walking the chunk headers.
+//
+namespace recording
+{
+    constexpr std::array<char, 8> magic = { 'W', 'S', 'S', 'R', 'E', 'C', '\0', '\0' };
+    constexpr std::array<char, 8> footerMagic = { 'W', 'S', 'S', 'I', 'D', 'X', '\0', '\0' };
+    constexpr uint32_t version = 1;
+
+    enum class ChunkType : uint32_t {
+        eKeyframe = 1,
+        eDelta = 2,
+        eIndex = 3,
+    };
+
+    struct FileHeader {
+        std::array<char, 8> magic;
+        uint32_t version;
+        uint32_t keyframeInterval;
+        uint64_t cellCount;
+    };
+
+    struct ChunkHeader {
+        ChunkType type;
+        uint32_t changedCells;
+        uint64_t tick;
+        uint32_t rawSize;
+        uint32_t compressedSize;
+    };
+
+    struct IndexEntry {
+        uint64_t tick;
+        uint64_t offset;
+    };
+
+    struct Footer {
+        uint64_t indexOffset;
+        std::array<char, 8> magic;
+    };
+
+    static_assert(sizeof(FileHeader) == 24);
+    static_assert(sizeof(ChunkHeader) == 24);
+    static_assert(sizeof(Footer) == 16);
+
+    // colors are stored with 8 bit per channel
+    using QuantizedColor = std::array<uint8_t, 3>;
+
+    inline uint8_t quantize(float const value)
+    {
+        return static_cast<uint8_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+    }
+
+    inline float dequantize(uint8_t const value)
+    {
+        return value * (1.0f / 255.0f);
+    }
+
+    inline void writeVarint(std::vector<uint8_t> & out, uint32_t value)
+    {
+        while(value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    // returns false if the input ends in the middle of a value
+    inline bool readVarint(uint8_t const * & p, uint8_t const * const end, uint32_t & value)
+    {
+        value = 0;
+        for(int shift = 0; p < end && shift < 35; shift += 7) {
+            uint8_t const byte = *p++;
+            value |= static_cast<uint32_t>(byte & 0x7f) << shift;
+            if((byte & 0x80) == 0) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+}
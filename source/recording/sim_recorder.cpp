@@ -0,0 +1,227 @@
+//
+// @file:   sim_recorder.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Records the cell colors of every tick into a compressed file
+//
+
+#include "sim_recorder.h"
+
+#include <lz4.h>
+#include <stdexcept>
+
+using namespace recording;
+
+
+SimRecorder::SimRecorder(std::string const & filename, size_t const cellCount,
+    uint32_t const keyframeInterval, size_t const maxQueuedFrames)
+    : mCellCount(cellCount),
+      mKeyframeInterval(std::max<uint32_t>(keyframeInterval, 1)),
+      mMaxQueuedFrames(std::max<size_t>(maxQueuedFrames, 1))
+{
+    mFile.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    if(!mFile.is_open()) {
+        throw std::runtime_error("failed to create " + filename);
+    }
+
+    FileHeader header = {};
+    header.magic = magic;
+    header.version = version;
+    header.keyframeInterval = mKeyframeInterval;
+    header.cellCount = mCellCount;
+
+    if(!mFile.write(reinterpret_cast<char const *>(&header), sizeof(header))) {
+        throw std::runtime_error("failed to write " + filename);
+    }
+    mOffset = sizeof(header);
+
+    mThread = std::thread(&SimRecorder::run, this);
+}
+
+SimRecorder::~SimRecorder()
+{
+    close();
+}
+
+void SimRecorder::record(uint64_t const tick, std::span<ColorBufferElement const> const colors)
+{
+    assert(colors.size() == mCellCount);
+
+    Frame frame;
+    {
+        std::unique_lock lock(mMutex);
+        mCondition.wait(lock, [&](){ return mQueue.size() < mMaxQueuedFrames || mClosing; });
+        if(mClosing) {
+            return;
+        }
+
+        if(!mFreeFrames.empty()) {
+            frame = std::move(mFreeFrames.back());
+            mFreeFrames.pop_back();
+        }
+    }
+
+    frame.tick = tick;
+    frame.colors.resize(mCellCount);
+    for(size_t i = 0; i < mCellCount; ++i) {
+        frame.colors[i] = { quantize(colors[i].r), quantize(colors[i].g), quantize(colors[i].b) };
+    }
+
+    {
+        std::lock_guard lock(mMutex);
+        mQueue.push_back(std::move(frame));
+    }
+    mCondition.notify_all();
+}
+
+bool SimRecorder::close()
+{
+    // a second call waits for the first, mFailed is only read once the writer thread is joined
+    std::lock_guard closeLock(mCloseMutex);
+    if(mClosed) {
+        return !mFailed;
+    }
+
+    {
+        std::lock_guard lock(mMutex);
+        mClosing = true;
+    }
+    mCondition.notify_all();
+
+    if(mThread.joinable()) {
+        mThread.join();
+    }
+
+    // index chunk and footer
+    ChunkHeader header = {};
+    header.type = ChunkType::eIndex;
+    header.tick = mIndex.empty() ? 0 : mIndex.back().tick;
+    header.rawSize = static_cast<uint32_t>(mIndex.size() * sizeof(IndexEntry));
+
+    Footer footer = {};
+    footer.indexOffset = mOffset;
+    footer.magic = footerMagic;
+
+    // without the index and footer the replay rejects the file, a partial one is not worth finishing
+    if(!mFailed) {
+        mFailed = !writeChunk(header, { reinterpret_cast<uint8_t const *>(mIndex.data()), header.rawSize }, false)
+            || !mFile.write(reinterpret_cast<char const *>(&footer), sizeof(footer));
+        mOffset += sizeof(footer);
+    }
+
+    mFile.close();
+    mFailed = mFailed || mFile.fail();
+    mClosed = true;
+
+    return !mFailed;
+}
+
+uint64_t SimRecorder::getBytesWritten() const
+{
+    std::lock_guard lock(mMutex);
+    return mBytesWritten;
+}
+
+void SimRecorder::run()
+{
+    while(true)
+    {
+        Frame frame;
+        {
+            std::unique_lock lock(mMutex);
+            mCondition.wait(lock, [&](){ return !mQueue.empty() || mClosing; });
+            if(mQueue.empty()) {
+                return;
+            }
+
+            frame = std::move(mQueue.front());
+            mQueue.pop_front();
+        }
+        mCondition.notify_all();
+
+        // after a failure the frames are still taken, so record() does not block
+        if(!mFailed) {
+            mFailed = !writeFrame(frame);
+        }
+
+        {
+            std::lock_guard lock(mMutex);
+            mBytesWritten = mOffset;
+            mFreeFrames.push_back(std::move(frame));
+        }
+    }
+}
+
+bool SimRecorder::writeFrame(Frame & frame)
+{
+    bool const keyframe = mFrameCount++ % mKeyframeInterval == 0;
+
+    ChunkHeader header = {};
+    header.tick = frame.tick;
+    mRaw.clear();
+
+    if(keyframe)
+    {
+        header.type = ChunkType::eKeyframe;
+        header.changedCells = static_cast<uint32_t>(mCellCount);
+
+        auto const bytes = reinterpret_cast<uint8_t const *>(frame.colors.data());
+        mRaw.assign(bytes, bytes + frame.colors.size() * sizeof(QuantizedColor));
+
+        mIndex.push_back({ frame.tick, mOffset });
+    }
+    else
+    {
+        // gaps between changed cell ids as varints, followed by their colors
+        header.type = ChunkType::eDelta;
+
+        uint32_t next = 0;
+        for(size_t i = 0; i < mCellCount; ++i) {
+            if(frame.colors[i] != mPrevious[i]) {
+                writeVarint(mRaw, static_cast<uint32_t>(i) - next);
+                next = static_cast<uint32_t>(i) + 1;
+                header.changedCells++;
+            }
+        }
+
+        for(size_t i = 0; i < mCellCount; ++i) {
+            if(frame.colors[i] != mPrevious[i]) {
+                mRaw.insert(mRaw.end(), frame.colors[i].begin(), frame.colors[i].end());
+            }
+        }
+    }
+
+    header.rawSize = static_cast<uint32_t>(mRaw.size());
+
+    // the frame goes back to the free list with the colors of the tick before, record() overwrites them
+    mPrevious.swap(frame.colors);
+
+    return writeChunk(header, mRaw, true);
+}
+
+bool SimRecorder::writeChunk(ChunkHeader header, std::span<uint8_t const> const payload, bool const compress)
+{
+    std::span<char const> data = { reinterpret_cast<char const *>(payload.data()), payload.size() };
+
+    if(compress && !payload.empty())
+    {
+        mCompressed.resize(LZ4_compressBound(static_cast<int>(payload.size())));
+        int const size = LZ4_compress_default(data.data(), mCompressed.data(),
+            static_cast<int>(payload.size()), static_cast<int>(mCompressed.size()));
+        if(size <= 0) {
+            return false;
+        }
+
+        data = { mCompressed.data(), static_cast<size_t>(size) };
+    }
+
+    header.compressedSize = static_cast<uint32_t>(data.size());
+
+    if(!mFile.write(reinterpret_cast<char const *>(&header), sizeof(header))
+        || !mFile.write(data.data(), static_cast<std::streamsize>(data.size()))) {
+        return false;
+    }
+
+    mOffset += sizeof(header) + data.size();
+    return true;
+}
@@ -0,0 +1,90 @@
+//
+// @file:   sim_recorder.h
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Records the cell colors of every tick into a compressed file
+//
+
+#pragma once
+
+#include "recording_format.h"
+#include "sphere/sphere_shader_object.h"
+
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+
+//
+// @class:  SimRecorder
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  record() quantizes the colors and hands them to a writer thread,
+//          which diffs them against the previous tick, compresses the frame
+//          and appends it to the file. Every keyframeInterval frames a full
+//          keyframe is written so the replay can seek. After a failed write
+//          or compression the writer drops the remaining frames, close()
+//          reports it.
+//
+class SimRecorder
+{
+public:
+    using ColorBufferElement = SphereShaderObject::ColorBufferElement;
+
+    SimRecorder(std::string const & filename, size_t const cellCount,
+        uint32_t const keyframeInterval = 100, size_t const maxQueuedFrames = 8);
+    ~SimRecorder();
+
+    SimRecorder(SimRecorder const &) = delete;
+    SimRecorder& operator=(SimRecorder const &) = delete;
+
+    // blocks if the writer thread is more than maxQueuedFrames behind
+    void record(uint64_t const tick, std::span<ColorBufferElement const> const colors);
+
+    // waits for all queued frames, writes the keyframe index and closes the file,
+    // false if anything could not be written
+    bool close();
+
+    uint64_t getBytesWritten() const;
+
+private:
+    struct Frame {
+        uint64_t tick = 0;
+        std::vector<recording::QuantizedColor> colors;
+    };
+
+    size_t const mCellCount;
+    uint32_t const mKeyframeInterval;
+    size_t const mMaxQueuedFrames;
+
+    // writer thread state
+    std::ofstream mFile;
+    uint64_t mOffset = 0;
+    uint64_t mFrameCount = 0;
+    bool mFailed = false;
+    std::vector<recording::QuantizedColor> mPrevious;
+    std::vector<recording::IndexEntry> mIndex;
+    std::vector<uint8_t> mRaw;
+    std::vector<char> mCompressed;
+
+    // shared state
+    mutable std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::deque<Frame> mQueue;
+    std::vector<Frame> mFreeFrames;
+    bool mClosing = false;
+    uint64_t mBytesWritten = 0;
+
+    std::thread mThread;
+
+    // held for the whole close(), the writer thread state belongs to it after the join
+    std::mutex mCloseMutex;
+    bool mClosed = false;
+
+    void run();
+    bool writeFrame(Frame & frame);
+    bool writeChunk(recording::ChunkHeader header, std::span<uint8_t const> const payload, bool const compress);
+};
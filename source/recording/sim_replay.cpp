@@ -0,0 +1,257 @@
+//
+// @file:   sim_replay.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Streams a recording written by the SimRecorder
+//
+
+#include "sim_replay.h"
+
+#include <lz4.h>
+#include <cstring>
+
+using namespace recording;
+
+
+bool SimReplay::open(std::string const & filename)
+{
+    reset();
+
+    mFile.open(filename, std::ios::in | std::ios::binary | std::ios::ate);
+    if(!mFile.is_open()) {
+        return false;
+    }
+
+    uint64_t const fileSize = static_cast<uint64_t>(mFile.tellg());
+    mFile.seekg(0);
+
+    FileHeader header = {};
+    if(!mFile.read(reinterpret_cast<char*>(&header), sizeof(header))
+        || header.magic != magic
+        || header.version != version) {
+        reset();
+        return false;
+    }
+
+    mCellCount = header.cellCount;
+    mColors.assign(mCellCount, QuantizedColor{});
+
+    if(!readIndex(fileSize) && !rebuildIndex(fileSize)) {
+        reset();
+        return false;
+    }
+
+    if(mIndex.empty()) {
+        reset();
+        return false;
+    }
+
+    return seek(mIndex.front().tick);
+}
+
+void SimReplay::reset()
+{
+    mFile = std::ifstream();
+    mDataEnd = 0;
+    mPosition = 0;
+    mTick = 0;
+    mCellCount = 0;
+    mIndex.clear();
+    mColors.clear();
+}
+
+size_t SimReplay::getCellCount() const
+{
+    return mCellCount;
+}
+
+uint64_t SimReplay::getTick() const
+{
+    return mTick;
+}
+
+uint64_t SimReplay::getFirstTick() const
+{
+    return mIndex.empty() ? 0 : mIndex.front().tick;
+}
+
+bool SimReplay::readIndex(uint64_t const fileSize)
+{
+    if(fileSize < sizeof(FileHeader) + sizeof(Footer)) {
+        return false;
+    }
+
+    Footer footer = {};
+    mFile.seekg(static_cast<std::streamoff>(fileSize - sizeof(Footer)));
+    if(!mFile.read(reinterpret_cast<char*>(&footer), sizeof(footer)) || footer.magic != footerMagic) {
+        mFile.clear();
+        return false;
+    }
+
+    ChunkHeader header = {};
+    if(!readChunkHeader(footer.indexOffset, header)
+        || header.type != ChunkType::eIndex
+        || header.rawSize % sizeof(IndexEntry) != 0) {
+        return false;
+    }
+
+    mIndex.resize(header.rawSize / sizeof(IndexEntry));
+    if(!mFile.read(reinterpret_cast<char*>(mIndex.data()), header.rawSize)) {
+        mFile.clear();
+        mIndex.clear();
+        return false;
+    }
+
+    mDataEnd = footer.indexOffset;
+    return true;
+}
+
+bool SimReplay::rebuildIndex(uint64_t const fileSize)
+{
+    // recording was not closed, walk all chunk headers
+    mIndex.clear();
+
+    uint64_t offset = sizeof(FileHeader);
+    ChunkHeader header = {};
+    while(offset + sizeof(ChunkHeader) <= fileSize && readChunkHeader(offset, header))
+    {
+        uint64_t const end = offset + sizeof(ChunkHeader) + header.compressedSize;
+        if(end > fileSize || header.type == ChunkType::eIndex) {
+            break;
+        }
+
+        if(header.type == ChunkType::eKeyframe) {
+            mIndex.push_back({ header.tick, offset });
+        }
+
+        offset = end;
+    }
+
+    mDataEnd = offset;
+    return !mIndex.empty();
+}
+
+bool SimReplay::readChunkHeader(uint64_t const offset, ChunkHeader & header)
+{
+    mFile.seekg(static_cast<std::streamoff>(offset));
+    if(!mFile.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        mFile.clear();
+        return false;
+    }
+
+    return true;
+}
+
+bool SimReplay::seek(uint64_t const tick)
+{
+    if(mIndex.empty()) {
+        return false;
+    }
+
+    // last keyframe not after tick
+    auto it = std::upper_bound(mIndex.begin(), mIndex.end(), tick,
+        [](uint64_t const value, IndexEntry const & entry) { return value < entry.tick; });
+    if(it != mIndex.begin()) {
+        --it;
+    }
+
+    mPosition = it->offset;
+    if(!next()) {
+        return false;
+    }
+
+    // apply the deltas up to tick
+    ChunkHeader header = {};
+    while(mPosition < mDataEnd && readChunkHeader(mPosition, header)
+        && header.type == ChunkType::eDelta && header.tick <= tick)
+    {
+        if(!next()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool SimReplay::next()
+{
+    ChunkHeader header = {};
+    if(mPosition >= mDataEnd || !readChunkHeader(mPosition, header)) {
+        return false;
+    }
+
+    if(!applyChunk(header)) {
+        return false;
+    }
+
+    mPosition += sizeof(ChunkHeader) + header.compressedSize;
+    mTick = header.tick;
+    return true;
+}
+
+bool SimReplay::applyChunk(ChunkHeader const & header)
+{
+    // the file is positioned right after the chunk header
+    mCompressed.resize(header.compressedSize);
+    if(!mFile.read(mCompressed.data(), header.compressedSize)) {
+        mFile.clear();
+        return false;
+    }
+
+    mRaw.resize(header.rawSize);
+    if(header.rawSize > 0) {
+        int const size = LZ4_decompress_safe(mCompressed.data(), reinterpret_cast<char*>(mRaw.data()),
+            static_cast<int>(mCompressed.size()), static_cast<int>(mRaw.size()));
+        if(size != static_cast<int>(header.rawSize)) {
+            return false;
+        }
+    }
+
+    if(header.type == ChunkType::eKeyframe)
+    {
+        if(mRaw.size() != mCellCount * sizeof(QuantizedColor)) {
+            return false;
+        }
+        std::memcpy(mColors.data(), mRaw.data(), mRaw.size());
+        return true;
+    }
+
+    if(header.type != ChunkType::eDelta) {
+        return false;
+    }
+
+    // ids first, then their colors
+    uint8_t const * ids = mRaw.data();
+    uint8_t const * const end = mRaw.data() + mRaw.size();
+    if(static_cast<size_t>(end - ids) < header.changedCells * sizeof(QuantizedColor)) {
+        return false;
+    }
+
+    uint8_t const * const idsEnd = end - header.changedCells * sizeof(QuantizedColor);
+    uint8_t const * values = idsEnd;
+    uint32_t next = 0;
+    for(uint32_t k = 0; k < header.changedCells; ++k)
+    {
+        uint32_t gap = 0;
+        if(!readVarint(ids, idsEnd, gap) || next + gap >= mCellCount) {
+            return false;
+        }
+
+        uint32_t const cell = next + gap;
+        std::memcpy(mColors[cell].data(), values, sizeof(QuantizedColor));
+        values += sizeof(QuantizedColor);
+        next = cell + 1;
+    }
+
+    return true;
+}
+
+void SimReplay::updateColorBuffer(std::span<ColorBufferElement> data)
+{
+    assert(data.size() == mColors.size());
+    for(size_t i = 0; i < data.size(); ++i) {
+        data[i].r = dequantize(mColors[i][0]);
+        data[i].g = dequantize(mColors[i][1]);
+        data[i].b = dequantize(mColors[i][2]);
+    }
+}
@@ -0,0 +1,64 @@
+//
+// @file:   sim_replay.h
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Streams a recording written by the SimRecorder
+//
+
+#pragma once
+
+#include "recording_format.h"
+#include "sphere/sphere_shader_object.h"
+
+#include <fstream>
+#include <string>
+
+
+//
+// @class:  SimReplay
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Reads one chunk at a time. seek() jumps to the closest keyframe
+//          through the index and applies the deltas up to the requested tick.
+//          updateColorBuffer() fits the delegate of the SphereShaderObject.
+//
+class SimReplay
+{
+public:
+    using ColorBufferElement = SphereShaderObject::ColorBufferElement;
+
+    bool open(std::string const & filename);
+    void reset();
+
+    size_t getCellCount() const;
+    uint64_t getTick() const;
+    uint64_t getFirstTick() const;
+
+    // moves to the last frame with a tick <= tick
+    bool seek(uint64_t const tick);
+
+    // applies the next frame, returns false at the end of the recording
+    bool next();
+
+    // writes the colors of the current frame
+    void updateColorBuffer(std::span<ColorBufferElement> data);
+
+private:
+    std::ifstream mFile;
+    uint64_t mDataEnd = 0;
+    uint64_t mPosition = 0;
+    uint64_t mTick = 0;
+
+    size_t mCellCount = 0;
+    std::vector<recording::IndexEntry> mIndex;
+    std::vector<recording::QuantizedColor> mColors;
+
+    std::vector<char> mCompressed;
+    std::vector<uint8_t> mRaw;
+
+    bool readIndex(uint64_t const fileSize);
+    bool rebuildIndex(uint64_t const fileSize);
+
+    bool readChunkHeader(uint64_t const offset, recording::ChunkHeader & header);
+    bool applyChunk(recording::ChunkHeader const & header);
+};
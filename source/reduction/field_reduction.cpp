@@ -0,0 +1,375 @@
+//
+// @file:   field_reduction.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Global statistics of world fields, computed without a pass of their own
+//
+
+#include "field_reduction.h"
+#include "tasks/parallel_for.h"
+
+#include <algorithm>
+#include <array>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+namespace {
+
+// values per chunk, large enough that a thread pays off
+constexpr size_t minChunkSize = 64 * 1024;
+
+struct alignas(64) AlignedSummary {
+    FieldSummary summary;
+};
+
+}
+
+
+double FieldSummary::getMean() const
+{
+    return count > 0 ? sum / static_cast<double>(count) : 0.0;
+}
+
+double FieldSummary::getVariance() const
+{
+    if(count == 0) {
+        return 0.0;
+    }
+
+    double const mean = getMean();
+    return std::max(0.0, sumSquares / static_cast<double>(count) - mean * mean);
+}
+
+void FieldHistogram::addRange(std::span<float const> const values, size_t const stride, size_t const begin, size_t const end)
+{
+    // neighbour cells mostly fall into the same bin, separate counts per lane avoid waiting on the last increment
+    constexpr size_t lanes = 4;
+    std::array<std::array<uint32_t, binCount>, lanes> counts = {};
+
+    alignas(16) std::array<int32_t, lanes> indices;
+    alignas(16) std::array<int32_t, lanes> valid;
+
+    size_t i = begin;
+#if defined(__SSE2__)
+    if(stride == 1)
+    {
+        __m128 const vMin = _mm_set1_ps(min);
+        __m128 const vScale = _mm_set1_ps(scale);
+        __m128 const vZero = _mm_setzero_ps();
+        __m128 const vLast = _mm_set1_ps(static_cast<float>(binCount - 1));
+
+        for(; i + lanes <= end; i += lanes)
+        {
+            // max returns the second operand for NaN, so NaNs land in bin 0 and are not counted
+            __m128 const value = _mm_loadu_ps(values.data() + i);
+            __m128 const position = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_sub_ps(value, vMin), vScale), vZero), vLast);
+            _mm_store_si128(reinterpret_cast<__m128i *>(indices.data()), _mm_cvttps_epi32(position));
+            _mm_store_si128(reinterpret_cast<__m128i *>(valid.data()), _mm_srli_epi32(_mm_castps_si128(_mm_cmpord_ps(value, value)), 31));
+
+            for(size_t lane = 0; lane < lanes; ++lane) {
+                counts[lane][indices[lane]] += valid[lane];
+            }
+        }
+    }
+#endif
+
+    for(; i + lanes <= end; i += lanes)
+    {
+        for(size_t lane = 0; lane < lanes; ++lane) {
+            float const value = values[(i + lane) * stride];
+            valid[lane] = value == value;
+            indices[lane] = valid[lane] ? static_cast<int32_t>(std::clamp((value - min) * scale, 0.0f, static_cast<float>(binCount - 1))) : 0;
+        }
+
+        for(size_t lane = 0; lane < lanes; ++lane) {
+            counts[lane][indices[lane]] += valid[lane];
+        }
+    }
+
+    for(; i < end; ++i) {
+        float const value = values[i * stride];
+        if(value == value) {
+            add(value);
+        }
+    }
+
+    for(auto const & count : counts) {
+        for(size_t bin = 0; bin < binCount; ++bin) {
+            bins[bin] += count[bin];
+        }
+    }
+}
+
+void FieldHistogram::merge(FieldHistogram const & other)
+{
+    for(size_t bin = 0; bin < binCount; ++bin) {
+        bins[bin] += other.bins[bin];
+    }
+}
+
+void FieldHistogram::setRange(float const newMin, float const newMax)
+{
+    min = newMin;
+    max = newMax;
+    scale = max > min ? static_cast<float>(binCount) / (max - min) : 0.0f;
+    bins.fill(0);
+}
+
+float FieldHistogram::getQuantile(double const quantile) const
+{
+    uint64_t total = 0;
+    for(auto const count : bins) {
+        total += count;
+    }
+
+    uint64_t const target = static_cast<uint64_t>(std::clamp(quantile, 0.0, 1.0) * static_cast<double>(total));
+    uint64_t seen = 0;
+    for(size_t bin = 0; bin < binCount; ++bin)
+    {
+        seen += bins[bin];
+        if(seen > target) {
+            return min + (max - min) * static_cast<float>(bin) / binCount;
+        }
+    }
+
+    return max;
+}
+
+namespace {
+
+// a constant stride of 1 lets the compiler vectorize, other strides are gathers anyway
+template<size_t constantStride>
+FieldSummary summarizeStrided(std::span<float const> const values, size_t const runtimeStride, size_t const begin, size_t const end)
+{
+    size_t const stride = constantStride > 0 ? constantStride : runtimeStride;
+
+    // float lanes vectorize, they are flushed to the double sums after a short block to keep the precision
+    constexpr size_t lanes = 8;
+    constexpr size_t valuesPerBlock = 64 * lanes;
+
+    std::array<float, lanes> min;
+    std::array<float, lanes> max;
+    min.fill(std::numeric_limits<float>::infinity());
+    max.fill(-std::numeric_limits<float>::infinity());
+
+    FieldSummary summary;
+    size_t i = begin;
+    while(i + lanes <= end)
+    {
+        std::array<float, lanes> sum = {};
+        std::array<float, lanes> sumSquares = {};
+        std::array<uint32_t, lanes> count = {};
+
+        size_t const blockEnd = std::min(end, i + valuesPerBlock);
+        for(; i + lanes <= blockEnd; i += lanes) {
+            for(size_t lane = 0; lane < lanes; ++lane)
+            {
+                // comparisons with NaN are false, so NaNs are skipped
+                float const value = values[(i + lane) * stride];
+                bool const valid = value == value;
+                float const term = valid ? value : 0.0f;
+                min[lane] = value < min[lane] ? value : min[lane];
+                max[lane] = value > max[lane] ? value : max[lane];
+                sum[lane] += term;
+                sumSquares[lane] += term * term;
+                count[lane] += valid ? 1 : 0;
+            }
+        }
+
+        for(size_t lane = 0; lane < lanes; ++lane) {
+            summary.count += count[lane];
+            summary.sum += sum[lane];
+            summary.sumSquares += sumSquares[lane];
+        }
+    }
+
+    for(; i < end; ++i) {
+        summary.add(values[i * stride]);
+    }
+
+    for(size_t lane = 0; lane < lanes; ++lane) {
+        summary.min = min[lane] < summary.min ? min[lane] : summary.min;
+        summary.max = max[lane] > summary.max ? max[lane] : summary.max;
+    }
+    return summary;
+}
+
+#if defined(__SSE2__)
+
+// the same as summarizeStrided<1> with two vectors of 4 lanes, the compiler does not vectorize the NaN checks
+FieldSummary summarizeContiguous(std::span<float const> const values, size_t const begin, size_t const end)
+{
+    constexpr size_t lanes = 8;
+    constexpr size_t valuesPerBlock = 64 * lanes;
+
+    __m128 min0 = _mm_set1_ps(std::numeric_limits<float>::infinity());
+    __m128 min1 = min0;
+    __m128 max0 = _mm_set1_ps(-std::numeric_limits<float>::infinity());
+    __m128 max1 = max0;
+
+    FieldSummary summary;
+    size_t i = begin;
+    while(i + lanes <= end)
+    {
+        __m128 sum0 = _mm_setzero_ps();
+        __m128 sum1 = _mm_setzero_ps();
+        __m128 squares0 = _mm_setzero_ps();
+        __m128 squares1 = _mm_setzero_ps();
+        __m128i count = _mm_setzero_si128();
+
+        size_t const blockEnd = std::min(end, i + valuesPerBlock);
+        for(; i + lanes <= blockEnd; i += lanes)
+        {
+            __m128 const value0 = _mm_loadu_ps(values.data() + i);
+            __m128 const value1 = _mm_loadu_ps(values.data() + i + 4);
+
+            // min and max return the second operand if one is NaN
+            min0 = _mm_min_ps(value0, min0);
+            min1 = _mm_min_ps(value1, min1);
+            max0 = _mm_max_ps(value0, max0);
+            max1 = _mm_max_ps(value1, max1);
+
+            __m128 const valid0 = _mm_cmpord_ps(value0, value0);
+            __m128 const valid1 = _mm_cmpord_ps(value1, value1);
+            __m128 const term0 = _mm_and_ps(valid0, value0);
+            __m128 const term1 = _mm_and_ps(valid1, value1);
+            sum0 = _mm_add_ps(sum0, term0);
+            sum1 = _mm_add_ps(sum1, term1);
+            squares0 = _mm_add_ps(squares0, _mm_mul_ps(term0, term0));
+            squares1 = _mm_add_ps(squares1, _mm_mul_ps(term1, term1));
+
+            // valid lanes are all ones, that is -1
+            count = _mm_sub_epi32(count, _mm_add_epi32(_mm_castps_si128(valid0), _mm_castps_si128(valid1)));
+        }
+
+        alignas(16) std::array<float, 4> sums;
+        alignas(16) std::array<float, 4> squares;
+        alignas(16) std::array<uint32_t, 4> counts;
+        _mm_store_ps(sums.data(), _mm_add_ps(sum0, sum1));
+        _mm_store_ps(squares.data(), _mm_add_ps(squares0, squares1));
+        _mm_store_si128(reinterpret_cast<__m128i *>(counts.data()), count);
+        for(size_t lane = 0; lane < 4; ++lane) {
+            summary.count += counts[lane];
+            summary.sum += sums[lane];
+            summary.sumSquares += squares[lane];
+        }
+    }
+
+    for(; i < end; ++i) {
+        summary.add(values[i]);
+    }
+
+    alignas(16) std::array<float, 4> mins;
+    alignas(16) std::array<float, 4> maxs;
+    _mm_store_ps(mins.data(), _mm_min_ps(min0, min1));
+    _mm_store_ps(maxs.data(), _mm_max_ps(max0, max1));
+    for(size_t lane = 0; lane < 4; ++lane) {
+        summary.min = mins[lane] < summary.min ? mins[lane] : summary.min;
+        summary.max = maxs[lane] > summary.max ? maxs[lane] : summary.max;
+    }
+    return summary;
+}
+
+#endif
+
+}
+
+FieldSummary summarizeField(std::span<float const> const values, size_t const stride, size_t const begin, size_t const end)
+{
+#if defined(__SSE2__)
+    if(stride == 1) {
+        return summarizeContiguous(values, begin, end);
+    }
+#endif
+    return stride == 1 ? summarizeStrided<1>(values, 1, begin, end) : summarizeStrided<0>(values, stride, begin, end);
+}
+
+FieldSummary reduceField(std::span<float const> const values, size_t const stride)
+{
+    size_t const size = values.size() / stride;
+
+    std::vector<AlignedSummary> partials(getParallelChunkCount(size, minChunkSize));
+    parallelForChunks(size, minChunkSize, [&](size_t const chunk, size_t const begin, size_t const end) {
+        partials[chunk].summary = summarizeField(values, stride, begin, end);
+    });
+
+    FieldSummary summary;
+    for(auto const & partial : partials) {
+        summary.merge(partial.summary);
+    }
+    return summary;
+}
+
+void FieldReducer::setFields(std::vector<std::string> const & names)
+{
+    mStatistics.clear();
+    for(auto const & name : names) {
+        mStatistics.emplace_back().name = name;
+    }
+    mRanges.assign(names.size(), { 0.0f, 0.0f });
+}
+
+void FieldReducer::begin(size_t const chunks)
+{
+    mChunks = chunks;
+    mPartials.resize(chunks * mStatistics.size());
+
+    for(size_t chunk = 0; chunk < chunks; ++chunk) {
+        for(size_t field = 0; field < mStatistics.size(); ++field) {
+            auto & partial = mPartials[chunk * mStatistics.size() + field];
+            partial.summary = FieldSummary();
+            partial.histogram.setRange(mRanges[field].first, mRanges[field].second);
+        }
+    }
+}
+
+void FieldReducer::reduce(size_t const chunk, size_t const field, std::span<float const> const values, size_t const stride,
+    size_t const cellBegin, size_t const cellEnd)
+{
+    auto & partial = mPartials[chunk * mStatistics.size() + field];
+
+    partial.summary.merge(summarizeField(values, stride, cellBegin, cellEnd));
+    if(partial.histogram.hasRange()) {
+        partial.histogram.addRange(values, stride, cellBegin, cellEnd);
+    }
+}
+
+void FieldReducer::end()
+{
+    for(size_t field = 0; field < mStatistics.size(); ++field)
+    {
+        auto & statistics = mStatistics[field];
+
+        FieldSummary summary;
+        FieldHistogram histogram;
+        histogram.setRange(mRanges[field].first, mRanges[field].second);
+        for(size_t chunk = 0; chunk < mChunks; ++chunk) {
+            auto const & partial = mPartials[chunk * mStatistics.size() + field];
+            summary.merge(partial.summary);
+            histogram.merge(partial.histogram);
+        }
+
+        statistics.summary = summary;
+        statistics.histogram = histogram;
+
+        // fields change little per tick, the bins of the next sweep span this range
+        if(summary.count > 0) {
+            mRanges[field] = { summary.min, summary.max };
+        }
+    }
+}
+
+std::span<FieldStatistics const> FieldReducer::getStatistics() const
+{
+    return mStatistics;
+}
+
+FieldStatistics const * FieldReducer::findStatistics(std::string_view const name) const
+{
+    auto const it = std::find_if(mStatistics.begin(), mStatistics.end(),
+        [name](FieldStatistics const & statistics) { return statistics.name == name; });
+    return it == mStatistics.end() ? nullptr : &*it;
+}
@@ -0,0 +1,150 @@
+//
+// @file:   field_reduction.h
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Global statistics of world fields, computed without a pass of their own
+//
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+
+//
+// @struct: FieldSummary
+// @brief:  Count, minimum, maximum and the sums for mean and variance. NaNs
+//          are skipped. Summaries of disjoint ranges merge into the summary
+//          of their union, that makes them the partials of parallel sweeps and
+//          the nodes of the RegionReduction.
+//
+struct FieldSummary
+{
+    uint64_t count = 0;
+    float min = std::numeric_limits<float>::infinity();
+    float max = -std::numeric_limits<float>::infinity();
+    double sum = 0.0;
+    double sumSquares = 0.0;
+
+    void add(float const value) {
+        if(value == value) {
+            count++;
+            min = value < min ? value : min;
+            max = value > max ? value : max;
+            sum += value;
+            sumSquares += static_cast<double>(value) * value;
+        }
+    }
+
+    void merge(FieldSummary const & other) {
+        count += other.count;
+        min = other.min < min ? other.min : min;
+        max = other.max > max ? other.max : max;
+        sum += other.sum;
+        sumSquares += other.sumSquares;
+    }
+
+    double getMean() const;
+    double getVariance() const;
+};
+
+//
+// @struct: FieldHistogram
+// @brief:  binCount equal bins over [min, max], values outside fall into the
+//          first or last bin.
+//
+struct FieldHistogram
+{
+    static constexpr size_t binCount = 64;
+
+    float min = 0.0f;
+    float max = 0.0f;
+    std::array<uint64_t, binCount> bins = {};
+
+    void add(float const value) {
+        float const position = (value - min) * scale;
+        bins[position > 0.0f ? static_cast<size_t>(position < binCount - 1 ? position : binCount - 1) : 0]++;
+    }
+
+    // values[i * stride] for i in [begin, end), NaNs are skipped
+    void addRange(std::span<float const> const values, size_t const stride, size_t const begin, size_t const end);
+
+    void merge(FieldHistogram const & other);
+
+    // empties the bins, the FieldReducer leaves the bins of an empty range empty
+    void setRange(float const newMin, float const newMax);
+
+    bool hasRange() const {
+        return max > min;
+    }
+
+    // lower edge of the bin that holds the quantile
+    float getQuantile(double const quantile) const;
+
+private:
+    float scale = 0.0f;
+};
+
+struct FieldStatistics
+{
+    std::string name;
+    FieldSummary summary;
+    FieldHistogram histogram;
+};
+
+// summary of values[i * stride] for i in [begin, end) on the calling thread, with several
+// independent accumulators, so the additions do not wait for each other
+FieldSummary summarizeField(std::span<float const> const values, size_t const stride, size_t const begin, size_t const end);
+
+// summary of values[i * stride] on all cores, every chunk reduces into its own partial
+FieldSummary reduceField(std::span<float const> const values, size_t const stride = 1);
+
+//
+// @class:  FieldReducer
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Statistics of several fields fused into the parallel sweep that
+//          writes them. Every chunk of the sweep reduces the range it just
+//          wrote, while it is still in the cache, into its own cache line
+//          aligned partial, end() merges the partials in chunk order, so the
+//          result does not depend on the timing of the threads. The histogram
+//          bins span the range of the previous sweep, the first sweep has an
+//          empty histogram.
+//
+class FieldReducer
+{
+public:
+    // one statistics per name, resets the histogram ranges
+    void setFields(std::vector<std::string> const & names);
+
+    // prepares the partials of a sweep with the given chunks
+    void begin(size_t const chunks);
+
+    // reduces values[i * stride] for i in [cellBegin, cellEnd) into the partial of chunk and field
+    void reduce(size_t const chunk, size_t const field, std::span<float const> const values, size_t const stride,
+        size_t const cellBegin, size_t const cellEnd);
+
+    // merges the partials into the statistics
+    void end();
+
+    std::span<FieldStatistics const> getStatistics() const;
+    FieldStatistics const * findStatistics(std::string_view const name) const;
+
+private:
+    struct alignas(64) Partial {
+        FieldSummary summary;
+        FieldHistogram histogram;
+    };
+
+    std::vector<FieldStatistics> mStatistics;
+    std::vector<std::pair<float, float>> mRanges;   // of the histograms of the next sweep
+    std::vector<Partial> mPartials;     // chunk * field count + field
+    size_t mChunks = 0;
+};
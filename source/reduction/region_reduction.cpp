@@ -0,0 +1,154 @@
+//
+// @file:   region_reduction.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Statistics of regions of a field that follow the changed cells
+//
+
+#include "region_reduction.h"
+#include "tasks/parallel_for.h"
+
+#include <algorithm>
+
+
+namespace {
+
+// blocks per chunk of a build
+constexpr size_t minBlocksPerChunk = 1024;
+
+}
+
+
+RegionReduction::RegionReduction(std::span<uint32_t const> const regionOfCell, uint32_t const regionCount)
+{
+    // counting sort of the cells by region, every region padded to whole blocks
+    std::vector<uint32_t> regionSizes(regionCount, 0);
+    for(auto const region : regionOfCell) {
+        regionSizes[region]++;
+    }
+
+    mRegionBlocks.resize(regionCount + 1);
+    mRegionBlocks[0] = 0;
+    for(uint32_t region = 0; region < regionCount; ++region) {
+        mRegionBlocks[region + 1] = mRegionBlocks[region] + static_cast<uint32_t>((regionSizes[region] + blockSize - 1) / blockSize);
+    }
+    mBlockCount = mRegionBlocks.back();
+
+    mCells.assign(mBlockCount * blockSize, noCell);
+    mPositions.resize(regionOfCell.size());
+
+    std::vector<size_t> next(regionCount);
+    for(uint32_t region = 0; region < regionCount; ++region) {
+        next[region] = static_cast<size_t>(mRegionBlocks[region]) * blockSize;
+    }
+    for(uint32_t cell = 0; cell < regionOfCell.size(); ++cell) {
+        size_t const position = next[regionOfCell[cell]]++;
+        mCells[position] = cell;
+        mPositions[cell] = static_cast<uint32_t>(position);
+    }
+
+    mNodes.assign(2 * mBlockCount, FieldSummary());
+}
+
+size_t RegionReduction::getCellCount() const
+{
+    return mPositions.size();
+}
+
+uint32_t RegionReduction::getRegionCount() const
+{
+    return static_cast<uint32_t>(mRegionBlocks.size() - 1);
+}
+
+FieldSummary RegionReduction::summarizeBlock(std::span<float const> const values, size_t const stride, size_t const block) const
+{
+    FieldSummary summary;
+    for(size_t position = block * blockSize; position < (block + 1) * blockSize; ++position) {
+        if(mCells[position] != noCell) {
+            summary.add(values[static_cast<size_t>(mCells[position]) * stride]);
+        }
+    }
+    return summary;
+}
+
+void RegionReduction::build(std::span<float const> const values, size_t const stride)
+{
+    if(mBlockCount == 0) {
+        return;
+    }
+
+    parallelFor(mBlockCount, minBlocksPerChunk, [&](size_t const begin, size_t const end) {
+        for(size_t block = begin; block < end; ++block) {
+            mNodes[mBlockCount + block] = summarizeBlock(values, stride, block);
+        }
+    });
+
+    for(size_t node = mBlockCount - 1; node > 0; --node) {
+        mNodes[node] = mNodes[2 * node];
+        mNodes[node].merge(mNodes[2 * node + 1]);
+    }
+}
+
+void RegionReduction::update(std::span<float const> const values, std::span<uint32_t const> const changedCells, size_t const stride)
+{
+    mDirty.clear();
+    for(auto const cell : changedCells) {
+        mDirty.push_back(static_cast<uint32_t>(mBlockCount + mPositions[cell] / blockSize));
+    }
+
+    std::sort(mDirty.begin(), mDirty.end());
+    mDirty.erase(std::unique(mDirty.begin(), mDirty.end()), mDirty.end());
+
+    for(auto const node : mDirty) {
+        mNodes[node] = summarizeBlock(values, stride, node - mBlockCount);
+    }
+
+    // one level up at a time, siblings share their parent. Leaves differ in depth by one, a
+    // parent may be merged before its deeper child, it is merged again one level later
+    while(!mDirty.empty() && mDirty.back() > 1)
+    {
+        size_t count = 0;
+        for(auto const node : mDirty) {
+            uint32_t const parent = node / 2;
+            if(parent > 0 && (count == 0 || mDirty[count - 1] != parent)) {
+                mDirty[count++] = parent;
+            }
+        }
+        mDirty.resize(count);
+
+        for(auto const node : mDirty) {
+            mNodes[node] = mNodes[2 * node];
+            mNodes[node].merge(mNodes[2 * node + 1]);
+        }
+    }
+}
+
+FieldSummary RegionReduction::query(size_t begin, size_t end) const
+{
+    FieldSummary summary;
+    for(begin += mBlockCount, end += mBlockCount; begin < end; begin /= 2, end /= 2)
+    {
+        if(begin & 1) {
+            summary.merge(mNodes[begin++]);
+        }
+        if(end & 1) {
+            summary.merge(mNodes[--end]);
+        }
+    }
+    return summary;
+}
+
+FieldSummary RegionReduction::getTotal() const
+{
+    return mBlockCount > 1 ? mNodes[1] : query(0, mBlockCount);
+}
+
+FieldSummary RegionReduction::getRegion(uint32_t const region) const
+{
+    return query(mRegionBlocks[region], mRegionBlocks[region + 1]);
+}
+
+FieldSummary RegionReduction::getRegions(uint32_t const regionBegin, uint32_t const regionEnd) const
+{
+    return query(mRegionBlocks[regionBegin], mRegionBlocks[regionEnd]);
+}
@@ -0,0 +1,65 @@
+//
+// @file:   region_reduction.h
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Statistics of regions of a field that follow the changed cells
+//
+
+#pragma once
+
+#include "field_reduction.h"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+
+//
+// @class:  RegionReduction
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Segment tree of FieldSummary over blocks of blockSize cells. The
+//          cells are ordered by region and every region starts a new block,
+//          so a region, or a run of consecutive regions, is a range of blocks
+//          and is queried in O(log n). update() recomputes only the blocks of
+//          the changed cells and their ancestors, a tick that touches k cells
+//          costs O(k (blockSize + log n)) instead of a pass over the field.
+//
+class RegionReduction
+{
+public:
+    static constexpr size_t blockSize = 64;
+
+    // regions are any grouping of the cells, e.g. the cube faces of partitionWorld or ranges of cells
+    RegionReduction(std::span<uint32_t const> const regionOfCell, uint32_t const regionCount);
+
+    // summaries of values[cell * stride] from scratch, on all cores
+    void build(std::span<float const> const values, size_t const stride = 1);
+
+    // values[cell * stride] of the changed cells differ from the last build or update
+    void update(std::span<float const> const values, std::span<uint32_t const> const changedCells, size_t const stride = 1);
+
+    size_t getCellCount() const;
+    uint32_t getRegionCount() const;
+
+    FieldSummary getTotal() const;
+    FieldSummary getRegion(uint32_t const region) const;
+
+    // regions [regionBegin, regionEnd) together
+    FieldSummary getRegions(uint32_t const regionBegin, uint32_t const regionEnd) const;
+
+private:
+    static constexpr uint32_t noCell = UINT32_MAX;
+
+    std::vector<uint32_t> mCells;           // cells in tree order, noCell pads the last block of a region
+    std::vector<uint32_t> mPositions;       // of every cell in mCells
+    std::vector<uint32_t> mRegionBlocks;    // first block of every region and the block count
+
+    size_t mBlockCount = 0;
+    std::vector<FieldSummary> mNodes;       // root at 1, block i at mBlockCount + i
+
+    std::vector<uint32_t> mDirty;
+
+    FieldSummary summarizeBlock(std::span<float const> const values, size_t const stride, size_t const block) const;
+    FieldSummary query(size_t begin, size_t end) const;
+};
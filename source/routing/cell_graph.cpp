@@ -0,0 +1,99 @@
+//
+// @file:   cell_graph.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Weighted cell graph of a world for path finding
+//
+
+#include "cell_graph.h"
+
+#include <algorithm>
+#include <numeric>
+
+
+namespace {
+
+// spreads the lower 10 bits to every third bit
+uint32_t spreadBits(uint32_t value)
+{
+    value &= 0x3ff;
+    value = (value | (value << 16)) & 0x030000ff;
+    value = (value | (value << 8)) & 0x0300f00f;
+    value = (value | (value << 4)) & 0x030c30c3;
+    value = (value | (value << 2)) & 0x09249249;
+    return value;
+}
+
+uint32_t getMortonCode(glm::vec3 const & direction)
+{
+    auto const quantize = [](float const value) {
+        return static_cast<uint32_t>(std::clamp((value + 1.0f) * 0.5f, 0.0f, 1.0f) * 1023.0f);
+    };
+
+    return spreadBits(quantize(direction.x)) | (spreadBits(quantize(direction.y)) << 1) | (spreadBits(quantize(direction.z)) << 2);
+}
+
+}
+
+
+CellGraph::CellGraph(WorldView const & world)
+{
+    size_t const cells = world.getCellCount();
+
+    if(!world.vertices.empty()) {
+        mRadius = glm::length(world.vertices[world.indices.empty() ? 0 : world.indices[0]]);
+    }
+
+    std::vector<glm::vec3> cellDirections(cells);
+    for(size_t cell = 0; cell < cells; ++cell) {
+        cellDirections[cell] = getCellDirection(world, cell);
+    }
+
+    std::vector<uint32_t> codes(cells);
+    for(size_t cell = 0; cell < cells; ++cell) {
+        codes[cell] = getMortonCode(cellDirections[cell]);
+    }
+
+    mCellOfNode.resize(cells);
+    std::iota(mCellOfNode.begin(), mCellOfNode.end(), 0);
+    std::stable_sort(mCellOfNode.begin(), mCellOfNode.end(), [&codes](uint32_t const a, uint32_t const b) {
+        return codes[a] < codes[b];
+    });
+
+    mNodeOfCell.resize(cells);
+    mDirections.resize(cells);
+    for(uint32_t node = 0; node < cells; ++node) {
+        mNodeOfCell[mCellOfNode[node]] = node;
+        mDirections[node] = cellDirections[mCellOfNode[node]];
+    }
+
+    mOffsets.reserve(cells + 1);
+    mOffsets.push_back(0);
+    mEdges.reserve(world.adjacency.size());
+
+    double weightSum = 0.0;
+    for(uint32_t node = 0; node < cells; ++node)
+    {
+        size_t const begin = mEdges.size();
+        for(auto const neighbour : world.getNeighbours(mCellOfNode[node]))
+        {
+            uint32_t const target = mNodeOfCell[neighbour];
+            if(target == node) {
+                continue;
+            }
+
+            float const weight = getDistance(node, target);
+            mEdges.push_back({ target, weight });
+            weightSum += weight;
+        }
+
+        std::sort(mEdges.begin() + begin, mEdges.end(), [](Edge const & a, Edge const & b) {
+            return a.target < b.target;
+        });
+        mOffsets.push_back(static_cast<uint32_t>(mEdges.size()));
+    }
+
+    if(!mEdges.empty()) {
+        mMeanEdgeWeight = static_cast<float>(weightSum / mEdges.size());
+    }
+}
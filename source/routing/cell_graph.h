@@ -0,0 +1,98 @@
+//
+// @file:   cell_graph.h
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Weighted cell graph of a world for path finding
+//
+
+#pragma once
+
+#include "include_glm.h"
+#include "world/world.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+
+// great circle distance of two directions on a sphere, the chord gives a precise angle for close points
+inline float getGreatCircleDistance(glm::vec3 const & a, glm::vec3 const & b, float const radius)
+{
+    return radius * 2.0f * std::asin(std::min(1.0f, glm::length(a - b) * 0.5f));
+}
+
+// cells from the source to the target, both included
+struct CellPath
+{
+    std::vector<uint32_t> cells;
+    float length = 0.0f;            // in world units
+};
+
+//
+// @class:  CellGraph
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  The adjacency of a world as a compressed sparse row graph. Edges
+//          are weighted with the great circle distance of the cell centers.
+//          Nodes are stored in morton order of the cell centers, so cells
+//          close on the sphere are close in memory, and target and weight of
+//          an edge share a cache line. The algorithms work on nodes, their
+//          interfaces take and return cells.
+//
+class CellGraph
+{
+public:
+    struct Edge {
+        uint32_t target;            // node
+        float weight;
+    };
+
+    explicit CellGraph(WorldView const & world);
+
+    size_t getNodeCount() const {
+        return mCellOfNode.size();
+    }
+
+    uint32_t getNode(uint32_t const cell) const {
+        return mNodeOfCell[cell];
+    }
+
+    uint32_t getCell(uint32_t const node) const {
+        return mCellOfNode[node];
+    }
+
+    std::span<Edge const> getEdges(uint32_t const node) const {
+        return std::span<Edge const>(mEdges).subspan(mOffsets[node], mOffsets[node + 1] - mOffsets[node]);
+    }
+
+    float getRadius() const {
+        return mRadius;
+    }
+
+    float getMeanEdgeWeight() const {
+        return mMeanEdgeWeight;
+    }
+
+    // great circle distance of the centers of two nodes, a lower bound of every path between them
+    float getDistance(uint32_t const a, uint32_t const b) const {
+        return getGreatCircleDistance(mDirections[a], mDirections[b], mRadius);
+    }
+
+    // center of a node on the unit sphere
+    glm::vec3 const & getDirection(uint32_t const node) const {
+        return mDirections[node];
+    }
+
+private:
+    std::vector<uint32_t> mOffsets;
+    std::vector<Edge> mEdges;
+    std::vector<glm::vec3> mDirections;
+
+    std::vector<uint32_t> mNodeOfCell;
+    std::vector<uint32_t> mCellOfNode;
+
+    float mRadius = 1.0f;
+    float mMeanEdgeWeight = 0.0f;
+};
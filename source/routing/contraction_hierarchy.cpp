@@ -0,0 +1,497 @@
+//
+// @file:   contraction_hierarchy.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Precomputed shortcuts for fast repeated shortest path queries
+//
+
+#include "contraction_hierarchy.h"
+#include "distance_field.h"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+
+namespace {
+
+constexpr uint32_t noNode = SearchState::noNode;
+
+struct BuildEdge
+{
+    uint32_t target;
+    float weight;
+    uint32_t middle;
+};
+
+struct Shortcut
+{
+    uint32_t from;
+    uint32_t to;
+    float weight;
+};
+
+//
+// @class:  Contractor
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Build state of a hierarchy. The edge lists only hold the not yet
+//          contracted neighbours, contracted nodes keep their upward edges.
+//
+class Contractor
+{
+public:
+    Contractor(CellGraph const & graph, ContractionSettings const & settings)
+        : mSettings(settings),
+          mEdges(graph.getNodeCount()),
+          mUpward(graph.getNodeCount()),
+          mContractedNeighbours(graph.getNodeCount(), 0),
+          mLevels(graph.getNodeCount(), 0),
+          mTargets(graph.getNodeCount(), 0)
+    {
+        for(uint32_t node = 0; node < graph.getNodeCount(); ++node) {
+            for(auto const & edge : graph.getEdges(node)) {
+                addEdge(node, { edge.target, edge.weight, noNode });
+            }
+        }
+    }
+
+    // contracts the nodes up to the core, returns the nodes by rank with the core last
+    std::vector<uint32_t> contract()
+    {
+        size_t const nodes = mEdges.size();
+
+        using Entry = std::pair<int, uint32_t>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+        for(uint32_t node = 0; node < nodes; ++node) {
+            queue.push({ getPriority(node), node });
+        }
+
+        std::vector<uint32_t> order;
+        std::vector<uint32_t> core;
+        order.reserve(nodes);
+
+        // Priorities of the neighbours of a contracted node are only updated when they come
+        // out of the queue. Updating them right away gives a few shortcuts less for several
+        // times the witness searches.
+        while(!queue.empty())
+        {
+            auto const [priority, node] = queue.top();
+            queue.pop();
+
+            int const current = getPriority(node);
+            if(current > priority && !queue.empty() && current > queue.top().first) {
+                queue.push({ current, node });
+                continue;
+            }
+
+            if(mEdges[node].size() > mSettings.maxContractedDegree) {
+                core.push_back(node);
+                continue;
+            }
+
+            contractNode(node);
+            order.push_back(node);
+        }
+
+        // The core keeps its edges in both directions. Queries search it like the graph,
+        // so it keeps the morton order of the nodes, neighbours stay close in memory.
+        std::sort(core.begin(), core.end());
+        for(auto const node : core) {
+            mUpward[node] = std::move(mEdges[node]);
+            order.push_back(node);
+        }
+
+        mCoreSize = core.size();
+        return order;
+    }
+
+    size_t getCoreSize() const {
+        return mCoreSize;
+    }
+
+    std::vector<BuildEdge> const & getUpwardEdges(uint32_t const node) const {
+        return mUpward[node];
+    }
+
+private:
+    ContractionSettings const mSettings;
+
+    std::vector<std::vector<BuildEdge>> mEdges;
+    std::vector<std::vector<BuildEdge>> mUpward;
+    std::vector<uint32_t> mContractedNeighbours;
+    std::vector<uint32_t> mLevels;
+
+    SearchState mWitness;
+    std::vector<uint64_t> mTargets;
+    uint64_t mSearch = 0;
+    std::vector<Shortcut> mShortcuts;
+    size_t mCoreSize = 0;
+
+    // keeps the shorter edge if the nodes are already connected
+    void addEdge(uint32_t const node, BuildEdge const & edge)
+    {
+        for(auto & existing : mEdges[node])
+        {
+            if(existing.target == edge.target) {
+                if(edge.weight < existing.weight) {
+                    existing = edge;
+                }
+                return;
+            }
+        }
+
+        mEdges[node].push_back(edge);
+    }
+
+    // Shortcuts between neighbours of the node without a witness path that avoids the node.
+    // A witness search that gives up adds a shortcut that may not be needed, which only costs
+    // query time, so priorities are estimated with a smaller limit than the contraction.
+    void findShortcuts(uint32_t const node, uint32_t const settleLimit)
+    {
+        mShortcuts.clear();
+        auto const & edges = mEdges[node];
+
+        for(size_t i = 0; i + 1 < edges.size(); ++i)
+        {
+            uint32_t const from = edges[i].target;
+
+            float maxWeight = 0.0f;
+            for(size_t j = i + 1; j < edges.size(); ++j) {
+                maxWeight = std::max(maxWeight, edges[j].weight);
+            }
+            float const bound = edges[i].weight + maxWeight;
+
+            mWitness.reset(mEdges.size());
+            mWitness.relax(from, 0.0f, noNode, 0.0f);
+
+            // the neighbours the search still has to settle are marked with its number
+            mSearch++;
+            for(size_t j = i + 1; j < edges.size(); ++j) {
+                mTargets[edges[j].target] = mSearch;
+            }
+
+            uint32_t settled = 0;
+            size_t remaining = edges.size() - i - 1;
+            SearchState::QueueEntry entry;
+            while(remaining > 0 && mWitness.pop(entry) && entry.distance <= bound && settled++ < settleLimit)
+            {
+                remaining -= mTargets[entry.node] == mSearch;
+
+                for(auto const & edge : mEdges[entry.node])
+                {
+                    float const distance = entry.distance + edge.weight;
+                    if(edge.target != node && distance <= bound) {
+                        mWitness.relax(edge.target, distance, noNode, distance);
+                    }
+                }
+            }
+
+            // reached but not settled nodes still have a real path of that length
+            for(size_t j = i + 1; j < edges.size(); ++j)
+            {
+                float const via = edges[i].weight + edges[j].weight;
+                if(mWitness.getDistance(edges[j].target) > via) {
+                    mShortcuts.push_back({ from, edges[j].target, via });
+                }
+            }
+        }
+    }
+
+    // edge difference first, then spread the contraction over the graph and keep the hierarchy flat
+    int getPriority(uint32_t const node)
+    {
+        findShortcuts(node, mSettings.priorityWitnessSettleLimit);
+        int const edgeDifference = static_cast<int>(mShortcuts.size()) - static_cast<int>(mEdges[node].size());
+        return 4 * edgeDifference + 2 * static_cast<int>(mContractedNeighbours[node]) + static_cast<int>(mLevels[node]);
+    }
+
+    void contractNode(uint32_t const node)
+    {
+        findShortcuts(node, mSettings.witnessSettleLimit);
+        for(auto const & shortcut : mShortcuts) {
+            addEdge(shortcut.from, { shortcut.to, shortcut.weight, node });
+            addEdge(shortcut.to, { shortcut.from, shortcut.weight, node });
+        }
+
+        mUpward[node] = std::move(mEdges[node]);
+        mEdges[node] = {};
+
+        for(auto const & edge : mUpward[node])
+        {
+            auto & edges = mEdges[edge.target];
+            std::erase_if(edges, [node](BuildEdge const & other) { return other.target == node; });
+
+            mContractedNeighbours[edge.target]++;
+            mLevels[edge.target] = std::max(mLevels[edge.target], mLevels[node] + 1);
+        }
+    }
+};
+
+}
+
+
+ContractionHierarchy::ContractionHierarchy(CellGraph const & graph, ContractionSettings const & settings)
+{
+    size_t const nodes = graph.getNodeCount();
+
+    Contractor contractor(graph, settings);
+    std::vector<uint32_t> const order = contractor.contract();
+    mCoreSize = contractor.getCoreSize();
+
+    std::vector<uint32_t> rankOfNode(nodes);
+    for(uint32_t rank = 0; rank < nodes; ++rank) {
+        rankOfNode[order[rank]] = rank;
+    }
+
+    mRankOfCell.resize(nodes);
+    mCellOfRank.resize(nodes);
+    mDirections.resize(nodes);
+    mRadius = graph.getRadius();
+    for(uint32_t rank = 0; rank < nodes; ++rank) {
+        mCellOfRank[rank] = graph.getCell(order[rank]);
+        mRankOfCell[mCellOfRank[rank]] = rank;
+        mDirections[rank] = graph.getDirection(order[rank]);
+    }
+
+    mOffsets.reserve(nodes + 1);
+    mOffsets.push_back(0);
+
+    std::vector<BuildEdge> edges;
+    for(uint32_t rank = 0; rank < nodes; ++rank)
+    {
+        edges = contractor.getUpwardEdges(order[rank]);
+        for(auto & edge : edges) {
+            edge.target = rankOfNode[edge.target];
+            edge.middle = edge.middle == noNode ? noNode : rankOfNode[edge.middle];
+        }
+        std::sort(edges.begin(), edges.end(), [](BuildEdge const & a, BuildEdge const & b) {
+            return a.target < b.target;
+        });
+
+        for(auto const & edge : edges) {
+            mEdges.push_back({ edge.target, edge.weight });
+            mMiddles.push_back(edge.middle);
+            mShortcutCount += edge.middle != noNode;
+        }
+        mOffsets.push_back(static_cast<uint32_t>(mEdges.size()));
+    }
+
+    // every landmark is the cell farthest from the ones before, the first the one farthest from cell 0
+    mLandmarkCount = mCoreSize > 0 ? settings.landmarkCount : 0;
+    mLandmarkDistances.resize(mCoreSize * mLandmarkCount);
+    if(mLandmarkCount == 0) {
+        return;
+    }
+
+    auto const getFarthest = [](std::vector<float> const & distances) {
+        uint32_t farthest = 0;
+        for(uint32_t cell = 0; cell < distances.size(); ++cell) {
+            // unreachable cells would not bound anything
+            if(distances[cell] != SearchState::infinity && distances[cell] > distances[farthest]) {
+                farthest = cell;
+            }
+        }
+        return farthest;
+    };
+
+    uint32_t landmark = 0;
+    std::vector<float> nearest = computeDistanceField(graph, std::span<uint32_t const>(&landmark, 1));
+    landmark = getFarthest(nearest);
+    std::fill(nearest.begin(), nearest.end(), SearchState::infinity);
+
+    uint32_t const coreBegin = getCoreBegin();
+    for(size_t i = 0; i < mLandmarkCount; ++i)
+    {
+        auto const field = computeDistanceField(graph, std::span<uint32_t const>(&landmark, 1));
+        for(uint32_t cell = 0; cell < nodes; ++cell)
+        {
+            uint32_t const rank = mRankOfCell[cell];
+            if(rank >= coreBegin) {
+                mLandmarkDistances[(rank - coreBegin) * mLandmarkCount + i] = field[cell];
+            }
+            nearest[cell] = std::min(nearest[cell], field[cell]);
+        }
+
+        landmark = getFarthest(nearest);
+    }
+}
+
+
+ContractionPathFinder::ContractionPathFinder(ContractionHierarchy const & hierarchy)
+    : mHierarchy(hierarchy)
+{
+}
+
+float ContractionPathFinder::getPotential(uint32_t const rank, uint32_t const target) const
+{
+    float potential = mHierarchy.getDistance(rank, target);
+    if(rank < mHierarchy.getCoreBegin()) {
+        return potential;
+    }
+
+    auto const landmarks = mHierarchy.getLandmarkDistances(rank);
+    for(size_t i = 0; i < landmarks.size(); ++i) {
+        potential = std::max({ potential, landmarks[i] - mTargetUpper[i], mTargetLower[i] - landmarks[i] });
+    }
+    return potential;
+}
+
+float ContractionPathFinder::search(uint32_t const source, uint32_t const target, uint32_t & meeting)
+{
+    mSettled = 0;
+    meeting = noNode;
+
+    uint32_t const coreBegin = mHierarchy.getCoreBegin();
+    mTargetLower.assign(mHierarchy.getLandmarkCount(), -SearchState::infinity);
+    mTargetUpper.assign(mHierarchy.getLandmarkCount(), SearchState::infinity);
+
+    // upwards from the target, the core nodes are reached but not left
+    mBackward.reset(mHierarchy.getNodeCount());
+    mBackward.relax(target, 0.0f, noNode, 0.0f);
+
+    SearchState::QueueEntry entry;
+    while(mBackward.pop(entry))
+    {
+        mSettled++;
+        auto const edges = mHierarchy.getEdges(entry.node);
+
+        if(entry.node >= coreBegin)
+        {
+            auto const landmarks = mHierarchy.getLandmarkDistances(entry.node);
+            for(size_t i = 0; i < landmarks.size(); ++i) {
+                mTargetLower[i] = std::max(mTargetLower[i], landmarks[i] - entry.distance);
+                mTargetUpper[i] = std::min(mTargetUpper[i], landmarks[i] + entry.distance);
+            }
+            continue;
+        }
+
+        // the graph is undirected, the upward edges are also the edges from above
+        bool const stalled = std::any_of(edges.begin(), edges.end(), [&](ContractionHierarchy::Edge const & edge) {
+            return mBackward.getDistance(edge.target) + edge.weight < entry.distance;
+        });
+        if(stalled) {
+            continue;
+        }
+
+        for(auto const & edge : edges) {
+            float const distance = entry.distance + edge.weight;
+            mBackward.relax(edge.target, distance, entry.node, distance);
+        }
+    }
+
+    mForward.reset(mHierarchy.getNodeCount());
+    mForward.relax(source, 0.0f, noNode, getPotential(source, target));
+
+    float best = SearchState::infinity;
+    while(mForward.getMinKey() < best && mForward.pop(entry))
+    {
+        mSettled++;
+
+        if(mBackward.reached(entry.node))
+        {
+            float const distance = entry.distance + mBackward.getDistance(entry.node);
+            if(distance < best) {
+                best = distance;
+                meeting = entry.node;
+            }
+        }
+
+        // core nodes are only reached over core edges and settled with their shortest distance
+        auto const edges = mHierarchy.getEdges(entry.node);
+        bool const stalled = entry.node < coreBegin && std::any_of(edges.begin(), edges.end(), [&](ContractionHierarchy::Edge const & edge) {
+            return mForward.getDistance(edge.target) + edge.weight < entry.distance;
+        });
+        if(stalled) {
+            continue;
+        }
+
+        for(auto const & edge : edges)
+        {
+            float const distance = entry.distance + edge.weight;
+            if(distance < mForward.getDistance(edge.target)) {
+                mForward.relax(edge.target, distance, entry.node, distance + getPotential(edge.target, target));
+            }
+        }
+    }
+
+    return best;
+}
+
+float ContractionPathFinder::findDistance(uint32_t const sourceCell, uint32_t const targetCell)
+{
+    uint32_t meeting;
+    return search(mHierarchy.getRank(sourceCell), mHierarchy.getRank(targetCell), meeting);
+}
+
+bool ContractionPathFinder::findPath(uint32_t const sourceCell, uint32_t const targetCell, CellPath & path)
+{
+    path.cells.clear();
+    path.length = 0.0f;
+
+    uint32_t const source = mHierarchy.getRank(sourceCell);
+    uint32_t const target = mHierarchy.getRank(targetCell);
+
+    uint32_t meeting;
+    float const length = search(source, target, meeting);
+    if(meeting == noNode) {
+        return false;
+    }
+
+    // source up to the meeting node, then down to the target
+    std::vector<uint32_t> hubs;
+    for(uint32_t rank = meeting; rank != noNode; rank = mForward.getParent(rank)) {
+        hubs.push_back(rank);
+    }
+    std::reverse(hubs.begin(), hubs.end());
+    for(uint32_t rank = mBackward.getParent(meeting); rank != noNode; rank = mBackward.getParent(rank)) {
+        hubs.push_back(rank);
+    }
+
+    std::vector<uint32_t> ranks = { source };
+    for(size_t i = 0; i + 1 < hubs.size(); ++i) {
+        unpackEdge(hubs[i], hubs[i + 1], ranks);
+    }
+
+    path.length = length;
+    path.cells.reserve(ranks.size());
+    for(auto const rank : ranks) {
+        path.cells.push_back(mHierarchy.getCell(rank));
+    }
+    return true;
+}
+
+void ContractionPathFinder::unpackEdge(uint32_t const from, uint32_t const to, std::vector<uint32_t> & ranks)
+{
+    mStack.clear();
+    mStack.push_back(to);
+    mStack.push_back(from);
+
+    while(!mStack.empty())
+    {
+        uint32_t const a = mStack.back();
+        mStack.pop_back();
+        uint32_t const b = mStack.back();
+        mStack.pop_back();
+
+        // the edge is stored at the lower ranked node
+        uint32_t const lower = std::min(a, b);
+        uint32_t const higher = std::max(a, b);
+        auto const edges = mHierarchy.getEdges(lower);
+        auto const it = std::lower_bound(edges.begin(), edges.end(), higher, [](ContractionHierarchy::Edge const & edge, uint32_t const rank) {
+            return edge.target < rank;
+        });
+        uint32_t const middle = mHierarchy.getMiddle(lower, static_cast<size_t>(it - edges.begin()));
+
+        if(middle == noNode) {
+            ranks.push_back(b);
+        }
+        else {
+            // a to middle first, the stack is last in first out
+            mStack.push_back(b);
+            mStack.push_back(middle);
+            mStack.push_back(middle);
+            mStack.push_back(a);
+        }
+    }
+}
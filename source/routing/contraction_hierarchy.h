@@ -0,0 +1,177 @@
+//
+// @file:   contraction_hierarchy.h
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Precomputed shortcuts for fast repeated shortest path queries
+//
+
+#pragma once
+
+#include "cell_graph.h"
+#include "search_state.h"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+
+struct ContractionSettings
+{
+    // nodes settled by a witness search before it gives up and adds the shortcut
+    uint32_t witnessSettleLimit = 100;
+
+    // the same while estimating the shortcuts of a node for the contraction order
+    uint32_t priorityWitnessSettleLimit = 10;
+
+    // Nodes with more neighbours stay in the uncontracted core. The top levels of a grid
+    // like graph are dense, contracting them costs more than searching them.
+    uint32_t maxContractedDegree = 16;
+
+    // nodes spread over the graph whose distances to the core nodes are stored, they bound
+    // the distances in the core much tighter than the great circle the cells only follow in steps
+    uint32_t landmarkCount = 16;
+};
+
+//
+// @class:  ContractionHierarchy
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Contracts the nodes of a cell graph one by one, cheapest first,
+//          and adds a shortcut between two neighbours of a contracted node if
+//          no other path is as short. Every node gets a rank, the order of
+//          contraction, and only keeps its edges to higher ranked nodes.
+//          Nodes are stored by rank, so the upper levels that every query
+//          visits are packed together. Shortcuts remember the node they skip
+//          to unpack paths. Nodes that got too many neighbours form the core
+//          at the highest ranks, they keep the edges to all core neighbours
+//          and their distances to the landmarks.
+//
+class ContractionHierarchy
+{
+public:
+    struct Edge {
+        uint32_t target;            // rank
+        float weight;
+    };
+
+    explicit ContractionHierarchy(CellGraph const & graph, ContractionSettings const & settings = {});
+
+    size_t getNodeCount() const {
+        return mCellOfRank.size();
+    }
+
+    size_t getShortcutCount() const {
+        return mShortcutCount;
+    }
+
+    size_t getCoreSize() const {
+        return mCoreSize;
+    }
+
+    // rank of the first core node
+    uint32_t getCoreBegin() const {
+        return static_cast<uint32_t>(mCellOfRank.size() - mCoreSize);
+    }
+
+    size_t getLandmarkCount() const {
+        return mLandmarkCount;
+    }
+
+    // distances of a core node to the landmarks
+    std::span<float const> getLandmarkDistances(uint32_t const rank) const {
+        return std::span<float const>(mLandmarkDistances).subspan((rank - getCoreBegin()) * mLandmarkCount, mLandmarkCount);
+    }
+
+    uint32_t getRank(uint32_t const cell) const {
+        return mRankOfCell[cell];
+    }
+
+    uint32_t getCell(uint32_t const rank) const {
+        return mCellOfRank[rank];
+    }
+
+    // edges to higher ranks, and to all neighbours in the core
+    std::span<Edge const> getEdges(uint32_t const rank) const {
+        return std::span<Edge const>(mEdges).subspan(mOffsets[rank], mOffsets[rank + 1] - mOffsets[rank]);
+    }
+
+    // great circle distance of two nodes, a lower bound of every edge and shortcut between them
+    float getDistance(uint32_t const a, uint32_t const b) const {
+        return getGreatCircleDistance(mDirections[a], mDirections[b], mRadius);
+    }
+
+    // rank of the node a shortcut skips, SearchState::noNode for edges of the graph
+    uint32_t getMiddle(uint32_t const rank, size_t const edge) const {
+        return mMiddles[mOffsets[rank] + edge];
+    }
+
+private:
+    std::vector<uint32_t> mOffsets;
+    std::vector<Edge> mEdges;
+    std::vector<uint32_t> mMiddles;
+
+    std::vector<uint32_t> mRankOfCell;
+    std::vector<uint32_t> mCellOfRank;
+
+    std::vector<glm::vec3> mDirections;
+    float mRadius = 1.0f;
+
+    size_t mShortcutCount = 0;
+    size_t mCoreSize = 0;
+
+    // of the core nodes by rank, mLandmarkCount per node
+    std::vector<float> mLandmarkDistances;
+    size_t mLandmarkCount = 0;
+};
+
+//
+// @class:  ContractionPathFinder
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Searches upwards from the target first, up to the core without
+//          leaving it, then runs A* from the source, upwards and through the
+//          core, until no path over a node the backward search reached can be
+//          shorter. The potential is the great circle distance to the target,
+//          in the core also the landmark bound. The distances of the target to
+//          the landmarks are bounded by the core nodes the backward search
+//          reached. The forward search never leaves the core again, so the
+//          stronger potential stays consistent. Nodes that are reached shorter
+//          from above are stalled. Not thread safe, use one path finder per
+//          thread on a shared hierarchy.
+//
+class ContractionPathFinder
+{
+public:
+    explicit ContractionPathFinder(ContractionHierarchy const & hierarchy);
+
+    // infinity if the target can not be reached
+    float findDistance(uint32_t const sourceCell, uint32_t const targetCell);
+
+    // false if the target can not be reached
+    bool findPath(uint32_t const sourceCell, uint32_t const targetCell, CellPath & path);
+
+    size_t getSettledCount() const {
+        return mSettled;
+    }
+
+private:
+    ContractionHierarchy const & mHierarchy;
+    SearchState mForward;
+    SearchState mBackward;
+    size_t mSettled = 0;
+
+    std::vector<uint32_t> mStack;
+
+    // range of the distances of the landmarks to the target of the current search
+    std::vector<float> mTargetLower;
+    std::vector<float> mTargetUpper;
+
+    // distance and the rank where both searches meet
+    float search(uint32_t const source, uint32_t const target, uint32_t & meeting);
+
+    // lower bound of the distance of a node to the target of the current search
+    float getPotential(uint32_t const rank, uint32_t const target) const;
+
+    // appends the ranks of an edge without its first node, shortcuts replaced by their edges
+    void unpackEdge(uint32_t const from, uint32_t const to, std::vector<uint32_t> & ranks);
+};
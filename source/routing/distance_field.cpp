@@ -0,0 +1,162 @@
+//
+// @file:   distance_field.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Multi source distance fields with parallel delta stepping
+//
+
+#include "distance_field.h"
+#include "tasks/parallel_for.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <limits>
+
+
+namespace {
+
+// frontiers smaller than this are relaxed on the calling thread
+constexpr size_t nodesPerChunk = 4096;
+
+constexpr uint32_t infinityBits = std::bit_cast<uint32_t>(std::numeric_limits<float>::infinity());
+
+// Relaxes the light (weight <= delta) or the heavy edges of the nodes in parallel. Distances are
+// stored as the bits of positive floats, which order like unsigned integers, so an atomic
+// minimum is a compare exchange loop. Improved targets are collected per chunk, returns the chunks.
+size_t relaxEdges(CellGraph const & graph, std::vector<uint32_t> const & nodes, std::vector<uint32_t> & distances,
+    float const delta, bool const light, std::vector<std::vector<uint32_t>> & updates)
+{
+    size_t const chunks = (nodes.size() + nodesPerChunk - 1) / nodesPerChunk;
+    if(updates.size() < chunks) {
+        updates.resize(chunks);
+    }
+
+    parallelFor(chunks, 1, [&](size_t const begin, size_t const end) {
+        for(size_t chunk = begin; chunk < end; ++chunk)
+        {
+            auto & improved = updates[chunk];
+            improved.clear();
+
+            size_t const last = std::min(nodes.size(), (chunk + 1) * nodesPerChunk);
+            for(size_t i = chunk * nodesPerChunk; i < last; ++i)
+            {
+                uint32_t const node = nodes[i];
+                float const distance = std::bit_cast<float>(std::atomic_ref(distances[node]).load(std::memory_order_relaxed));
+
+                for(auto const & edge : graph.getEdges(node))
+                {
+                    if((edge.weight <= delta) != light) {
+                        continue;
+                    }
+
+                    uint32_t const candidate = std::bit_cast<uint32_t>(distance + edge.weight);
+                    std::atomic_ref target(distances[edge.target]);
+                    uint32_t current = target.load(std::memory_order_relaxed);
+                    while(candidate < current)
+                    {
+                        if(target.compare_exchange_weak(current, candidate, std::memory_order_relaxed)) {
+                            improved.push_back(edge.target);
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+    });
+
+    return chunks;
+}
+
+}
+
+
+std::vector<float> computeDistanceField(CellGraph const & graph, std::span<uint32_t const> const sourceCells, float delta)
+{
+    size_t const nodes = graph.getNodeCount();
+
+    // wider buckets give larger frontiers for the threads, but relax more nodes more than once
+    if(delta <= 0.0f) {
+        delta = graph.getMeanEdgeWeight() > 0.0f ? 4.0f * graph.getMeanEdgeWeight() : 1.0f;
+    }
+
+    std::vector<uint32_t> distances(nodes, infinityBits);
+    std::vector<std::vector<uint32_t>> buckets(1);
+    for(auto const cell : sourceCells) {
+        uint32_t const node = graph.getNode(cell);
+        distances[node] = 0;
+        buckets[0].push_back(node);
+    }
+
+    auto const getBucket = [&](uint32_t const node) {
+        return static_cast<size_t>(std::bit_cast<float>(distances[node]) / delta);
+    };
+
+    // nodes may be queued several times, the stamps keep them out of a frontier twice
+    std::vector<uint32_t> frontierStamps(nodes, 0);
+    std::vector<uint32_t> removedStamps(nodes, 0);
+    uint32_t frontierStamp = 0;
+    uint32_t removedStamp = 0;
+
+    std::vector<uint32_t> frontier;
+    std::vector<uint32_t> removed;
+    std::vector<std::vector<uint32_t>> updates;
+
+    for(size_t bucket = 0; bucket < buckets.size(); ++bucket)
+    {
+        // rounding can move a target of a heavy edge back into the current bucket
+        auto const enqueue = [&](size_t const chunks) {
+            for(size_t chunk = 0; chunk < chunks; ++chunk) {
+                for(auto const node : updates[chunk])
+                {
+                    size_t const target = std::max(bucket, getBucket(node));
+                    if(target >= buckets.size()) {
+                        buckets.resize(target + 1);
+                    }
+                    buckets[target].push_back(node);
+                }
+            }
+        };
+
+        while(!buckets[bucket].empty())
+        {
+            removedStamp++;
+            removed.clear();
+
+            // light edges until no node falls into this bucket again
+            while(!buckets[bucket].empty())
+            {
+                frontierStamp++;
+                frontier.clear();
+                for(auto const node : buckets[bucket])
+                {
+                    if(frontierStamps[node] == frontierStamp || getBucket(node) > bucket) {
+                        continue;
+                    }
+
+                    frontierStamps[node] = frontierStamp;
+                    frontier.push_back(node);
+
+                    if(removedStamps[node] != removedStamp) {
+                        removedStamps[node] = removedStamp;
+                        removed.push_back(node);
+                    }
+                }
+                buckets[bucket].clear();
+
+                enqueue(relaxEdges(graph, frontier, distances, delta, true, updates));
+            }
+
+            // heavy edges once with the final distances of the bucket
+            enqueue(relaxEdges(graph, removed, distances, delta, false, updates));
+        }
+
+        std::vector<uint32_t>().swap(buckets[bucket]);
+    }
+
+    std::vector<float> field(nodes);
+    for(uint32_t cell = 0; cell < nodes; ++cell) {
+        field[cell] = std::bit_cast<float>(distances[graph.getNode(cell)]);
+    }
+    return field;
+}
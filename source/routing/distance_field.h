@@ -0,0 +1,18 @@
+//
+// @file:   distance_field.h
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Multi source distance fields with parallel delta stepping
+//
+
+#pragma once
+
+#include "cell_graph.h"
+
+#include <span>
+#include <vector>
+
+
+// distance of every cell to the nearest source cell along the cell graph, infinity for
+// unreachable cells. Delta is the bucket width, 0 picks a multiple of the mean edge weight.
+std::vector<float> computeDistanceField(CellGraph const & graph, std::span<uint32_t const> const sourceCells, float delta = 0.0f);
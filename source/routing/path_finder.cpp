@@ -0,0 +1,55 @@
+//
+// @file:   path_finder.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  A* shortest paths on the cell graph
+//
+
+#include "path_finder.h"
+
+#include <algorithm>
+
+
+PathFinder::PathFinder(CellGraph const & graph)
+    : mGraph(graph)
+{
+}
+
+bool PathFinder::findPath(uint32_t const sourceCell, uint32_t const targetCell, CellPath & path)
+{
+    path.cells.clear();
+    path.length = 0.0f;
+    mSettled = 0;
+
+    uint32_t const source = mGraph.getNode(sourceCell);
+    uint32_t const target = mGraph.getNode(targetCell);
+
+    mState.reset(mGraph.getNodeCount());
+    mState.relax(source, 0.0f, SearchState::noNode, mGraph.getDistance(source, target));
+
+    SearchState::QueueEntry entry;
+    while(mState.pop(entry))
+    {
+        mSettled++;
+
+        if(entry.node == target)
+        {
+            path.length = entry.distance;
+            for(uint32_t node = target; node != SearchState::noNode; node = mState.getParent(node)) {
+                path.cells.push_back(mGraph.getCell(node));
+            }
+            std::reverse(path.cells.begin(), path.cells.end());
+            return true;
+        }
+
+        for(auto const & edge : mGraph.getEdges(entry.node))
+        {
+            float const distance = entry.distance + edge.weight;
+            if(distance < mState.getDistance(edge.target)) {
+                mState.relax(edge.target, distance, entry.node, distance + mGraph.getDistance(edge.target, target));
+            }
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,40 @@
+//
+// @file:   path_finder.h
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  A* shortest paths on the cell graph
+//
+
+#pragma once
+
+#include "cell_graph.h"
+#include "search_state.h"
+
+
+//
+// @class:  PathFinder
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  A* search with the great circle distance to the target as the
+//          heuristic. The edge weights are great circle distances too, so the
+//          heuristic is consistent and every node is settled once. Not thread
+//          safe, use one path finder per thread on a shared graph.
+//
+class PathFinder
+{
+public:
+    explicit PathFinder(CellGraph const & graph);
+
+    // false if the target can not be reached
+    bool findPath(uint32_t const sourceCell, uint32_t const targetCell, CellPath & path);
+
+    // nodes taken from the queue by the last search
+    size_t getSettledCount() const {
+        return mSettled;
+    }
+
+private:
+    CellGraph const & mGraph;
+    SearchState mState;
+    size_t mSettled = 0;
+};
@@ -0,0 +1,124 @@
+//
+// @file:   search_state.h
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Per node state of graph searches that is reset in constant time
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+
+//
+// @class:  SearchState
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Distances and parents of a search. A node only counts as reached
+//          if it was written in the current generation, so a new search does
+//          not have to clear millions of entries. Keep one per thread and
+//          reuse it for all queries.
+//
+class SearchState
+{
+public:
+    static constexpr uint32_t noNode = std::numeric_limits<uint32_t>::max();
+    static constexpr float infinity = std::numeric_limits<float>::infinity();
+
+    struct QueueEntry {
+        float key;
+        float distance;
+        uint32_t node;
+
+        bool operator>(QueueEntry const & other) const {
+            return key > other.key;
+        }
+    };
+
+    void reset(size_t const nodes)
+    {
+        if(mGenerations.size() != nodes)
+        {
+            mGenerations.assign(nodes, 0);
+            mDistances.resize(nodes);
+            mParents.resize(nodes);
+            mGeneration = 0;
+        }
+
+        if(++mGeneration == 0)
+        {
+            std::fill(mGenerations.begin(), mGenerations.end(), 0);
+            mGeneration = 1;
+        }
+
+        mQueue.clear();
+    }
+
+    bool reached(uint32_t const node) const {
+        return mGenerations[node] == mGeneration;
+    }
+
+    float getDistance(uint32_t const node) const {
+        return reached(node) ? mDistances[node] : infinity;
+    }
+
+    uint32_t getParent(uint32_t const node) const {
+        return mParents[node];
+    }
+
+    // true if the distance of the node improved
+    bool relax(uint32_t const node, float const distance, uint32_t const parent, float const key)
+    {
+        if(reached(node) && mDistances[node] <= distance) {
+            return false;
+        }
+
+        mGenerations[node] = mGeneration;
+        mDistances[node] = distance;
+        mParents[node] = parent;
+        push({ key, distance, node });
+        return true;
+    }
+
+    bool empty() const {
+        return mQueue.empty();
+    }
+
+    float getMinKey() const {
+        return mQueue.empty() ? infinity : mQueue.front().key;
+    }
+
+    // skips entries whose node was reached again with a shorter distance
+    bool pop(QueueEntry & entry)
+    {
+        while(!mQueue.empty())
+        {
+            std::pop_heap(mQueue.begin(), mQueue.end(), std::greater<QueueEntry>());
+            entry = mQueue.back();
+            mQueue.pop_back();
+
+            if(entry.distance <= mDistances[entry.node]) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    std::vector<uint32_t> mGenerations;
+    std::vector<float> mDistances;
+    std::vector<uint32_t> mParents;
+    uint32_t mGeneration = 0;
+
+    std::vector<QueueEntry> mQueue;
+
+    void push(QueueEntry const & entry)
+    {
+        mQueue.push_back(entry);
+        std::push_heap(mQueue.begin(), mQueue.end(), std::greater<QueueEntry>());
+    }
+};
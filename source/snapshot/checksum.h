@@ -0,0 +1,77 @@
+//
+// @file:   checksum.h
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Fast 64 bit checksum over a block of memory
+//
+
+#pragma once
+
+#include <span>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+
+//
+// Four independent multiply-rotate lanes over 32 byte stripes, same
+// structure as xxHash64 so it runs at memory speed. Not meant for security.
+//
+inline uint64_t checksum64(std::span<std::byte const> const data, uint64_t const seed = 0)
+{
+    constexpr uint64_t prime1 = 0x9E3779B185EBCA87ull;
+    constexpr uint64_t prime2 = 0xC2B2AE3D27D4EB4Full;
+    constexpr uint64_t prime3 = 0x165667B19E3779F9ull;
+
+    auto const rotl = [](uint64_t const x, int const r) {
+        return (x << r) | (x >> (64 - r));
+    };
+
+    auto const round = [&](uint64_t const acc, uint64_t const value) {
+        return rotl(acc + value * prime2, 31) * prime1;
+    };
+
+    auto const load = [](std::byte const * p) {
+        uint64_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    };
+
+    std::byte const * p = data.data();
+    size_t remaining = data.size();
+
+    uint64_t lanes[4] = { seed + prime1 + prime2, seed + prime2, seed, seed - prime1 };
+    while(remaining >= 32)
+    {
+        for(size_t i = 0; i < 4; ++i) {
+            lanes[i] = round(lanes[i], load(p + i * 8));
+        }
+        p += 32;
+        remaining -= 32;
+    }
+
+    uint64_t hash = rotl(lanes[0], 1) + rotl(lanes[1], 7) + rotl(lanes[2], 12) + rotl(lanes[3], 18);
+    hash += data.size();
+
+    while(remaining >= 8)
+    {
+        hash = rotl(hash ^ round(0, load(p)), 27) * prime1 + prime3;
+        p += 8;
+        remaining -= 8;
+    }
+
+    while(remaining > 0)
+    {
+        hash = rotl(hash ^ (static_cast<uint64_t>(*p) * prime3), 11) * prime1;
+        ++p;
+        --remaining;
+    }
+
+    hash ^= hash >> 33;
+    hash *= prime2;
+    hash ^= hash >> 29;
+    hash *= prime3;
+    hash ^= hash >> 32;
+
+    return hash;
+}
@@ -0,0 +1,138 @@
+//
+// @file:   mapped_file.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Read only memory mapping of a file
+//
+
+#include "mapped_file.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+struct MappedFile::Impl {
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#endif
+    void * data = nullptr;
+    size_t size = 0;
+};
+
+
+MappedFile::MappedFile()
+    : mImpl(std::make_unique<Impl>())
+{
+
+}
+
+MappedFile::~MappedFile()
+{
+    reset();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(std::string const & filename)
+{
+    reset();
+
+    mImpl->file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if(mImpl->file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER size = {};
+    if(!GetFileSizeEx(mImpl->file, &size) || size.QuadPart == 0) {
+        reset();
+        return false;
+    }
+
+    mImpl->mapping = CreateFileMappingA(mImpl->file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if(mImpl->mapping == nullptr) {
+        reset();
+        return false;
+    }
+
+    mImpl->data = MapViewOfFile(mImpl->mapping, FILE_MAP_READ, 0, 0, 0);
+    if(mImpl->data == nullptr) {
+        reset();
+        return false;
+    }
+
+    mImpl->size = static_cast<size_t>(size.QuadPart);
+    return true;
+}
+
+void MappedFile::reset()
+{
+    if(mImpl->data != nullptr) {
+        UnmapViewOfFile(mImpl->data);
+    }
+    if(mImpl->mapping != nullptr) {
+        CloseHandle(mImpl->mapping);
+    }
+    if(mImpl->file != INVALID_HANDLE_VALUE) {
+        CloseHandle(mImpl->file);
+    }
+
+    *mImpl = Impl();
+}
+
+#else
+
+bool MappedFile::open(std::string const & filename)
+{
+    reset();
+
+    int const fd = ::open(filename.c_str(), O_RDONLY);
+    if(fd < 0) {
+        return false;
+    }
+
+    struct stat info = {};
+    if(fstat(fd, &info) != 0 || info.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+
+    // the mapping keeps its own reference to the file
+    void * const data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if(data == MAP_FAILED) {
+        return false;
+    }
+
+    mImpl->data = data;
+    mImpl->size = static_cast<size_t>(info.st_size);
+    return true;
+}
+
+void MappedFile::reset()
+{
+    if(mImpl->data != nullptr) {
+        munmap(mImpl->data, mImpl->size);
+    }
+
+    *mImpl = Impl();
+}
+
+#endif
+
+bool MappedFile::loaded() const
+{
+    return mImpl->data != nullptr;
+}
+
+std::span<std::byte const> MappedFile::data() const
+{
+    return { static_cast<std::byte const *>(mImpl->data), mImpl->size };
+}
@@ -0,0 +1,32 @@
+//
+// @file:   mapped_file.h
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Read only memory mapping of a file
+//
+
+#pragma once
+
+#include <span>
+#include <string>
+#include <memory>
+#include <cstddef>
+
+
+class MappedFile
+{
+public:
+    MappedFile();
+    ~MappedFile();
+
+    bool open(std::string const & filename);
+    void reset();
+
+    bool loaded() const;
+
+    std::span<std::byte const> data() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> mImpl;
+};
@@ -0,0 +1,271 @@
+//
+// @file:   world_snapshot.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Binary world snapshot, loaded by mapping the file into memory
+//
+
+#include "world_snapshot.h"
+#include "checksum.h"
+
+#include <algorithm>
+#include <fstream>
+#include <cassert>
+
+using namespace snapshot;
+
+namespace {
+
+template<typename T>
+std::span<std::byte const> asBytes(std::span<T const> const data)
+{
+    return std::as_bytes(data);
+}
+
+template<typename T>
+std::span<std::byte const> asBytes(T const & value)
+{
+    return { reinterpret_cast<std::byte const *>(&value), sizeof(T) };
+}
+
+uint64_t alignUp(uint64_t const value)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+uint64_t computeHeaderChecksum(Header const & header)
+{
+    return checksum64(asBytes(header).first(offsetof(Header, headerChecksum)));
+}
+
+// one pass without branches on the values, so it vectorizes
+bool isBelow(std::span<uint32_t const> const values, uint64_t const limit)
+{
+    uint32_t largest = 0;
+    for(auto const value : values) {
+        largest = std::max(largest, value);
+    }
+
+    return values.empty() || largest < limit;
+}
+
+}
+
+
+bool WorldSnapshot::write(std::string const & filename, WorldView const & world)
+{
+    struct Entry {
+        Section section;
+        std::span<std::byte const> data;
+    };
+
+    std::vector<Entry> entries;
+    auto const add = [&](SectionType const type, uint32_t const components, std::string_view const name, std::span<std::byte const> const data) {
+        Entry entry = {};
+        entry.section.type = type;
+        entry.section.components = components;
+        std::copy_n(name.begin(), std::min(name.size(), entry.section.name.size() - 1), entry.section.name.begin());
+        entry.section.size = data.size();
+        entry.section.checksum = checksum64(data);
+        entry.data = data;
+        entries.push_back(entry);
+    };
+
+    add(SectionType::eVertices, 3, "vertices", asBytes(world.vertices));
+    add(SectionType::eIndices, 1, "indices", asBytes(world.indices));
+    add(SectionType::eAdjacencyOffsets, 1, "adjacency_offsets", asBytes(world.adjacencyOffsets));
+    add(SectionType::eAdjacency, 1, "adjacency", asBytes(world.adjacency));
+    for(auto const & field : world.fields) {
+        add(SectionType::eField, field.components, field.name, asBytes(field.values));
+    }
+
+    // layout
+    uint64_t offset = alignUp(sizeof(Header) + sizeof(Section) * entries.size());
+    for(auto & entry : entries) {
+        entry.section.offset = offset;
+        offset = alignUp(offset + entry.section.size);
+    }
+
+    std::vector<Section> sections;
+    for(auto const & entry : entries) {
+        sections.push_back(entry.section);
+    }
+
+    Header header = {};
+    header.magic = magic;
+    header.version = version;
+    header.byteOrder = byteOrderMark;
+    header.sectionCount = static_cast<uint32_t>(sections.size());
+    header.fileSize = offset;
+    header.cellCount = world.getCellCount();
+    header.tick = world.tick;
+    header.time = world.time;
+    header.sectionTableChecksum = checksum64(asBytes(std::span<Section const>(sections)));
+    header.headerChecksum = computeHeaderChecksum(header);
+
+    std::ofstream out(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    if(!out.is_open()) {
+        return false;
+    }
+
+    std::array<char, alignment> const padding = {};
+    uint64_t position = 0;
+    auto const writeBytes = [&](std::span<std::byte const> const data) {
+        out.write(reinterpret_cast<char const *>(data.data()), static_cast<std::streamsize>(data.size()));
+        position += data.size();
+    };
+    auto const pad = [&]() {
+        auto const size = alignUp(position) - position;
+        out.write(padding.data(), static_cast<std::streamsize>(size));
+        position += size;
+    };
+
+    writeBytes(asBytes(header));
+    writeBytes(asBytes(std::span<Section const>(sections)));
+    pad();
+
+    for(auto const & entry : entries) {
+        assert(position == entry.section.offset);
+        writeBytes(entry.data);
+        pad();
+    }
+
+    return out.good();
+}
+
+bool WorldSnapshot::open(std::string const & filename)
+{
+    reset();
+
+    if(!mFile.open(filename) || !parse()) {
+        reset();
+        return false;
+    }
+
+    return true;
+}
+
+void WorldSnapshot::reset()
+{
+    mView = WorldView();
+    mSections = {};
+    mFile.reset();
+}
+
+bool WorldSnapshot::loaded() const
+{
+    return mFile.loaded();
+}
+
+bool WorldSnapshot::parse()
+{
+    auto const data = mFile.data();
+    if(data.size() < sizeof(Header)) {
+        return false;
+    }
+
+    auto const & header = *reinterpret_cast<Header const *>(data.data());
+    if(header.magic != magic
+        || header.byteOrder != byteOrderMark
+        || header.version != version
+        || header.fileSize != data.size()
+        || header.headerChecksum != computeHeaderChecksum(header)) {
+        return false;
+    }
+
+    if(sizeof(Header) + sizeof(Section) * uint64_t(header.sectionCount) > data.size()) {
+        return false;
+    }
+
+    mSections = { reinterpret_cast<Section const *>(data.data() + sizeof(Header)), header.sectionCount };
+    if(checksum64(asBytes(mSections)) != header.sectionTableChecksum) {
+        return false;
+    }
+
+    // every cell has 6 indices in the file, a larger count is crafted and would overflow below
+    auto const cellCount = header.cellCount;
+    if(cellCount > data.size()) {
+        return false;
+    }
+
+    mView.tick = header.tick;
+    mView.time = header.time;
+
+    for(auto const & section : mSections)
+    {
+        if(section.offset % alignment != 0
+            || section.offset > data.size()
+            || section.size > data.size() - section.offset) {
+            return false;
+        }
+
+        auto const bytes = data.subspan(section.offset, section.size);
+        auto const name = std::string_view(section.name.data(), std::find(section.name.begin(), section.name.end(), '\0') - section.name.begin());
+
+        switch(section.type)
+        {
+            case SectionType::eVertices:
+                mView.vertices = { reinterpret_cast<glm::vec3 const *>(bytes.data()), bytes.size() / sizeof(glm::vec3) };
+                break;
+            case SectionType::eIndices:
+                mView.indices = { reinterpret_cast<uint32_t const *>(bytes.data()), bytes.size() / sizeof(uint32_t) };
+                break;
+            case SectionType::eAdjacencyOffsets:
+                mView.adjacencyOffsets = { reinterpret_cast<uint32_t const *>(bytes.data()), bytes.size() / sizeof(uint32_t) };
+                break;
+            case SectionType::eAdjacency:
+                mView.adjacency = { reinterpret_cast<uint32_t const *>(bytes.data()), bytes.size() / sizeof(uint32_t) };
+                break;
+            case SectionType::eField:
+                if(section.components == 0
+                    || section.size % (uint64_t(section.components) * sizeof(float)) != 0
+                    || section.size / (uint64_t(section.components) * sizeof(float)) != cellCount) {
+                    return false;
+                }
+                mView.fields.push_back({ name, section.components,
+                    { reinterpret_cast<float const *>(bytes.data()), bytes.size() / sizeof(float) } });
+                break;
+            default:
+                // sections of newer writers are skipped
+                break;
+        }
+    }
+
+    if(mView.vertices.empty()
+        || mView.indices.size() != cellCount * 6
+        || mView.adjacencyOffsets.size() != cellCount + 1
+        || mView.adjacencyOffsets.front() != 0
+        || mView.adjacencyOffsets.back() != mView.adjacency.size()) {
+        return false;
+    }
+
+    // the index sections are read once, the fields are only read by verify()
+    if(!std::is_sorted(mView.adjacencyOffsets.begin(), mView.adjacencyOffsets.end())
+        || !isBelow(mView.indices, mView.vertices.size())
+        || !isBelow(mView.adjacency, cellCount)) {
+        return false;
+    }
+
+    return true;
+}
+
+bool WorldSnapshot::verify() const
+{
+    if(!loaded()) {
+        return false;
+    }
+
+    auto const data = mFile.data();
+    for(auto const & section : mSections) {
+        if(checksum64(data.subspan(section.offset, section.size)) != section.checksum) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+WorldView const & WorldSnapshot::getView() const
+{
+    return mView;
+}
@@ -0,0 +1,98 @@
+//
+// @file:   world_snapshot.h
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Binary world snapshot, loaded by mapping the file into memory
+//
+
+#pragma once
+
+#include "world/world.h"
+#include "mapped_file.h"
+
+#include <array>
+
+
+//
+// File layout, all sections start at a multiple of alignment:
+//
+//   SnapshotHeader
+//   SnapshotSection[sectionCount]
+//   section data ...
+//
+namespace snapshot
+{
+    constexpr std::array<char, 8> magic = { 'W', 'S', 'S', 'N', 'A', 'P', '\0', '\0' };
+    constexpr uint32_t version = 2;
+    constexpr uint64_t alignment = 64;
+
+    // written in the byte order of the writer, the data is not swapped on load
+    constexpr uint32_t byteOrderMark = 0x01020304;
+
+    enum class SectionType : uint32_t {
+        eVertices = 1,
+        eIndices = 2,
+        eAdjacencyOffsets = 3,
+        eAdjacency = 4,
+        eField = 5,
+    };
+
+    struct Header {
+        std::array<char, 8> magic;
+        uint32_t version;
+        uint32_t byteOrder;
+        uint32_t sectionCount;
+        uint32_t reserved;
+        uint64_t fileSize;
+        uint64_t cellCount;
+        uint64_t tick;
+        double time;
+        uint64_t sectionTableChecksum;
+        uint64_t headerChecksum;            // over all bytes before this member
+    };
+
+    struct Section {
+        SectionType type;
+        uint32_t components;
+        std::array<char, 48> name;
+        uint64_t offset;
+        uint64_t size;
+        uint64_t checksum;
+    };
+
+    static_assert(sizeof(Header) == 72);
+    static_assert(sizeof(Section) == 80);
+}
+
+
+//
+// @class:  WorldSnapshot
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  open() maps the file, checks the header and section table and
+//          that every index and neighbour is in range, so a truncated or
+//          crafted file can not make the view read outside the mapping. The
+//          spans of the view point straight into the mapping. verify() reads
+//          everything and compares the section checksums.
+//
+class WorldSnapshot
+{
+public:
+    static bool write(std::string const & filename, WorldView const & world);
+
+    bool open(std::string const & filename);
+    void reset();
+
+    bool loaded() const;
+    bool verify() const;
+
+    WorldView const & getView() const;
+
+private:
+    MappedFile mFile;
+    WorldView mView;
+
+    std::span<snapshot::Section const> mSections;
+
+    bool parse();
+};
@@ -6,6 +6,38 @@
 //
 
 #include "sphere_shader_object.h"
+#include "assets/asset_pack.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+
+namespace {
+
+// arena of the update task running on this thread, see getFrameResource
+thread_local FrameArena * tFrameArena = nullptr;
+
+// calls update with a staging buffer of size elements in arena. A task waiting for a parallelFor
+// may run the task of another buffer meanwhile, so the arena of the thread is restored after
+template<typename T>
+std::span<T> stage(FrameArena & arena, size_t const frame, Delegate<void(std::span<T>)> & update, size_t const size)
+{
+	arena.beginFrame(frame);
+	if(!update) {
+		return {};
+	}
+
+	std::span<T> const staging(std::pmr::polymorphic_allocator<T>(&arena.get()).allocate(size), size);
+
+	FrameArena * const previous = tFrameArena;
+	tFrameArena = &arena;
+	update(staging);
+	tFrameArena = previous;
+
+	return staging;
+}
+
+}
 
 
 SphereShaderObject::SphereShaderObject(size_t const vertexBufferSize, size_t const colorBufferSize)
@@ -15,8 +47,15 @@ SphereShaderObject::SphereShaderObject(size_t const vertexBufferSize, size_t con
 	if(vertexBufferSize != mColorBufferSize * 6)
 	{
 		assert(false);
-		throw std::exception("mIndexBufferSize != mColorBufferSize * 6");
+		throw std::runtime_error("mIndexBufferSize != mColorBufferSize * 6");
 	}
+
+	mCopyVertexStaging.set<&SphereShaderObject::copyVertexStaging>(*this);
+	mCopyColorStaging.set<&SphereShaderObject::copyColorStaging>(*this);
+	mCopyUniformStaging.set<&SphereShaderObject::copyUniformStaging>(*this);
+
+	// the delegates are looked up when the tasks run, so they can still be changed
+	addUpdateTasks(mUpdateTasks, {});
 }
 
 
@@ -28,6 +67,25 @@ void SphereShaderObject::setup(RenderEngineInterface & engine)
     
     // uniform buffer
     mUniformBuffer.create(engine, 1);
+    for(auto & arena : mFrameArenas) {
+        arena.resize(engine.getSwapChainSize());
+    }
+    mStagingFrame = 0;
+    mStaged = false;
+
+    auto & telemetry = getTelemetry();
+    mMappedBytes.clear();
+    for(size_t i = 0; i < engine.getSwapChainSize(); ++i)
+    {
+        std::string const image = ".image" + std::to_string(i) + ".bytes";
+        mMappedBytes.push_back({
+            telemetry.getCounter("mapped.sphere.vertex" + image),
+            telemetry.getCounter("mapped.sphere.color" + image),
+            telemetry.getCounter("mapped.sphere.uniform" + image),
+        });
+    }
+    mFrameBytes = telemetry.getHistogram("mapped.sphere.frame_bytes");
+
     mDescriptorSetLayout.createDescriptorSetLayout(engine, getUniformBindingDescription());
     mDescriptorPool.createDescriptorPool(engine, getUniformDescriptorPoolSizes(engine.getSwapChainSize()));
 
@@ -55,30 +113,106 @@ void SphereShaderObject::setup(RenderEngineInterface & engine)
 
 void SphereShaderObject::draw(RenderEngineInterface & engine, size_t const imageIndex)
 {
-	// init data
+	// the update delegates ran as tasks of the frame graph, or run now
+	if(!mStaged) {
+		prepare();
+	}
+
+	// every update writes the whole buffer of the image. The mapped buffers are written one after
+	// another, the engine does not promise that its buffers can be mapped from several threads at once
+	size_t const vertexBytes = mVertexBufferSize * sizeof(VertexBufferElement);
+	size_t const colorBytes = mColorBufferSize * sizeof(ColorBufferElement);
+	size_t const uniformBytes = sizeof(UnformBuffer);
+
+	auto const & counters = mMappedBytes[imageIndex];
+	size_t frameBytes = 0;
+
+	// init data, only the first frames, written in place
 	if(mInit++ < engine.getSwapChainSize())
 	{
 		if(initVertexBuffer){
 			mVertexBuffer.update(engine, imageIndex, initVertexBuffer);
+			counters.vertex.add(vertexBytes);
+			frameBytes += vertexBytes;
 		}
 
 		if(initColorBuffer){
 			mColorBuffer2.update(engine, imageIndex, initColorBuffer);
+			counters.color.add(colorBytes);
+			frameBytes += colorBytes;
 		}
 	}
 
-	// update data
-	if(updateVertexBuffer){
-		mVertexBuffer.update(engine, imageIndex, updateVertexBuffer);
+	// update data, copied from the staging
+	if(!mVertexStaging.empty()){
+		mVertexBuffer.update(engine, imageIndex, mCopyVertexStaging);
+		counters.vertex.add(vertexBytes);
+		frameBytes += vertexBytes;
 	}
 
-	if(updateColorBuffer){
-		mColorBuffer2.update(engine, imageIndex, updateColorBuffer);
+	if(!mColorStaging.empty()){
+		mColorBuffer2.update(engine, imageIndex, mCopyColorStaging);
+		counters.color.add(colorBytes);
+		frameBytes += colorBytes;
 	}
 
-	if(updateUniformBuffer){
-		mUniformBuffer.update(engine, imageIndex, updateUniformBuffer);
+	if(!mUniformStaging.empty()){
+		mUniformBuffer.update(engine, imageIndex, mCopyUniformStaging);
+		counters.uniform.add(uniformBytes);
+		frameBytes += uniformBytes;
 	}
+
+	mFrameBytes.record(frameBytes);
+
+	mStaged = false;
+	mStagingFrame = (mStagingFrame + 1) % mFrameArenas.front().size();
+}
+
+TaskGraph::TaskId SphereShaderObject::addUpdateTasks(TaskGraph & graph, std::span<TaskGraph::TaskId const> const dependencies)
+{
+	TaskGraph::TaskId const vertices = graph.add([this]() { stageVertices(); }, dependencies);
+	TaskGraph::TaskId const colors = graph.add([this]() { stageColors(); }, dependencies);
+	TaskGraph::TaskId const uniforms = graph.add([this]() { stageUniforms(); }, dependencies);
+
+	return graph.add([this]() { mStaged = true; }, { vertices, colors, uniforms });
+}
+
+void SphereShaderObject::prepare()
+{
+	mUpdateTasks.run();
+}
+
+void SphereShaderObject::stageVertices()
+{
+	mVertexStaging = stage(mFrameArenas[0], mStagingFrame, updateVertexBuffer, mVertexBufferSize);
+}
+
+void SphereShaderObject::stageColors()
+{
+	mColorStaging = stage(mFrameArenas[1], mStagingFrame, updateColorBuffer, mColorBufferSize);
+}
+
+void SphereShaderObject::stageUniforms()
+{
+	mUniformStaging = stage(mFrameArenas[2], mStagingFrame, updateUniformBuffer, 1);
+}
+
+void SphereShaderObject::copyVertexStaging(std::span<VertexBufferElement> data)
+{
+	assert(data.size() == mVertexStaging.size());
+	std::copy(mVertexStaging.begin(), mVertexStaging.end(), data.begin());
+}
+
+void SphereShaderObject::copyColorStaging(std::span<ColorBufferElement> data)
+{
+	assert(data.size() == mColorStaging.size());
+	std::copy(mColorStaging.begin(), mColorStaging.end(), data.begin());
+}
+
+void SphereShaderObject::copyUniformStaging(std::span<UnformBuffer> data)
+{
+	assert(data.size() == mUniformStaging.size());
+	std::copy(mUniformStaging.begin(), mUniformStaging.end(), data.begin());
 }
 
 void SphereShaderObject::cleanup(RenderEngineInterface & engine)
@@ -96,6 +230,21 @@ void SphereShaderObject::cleanup(RenderEngineInterface & engine)
 	mInit = 0;
 }
 
+std::pmr::memory_resource& SphereShaderObject::getFrameResource()
+{
+	// outside of the update tasks, e.g. in the init delegates, the arena of the vertices
+	return tFrameArena != nullptr ? tFrameArena->get() : mFrameArenas.front().get();
+}
+
+ArenaStatistics SphereShaderObject::getFrameArenaStatistics() const
+{
+	ArenaStatistics statistics;
+	for(auto const & arena : mFrameArenas) {
+		statistics += arena.getStatistics();
+	}
+	return statistics;
+}
+
 void SphereShaderObject::recordCommands(RenderEngineInterface& engine)
 {
 	assert(mPipeline.getPipelineLayout());
@@ -188,10 +337,9 @@ std::vector<vk::DescriptorPoolSize> SphereShaderObject::getUniformDescriptorPool
 	return poolSize;
 }
 
-#include "sphere_shader_vert.h"
 std::span<char const> SphereShaderObject::getVertexShaderCode() const
 {	
-	return sphere_shader_vert;
+	return getBuiltinAssets().get("sphere_shader_vert");
 }
 
 std::span<char const> SphereShaderObject::getGeometryShaderCode() const
@@ -199,10 +347,9 @@ std::span<char const> SphereShaderObject::getGeometryShaderCode() const
 	return std::span<char>();
 }
 
-#include "sphere_shader_frag.h"
 std::span<char const> SphereShaderObject::getFragmentShaderCode() const
 {
-	return sphere_shader_frag;
+	return getBuiltinAssets().get("sphere_shader_frag");
 }
 
 vk::PrimitiveTopology SphereShaderObject::getInputTopology() const
@@ -14,8 +14,13 @@
 #include "vulkan_particle_engine/components/simple_descriptor_set_layout.h"
 #include "vulkan_particle_engine/components/advanced_descriptor_pool.h"
 #include "vulkan_particle_engine/components/advanced_pipeline.h"
+#include "memory/frame_arena.h"
+#include "tasks/task_graph.h"
+#include "telemetry/telemetry.h"
 #include "include_glm.h"
 
+#include <array>
+
 class SphereShaderObject : public ShaderObject
 {
 public:
@@ -54,12 +59,56 @@ public:
     void draw(RenderEngineInterface&, size_t const imageIndex) final;
     void cleanup(RenderEngineInterface&) final;
 
+	size_t getVertexBufferSize() const { return mVertexBufferSize; }
+	size_t getColorBufferSize() const { return mColorBufferSize; }
+
+	// adds one task per buffer to graph, started after dependencies. The tasks call the update
+	// delegates of the next frame, each into a staging buffer in a frame arena of its own, so
+	// draw() only copies the staging into the mapped buffers. Returns the task that finishes the staging
+	TaskGraph::TaskId addUpdateTasks(TaskGraph & graph, std::span<TaskGraph::TaskId const> const dependencies);
+
+	// runs the same tasks on a graph of its own, draw() calls it if no graph filled the staging
+	void prepare();
+
+	// scratch memory for the update delegates, valid for as many frames as there are swapchain images.
+	// The delegates of the three buffers run in parallel, each gets an arena of its own
+	std::pmr::memory_resource& getFrameResource();
+	ArenaStatistics getFrameArenaStatistics() const;
+
 private:
 
 	size_t const mVertexBufferSize;
 	size_t const mColorBufferSize;
 	uint32_t mInit = 0;
 
+	// vertex, color and uniform buffer
+	static constexpr size_t bufferCount = 3;
+
+	std::array<FrameArena, bufferCount> mFrameArenas;
+	size_t mStagingFrame = 0;		// arena of the next staging, advanced by every draw
+	bool mStaged = false;
+
+	// written by the update tasks, copied by draw
+	std::span<VertexBufferElement> mVertexStaging;
+	std::span<ColorBufferElement> mColorStaging;
+	std::span<UnformBuffer> mUniformStaging;
+
+	Delegate<void(std::span<VertexBufferElement>)> mCopyVertexStaging;
+	Delegate<void(std::span<ColorBufferElement>)>  mCopyColorStaging;
+	Delegate<void(std::span<UnformBuffer>)> mCopyUniformStaging;
+
+	// the update tasks of prepare()
+	TaskGraph mUpdateTasks;
+
+	// bytes written into each mapped buffer, per swapchain image
+	struct MappedBytesCounters {
+		TelemetryCounter vertex;
+		TelemetryCounter color;
+		TelemetryCounter uniform;
+	};
+	std::vector<MappedBytesCounters> mMappedBytes;
+	TelemetryHistogram mFrameBytes;
+
     MemoryMappedBuffer<VertexBufferElement> mVertexBuffer { vk::BufferUsageFlagBits::eVertexBuffer };
     MemoryMappedBuffer<ColorBufferElement> mColorBuffer2 { vk::BufferUsageFlagBits::eStorageBuffer };
     MemoryMappedBuffer<UnformBuffer> mUniformBuffer { vk::BufferUsageFlagBits::eUniformBuffer };
@@ -72,6 +121,14 @@ private:
 
 	void recordCommands(RenderEngineInterface& engine);
 
+	void stageVertices();
+	void stageColors();
+	void stageUniforms();
+
+	void copyVertexStaging(std::span<VertexBufferElement> data);
+	void copyColorStaging(std::span<ColorBufferElement> data);
+	void copyUniformStaging(std::span<UnformBuffer> data);
+
 
 	std::span<char const> getVertexShaderCode() const;
 	std::span<char const> getGeometryShaderCode() const;
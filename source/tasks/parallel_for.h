@@ -0,0 +1,68 @@
+//
+// @file:   parallel_for.h
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Splits a range into chunks and runs them on all cores
+//
+
+#pragma once
+
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
+
+// number of chunks the functions below split [0, size) into, at most one per core
+inline size_t getParallelChunkCount(size_t const size, size_t const minChunkSize)
+{
+    size_t const threads = getThreadPool().getThreadCount();
+    return std::min(threads, std::max<size_t>(1, size / std::max<size_t>(minChunkSize, 1)));
+}
+
+// calls function(chunk, begin, end) for chunks of [0, size), the chunk index is below
+// getParallelChunkCount, so every chunk can write its own partial result without locks.
+// The chunks run on the thread pool, called from a task the waiting thread keeps running tasks
+template<typename TFunction>
+void parallelForChunks(size_t const size, size_t const minChunkSize, TFunction && function)
+{
+    size_t const chunks = getParallelChunkCount(size, minChunkSize);
+
+    if(chunks <= 1) {
+        function(size_t(0), size_t(0), size);
+        return;
+    }
+
+    struct Context {
+        std::remove_reference_t<TFunction> * function;
+        size_t size;
+        size_t chunkSize;
+    };
+    Context context = { &function, size, (size + chunks - 1) / chunks };
+
+    auto const runChunk = [](void * const data, size_t const chunk) {
+        auto const & shared = *static_cast<Context const *>(data);
+        size_t const begin = std::min(shared.size, chunk * shared.chunkSize);
+        size_t const end = std::min(shared.size, begin + shared.chunkSize);
+        (*shared.function)(chunk, begin, end);
+    };
+
+    auto & pool = getThreadPool();
+    TaskCounter pending = chunks - 1;
+    for(size_t chunk = 1; chunk < chunks; ++chunk) {
+        pool.submit({ runChunk, &context, chunk, &pending });
+    }
+
+    runChunk(&context, 0);
+    pool.wait(pending);
+}
+
+// calls function(begin, end) for chunks of [0, size), small ranges stay on the calling thread
+template<typename TFunction>
+void parallelFor(size_t const size, size_t const minChunkSize, TFunction && function)
+{
+    parallelForChunks(size, minChunkSize, [&function](size_t, size_t const begin, size_t const end) {
+        function(begin, end);
+    });
+}
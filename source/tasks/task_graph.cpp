@@ -0,0 +1,102 @@
+//
+// @file:   task_graph.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Tasks with dependencies, run on the work stealing thread pool
+//
+
+#include "task_graph.h"
+
+#include <stdexcept>
+
+
+TaskGraph::TaskId TaskGraph::add(std::function<void()> function, std::span<TaskId const> const dependencies)
+{
+    TaskId const id = static_cast<TaskId>(mNodes.size());
+    for(auto const dependency : dependencies) {
+        if(dependency >= id) {
+            throw std::invalid_argument("TaskGraph: dependency on a task that is not added yet");
+        }
+    }
+
+    for(auto const dependency : dependencies) {
+        mNodes[dependency].successors.push_back(id);
+    }
+
+    Node node;
+    node.function = std::move(function);
+    node.dependencyCount = static_cast<uint32_t>(dependencies.size());
+    mNodes.push_back(std::move(node));
+
+    return id;
+}
+
+TaskGraph::TaskId TaskGraph::add(std::function<void()> function, std::initializer_list<TaskId> const dependencies)
+{
+    return add(std::move(function), std::span<TaskId const>(dependencies.begin(), dependencies.size()));
+}
+
+void TaskGraph::clear()
+{
+    mNodes.clear();
+}
+
+size_t TaskGraph::size() const
+{
+    return mNodes.size();
+}
+
+bool TaskGraph::empty() const
+{
+    return mNodes.empty();
+}
+
+void TaskGraph::run(ThreadPool & pool)
+{
+    if(mNodes.empty()) {
+        return;
+    }
+
+    if(mRemainingSize < mNodes.size()) {
+        mRemaining = std::make_unique<std::atomic<uint32_t>[]>(mNodes.size());
+        mRemainingSize = mNodes.size();
+    }
+
+    for(size_t i = 0; i < mNodes.size(); ++i) {
+        mRemaining[i].store(mNodes[i].dependencyCount, std::memory_order_relaxed);
+    }
+
+    mPool = &pool;
+    mPending.store(mNodes.size(), std::memory_order_relaxed);
+
+    for(TaskId task = 0; task < mNodes.size(); ++task) {
+        if(mNodes[task].dependencyCount == 0) {
+            submit(task);
+        }
+    }
+
+    pool.wait(mPending);
+    mPool = nullptr;
+}
+
+void TaskGraph::submit(TaskId const task)
+{
+    mPool->submit({ &TaskGraph::runTask, this, task, &mPending });
+}
+
+void TaskGraph::runTask(void * const data, size_t const task)
+{
+    auto & graph = *static_cast<TaskGraph*>(data);
+    auto const & node = graph.mNodes[task];
+
+    if(node.function) {
+        node.function();
+    }
+
+    // the last dependency to finish starts the task, acq_rel hands over what the others wrote
+    for(auto const successor : node.successors) {
+        if(graph.mRemaining[successor].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            graph.submit(successor);
+        }
+    }
+}
@@ -0,0 +1,62 @@
+//
+// @file:   task_graph.h
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Tasks with dependencies, run on the work stealing thread pool
+//
+
+#pragma once
+
+#include "thread_pool.h"
+
+#include <functional>
+#include <initializer_list>
+#include <span>
+
+
+//
+// @class:  TaskGraph
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  A task starts as soon as all tasks it depends on finished, tasks
+//          without a path between them run in parallel. Dependencies can
+//          only point to tasks added before, so the graph has no cycles.
+//          The graph is kept between runs, a frame builds it once and runs
+//          it every frame, run() returns after the last task finished.
+//
+class TaskGraph
+{
+public:
+    using TaskId = uint32_t;
+
+    // throws std::invalid_argument for a dependency that is not added yet
+    TaskId add(std::function<void()> function, std::span<TaskId const> const dependencies);
+    TaskId add(std::function<void()> function, std::initializer_list<TaskId> const dependencies = {});
+
+    void clear();
+
+    size_t size() const;
+    bool empty() const;
+
+    // runs every task once, the calling thread runs tasks too, not reentrant
+    void run(ThreadPool & pool = getThreadPool());
+
+private:
+    struct Node {
+        std::function<void()> function;
+        std::vector<TaskId> successors;
+        uint32_t dependencyCount = 0;
+    };
+
+    std::vector<Node> mNodes;
+
+    // dependencies not yet finished per task during a run
+    std::unique_ptr<std::atomic<uint32_t>[]> mRemaining;
+    size_t mRemainingSize = 0;
+
+    ThreadPool * mPool = nullptr;
+    TaskCounter mPending = 0;
+
+    void submit(TaskId const task);
+    static void runTask(void * graph, size_t const task);
+};
@@ -0,0 +1,218 @@
+//
+// @file:   thread_pool.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Work stealing thread pool shared by the parallel loops and task graphs
+//
+
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <limits>
+
+
+namespace {
+
+constexpr size_t noWorker = std::numeric_limits<size_t>::max();
+
+// the pool and worker index of the calling thread, noWorker for threads outside a pool
+thread_local ThreadPool const * tPool = nullptr;
+thread_local size_t tWorker = noWorker;
+
+// threads of the shared pool, 0 for one per core, see setThreadPoolSize
+std::atomic<size_t> gThreadPoolSize = 0;
+std::atomic<bool> gThreadPoolCreated = false;
+
+}
+
+
+ThreadPool::ThreadPool(size_t const workerCount)
+{
+    mWorkers.reserve(workerCount);
+    for(size_t i = 0; i < workerCount; ++i) {
+        mWorkers.push_back(std::make_unique<Worker>());
+    }
+
+    mThreads.reserve(workerCount);
+    for(size_t i = 0; i < workerCount; ++i) {
+        mThreads.emplace_back([this, i]() { work(i); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard const lock(mSleepMutex);
+        mStop = true;
+    }
+    mWake.notify_all();
+    mThreads.clear();
+}
+
+size_t ThreadPool::getWorkerCount() const
+{
+    return mWorkers.size();
+}
+
+size_t ThreadPool::getThreadCount() const
+{
+    return mWorkers.size() + 1;
+}
+
+void ThreadPool::submit(PoolTask const & task)
+{
+    // counted first, a worker that wakes up too early only looks once more
+    mQueued.fetch_add(1);
+
+    if(tPool == this) {
+        auto & worker = *mWorkers[tWorker];
+        std::lock_guard const lock(worker.mutex);
+        worker.tasks.push_back(task);
+    }
+    else {
+        std::lock_guard const lock(mSharedMutex);
+        mShared.push_back(task);
+    }
+
+    // a worker that went to sleep has either seen the count or is woken here
+    if(mSleeping.load() > 0) {
+        { std::lock_guard const lock(mSleepMutex); }
+        mWake.notify_one();
+    }
+
+    // so do the waiting threads, which help with the new task
+    if(mWaiting.load() > 0) {
+        { std::lock_guard const lock(mSleepMutex); }
+        mDone.notify_all();
+    }
+}
+
+void ThreadPool::wait(TaskCounter const & counter)
+{
+    while(counter.load(std::memory_order_acquire) != 0)
+    {
+        if(runOne()) {
+            continue;
+        }
+
+        // the last task of the counter either sees mWaiting or runs before the predicate is checked
+        std::unique_lock lock(mSleepMutex);
+        mWaiting.fetch_add(1);
+        mDone.wait(lock, [&]() { return counter.load() == 0 || mQueued.load() > 0; });
+        mWaiting.fetch_sub(1);
+    }
+}
+
+bool ThreadPool::runOne()
+{
+    PoolTask task;
+    if(!take(tPool == this ? tWorker : noWorker, task)) {
+        return false;
+    }
+
+    execute(task);
+    return true;
+}
+
+void ThreadPool::work(size_t const worker)
+{
+    tPool = this;
+    tWorker = worker;
+
+    PoolTask task;
+    while(!mStop.load(std::memory_order_relaxed))
+    {
+        if(take(worker, task)) {
+            execute(task);
+            continue;
+        }
+
+        std::unique_lock lock(mSleepMutex);
+        mSleeping.fetch_add(1);
+        mWake.wait(lock, [this]() { return mStop.load() || mQueued.load() > 0; });
+        mSleeping.fetch_sub(1);
+    }
+}
+
+bool ThreadPool::take(size_t const worker, PoolTask & task)
+{
+    if(mQueued.load(std::memory_order_relaxed) == 0) {
+        return false;
+    }
+
+    // newest own task first, its data is likely still in the cache
+    if(worker != noWorker)
+    {
+        auto & own = *mWorkers[worker];
+        std::lock_guard const lock(own.mutex);
+        if(!own.tasks.empty()) {
+            task = own.tasks.back();
+            own.tasks.pop_back();
+            mQueued.fetch_sub(1);
+            return true;
+        }
+    }
+
+    {
+        std::lock_guard const lock(mSharedMutex);
+        if(!mShared.empty()) {
+            task = mShared.front();
+            mShared.pop_front();
+            mQueued.fetch_sub(1);
+            return true;
+        }
+    }
+
+    return steal(worker == noWorker ? 0 : worker + 1, task);
+}
+
+bool ThreadPool::steal(size_t const thief, PoolTask & task)
+{
+    // oldest task of the victim, usually the biggest piece of work left
+    size_t const count = mWorkers.size();
+    for(size_t i = 0; i < count; ++i)
+    {
+        auto & victim = *mWorkers[(thief + i) % count];
+        std::lock_guard const lock(victim.mutex);
+        if(!victim.tasks.empty()) {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            mQueued.fetch_sub(1);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ThreadPool::execute(PoolTask const & task)
+{
+    TaskCounter * const counter = task.counter;
+    task.function(task.data, task.index);
+
+    // the waiting thread may release the data and the counter right after this
+    if(counter != nullptr && counter->fetch_sub(1) == 1 && mWaiting.load() > 0) {
+        { std::lock_guard const lock(mSleepMutex); }
+        mDone.notify_all();
+    }
+}
+
+bool setThreadPoolSize(size_t const threadCount)
+{
+    if(gThreadPoolCreated.load()) {
+        return false;
+    }
+
+    gThreadPoolSize.store(threadCount);
+    return true;
+}
+
+ThreadPool& getThreadPool()
+{
+    static ThreadPool pool([]() {
+        gThreadPoolCreated.store(true);
+        size_t const threads = gThreadPoolSize.load();
+        return (threads > 0 ? threads : std::max<size_t>(1, std::thread::hardware_concurrency())) - 1;
+    }());
+    return pool;
+}
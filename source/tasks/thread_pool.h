@@ -0,0 +1,107 @@
+//
+// @file:   thread_pool.h
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Work stealing thread pool shared by the parallel loops and task graphs
+//
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+// tasks still to run, wait() returns when it reaches zero
+using TaskCounter = std::atomic<size_t>;
+
+//
+// @struct: PoolTask
+// @brief:  A function pointer with its argument, so submitting a task
+//          never allocates a closure. The counter is decremented after
+//          the function returned.
+//
+struct PoolTask
+{
+    void (*function)(void * data, size_t index) = nullptr;
+    void * data = nullptr;
+    size_t index = 0;
+    TaskCounter * counter = nullptr;
+};
+
+
+//
+// @class:  ThreadPool
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Every worker owns a deque, it pushes and pops its own tasks at
+//          the back and steals from the front of the others when it runs
+//          dry. Tasks submitted by other threads go to a shared queue.
+//          A thread that waits for a counter runs tasks meanwhile, so a
+//          task may wait for tasks of its own without blocking the pool.
+//          With nothing left to run it sleeps until the counter reaches
+//          zero or another task is submitted. Tasks must not throw.
+//
+class ThreadPool
+{
+public:
+    explicit ThreadPool(size_t const workerCount);
+    ~ThreadPool();
+
+    ThreadPool(ThreadPool const &) = delete;
+    ThreadPool& operator=(ThreadPool const &) = delete;
+
+    size_t getWorkerCount() const;
+
+    // workers and the thread that waits
+    size_t getThreadCount() const;
+
+    void submit(PoolTask const & task);
+
+    // runs tasks until counter is zero, sleeps while there are none
+    void wait(TaskCounter const & counter);
+
+    // runs one queued task, false if there was none
+    bool runOne();
+
+private:
+    struct alignas(64) Worker {
+        std::mutex mutex;
+        std::deque<PoolTask> tasks;
+    };
+
+    std::vector<std::unique_ptr<Worker>> mWorkers;
+    std::vector<std::jthread> mThreads;
+
+    std::mutex mSharedMutex;
+    std::deque<PoolTask> mShared;
+
+    // submitted and not yet taken, the workers sleep while it is zero
+    std::atomic<size_t> mQueued = 0;
+    std::atomic<size_t> mSleeping = 0;
+    std::atomic<bool> mStop = false;
+    std::mutex mSleepMutex;
+    std::condition_variable mWake;
+
+    // threads in wait() with nothing to run, woken by a counter reaching zero or a submit
+    std::atomic<size_t> mWaiting = 0;
+    std::condition_variable mDone;
+
+    void work(size_t const worker);
+    bool take(size_t const worker, PoolTask & task);
+    bool steal(size_t const thief, PoolTask & task);
+    void execute(PoolTask const & task);
+};
+
+// threads of the pool of getThreadPool, the calling thread included, 0 for one per core.
+// Only before the first getThreadPool, false once the pool exists
+bool setThreadPoolSize(size_t const threadCount);
+
+// one worker per core besides the calling thread, or as set by setThreadPoolSize
+ThreadPool& getThreadPool();
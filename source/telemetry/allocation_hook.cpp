@@ -0,0 +1,147 @@
+//
+// @file:   allocation_hook.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Replaces the global operator new to count heap allocations,
+//          over-aligned ones included
+//
+
+#include "telemetry.h"
+
+// off by default, every allocation then pays for two counters and a histogram
+#ifdef WSS_TELEMETRY_ALLOCATIONS
+
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+
+namespace {
+
+// alignments above the one of malloc, e.g. of alignas(64) types, nullptr on failure
+void * allocateAligned(size_t const size, std::align_val_t const alignment)
+{
+#ifdef _WIN32
+    // memory of the msvc heap functions can not be freed with free
+    return _aligned_malloc(size > 0 ? size : 1, static_cast<size_t>(alignment));
+#else
+    void * pointer = nullptr;
+    return posix_memalign(&pointer, static_cast<size_t>(alignment), size > 0 ? size : 1) == 0 ? pointer : nullptr;
+#endif
+}
+
+void freeAligned(void * const pointer)
+{
+#ifdef _WIN32
+    _aligned_free(pointer);
+#else
+    std::free(pointer);
+#endif
+}
+
+}
+
+void * operator new(size_t const size)
+{
+    void * const pointer = std::malloc(size > 0 ? size : 1);
+    if(pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    recordTelemetryAllocation(size);
+    return pointer;
+}
+
+void * operator new[](size_t const size)
+{
+    return operator new(size);
+}
+
+void * operator new(size_t const size, std::nothrow_t const &) noexcept
+{
+    void * const pointer = std::malloc(size > 0 ? size : 1);
+    if(pointer != nullptr) {
+        recordTelemetryAllocation(size);
+    }
+    return pointer;
+}
+
+void * operator new[](size_t const size, std::nothrow_t const & tag) noexcept
+{
+    return operator new(size, tag);
+}
+
+void operator delete(void * const pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void * const pointer) noexcept
+{
+    operator delete(pointer);
+}
+
+void operator delete(void * const pointer, size_t) noexcept
+{
+    operator delete(pointer);
+}
+
+void operator delete[](void * const pointer, size_t) noexcept
+{
+    operator delete(pointer);
+}
+
+void * operator new(size_t const size, std::align_val_t const alignment)
+{
+    void * const pointer = allocateAligned(size, alignment);
+    if(pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    recordTelemetryAllocation(size);
+    return pointer;
+}
+
+void * operator new[](size_t const size, std::align_val_t const alignment)
+{
+    return operator new(size, alignment);
+}
+
+void * operator new(size_t const size, std::align_val_t const alignment, std::nothrow_t const &) noexcept
+{
+    void * const pointer = allocateAligned(size, alignment);
+    if(pointer != nullptr) {
+        recordTelemetryAllocation(size);
+    }
+    return pointer;
+}
+
+void * operator new[](size_t const size, std::align_val_t const alignment, std::nothrow_t const & tag) noexcept
+{
+    return operator new(size, alignment, tag);
+}
+
+void operator delete(void * const pointer, std::align_val_t) noexcept
+{
+    freeAligned(pointer);
+}
+
+void operator delete[](void * const pointer, std::align_val_t const alignment) noexcept
+{
+    operator delete(pointer, alignment);
+}
+
+void operator delete(void * const pointer, size_t, std::align_val_t const alignment) noexcept
+{
+    operator delete(pointer, alignment);
+}
+
+void operator delete[](void * const pointer, size_t, std::align_val_t const alignment) noexcept
+{
+    operator delete(pointer, alignment);
+}
+
+#endif
@@ -0,0 +1,308 @@
+//
+// @file:   telemetry.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Counters, gauges and histograms aggregated per thread without locks
+//
+
+#include "telemetry.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <new>
+#include <ostream>
+
+
+namespace {
+
+// set while the telemetry allocates, so the operator new hook does not record itself
+thread_local bool tInTelemetry = false;
+
+struct TelemetryScope
+{
+    bool const previous;
+
+    TelemetryScope() : previous(tInTelemetry) { tInTelemetry = true; }
+    ~TelemetryScope() { tInTelemetry = previous; }
+};
+
+std::chrono::steady_clock::time_point const startTime = std::chrono::steady_clock::now();
+
+}
+
+
+thread_local Telemetry::ShardHandle Telemetry::sShard;
+
+Telemetry::ShardHandle::~ShardHandle()
+{
+    if(shard != nullptr) {
+        getTelemetry().releaseShard(shard);
+    }
+}
+
+Telemetry & getTelemetry()
+{
+    // never destroyed, allocations may be recorded after main returned
+    alignas(Telemetry) static unsigned char storage[sizeof(Telemetry)];
+    static Telemetry * const telemetry = new (storage) Telemetry();
+    return *telemetry;
+}
+
+Telemetry::Telemetry()
+{
+    TelemetryScope scope;
+
+    // id 0 of every kind is an unnamed sink for default constructed handles and full registries
+    mCounterNames.emplace_back();
+    mGaugeNames.emplace_back();
+    mHistogramNames.emplace_back();
+
+    for(auto & gauge : mGauges) {
+        gauge.store(0, std::memory_order_relaxed);
+    }
+    for(auto & shard : mShards) {
+        shard.store(nullptr, std::memory_order_relaxed);
+    }
+
+    mOverflow = new Shard();
+    mOverflow->used.store(true, std::memory_order_relaxed);
+    mOverflow->shared = true;
+}
+
+uint32_t Telemetry::registerName(std::vector<std::string> & names, std::string const & name, uint32_t const max)
+{
+    TelemetryScope scope;
+    std::lock_guard lock(mMutex);
+
+    auto it = std::find(names.begin() + 1, names.end(), name);
+    if(it != names.end()) {
+        return static_cast<uint32_t>(it - names.begin());
+    }
+
+    if(names.size() >= max || name.empty()) {
+        return 0;
+    }
+
+    names.push_back(name);
+    return static_cast<uint32_t>(names.size() - 1);
+}
+
+TelemetryCounter Telemetry::getCounter(std::string const & name)
+{
+    TelemetryCounter counter;
+    counter.mId = registerName(mCounterNames, name, maxCounters);
+    return counter;
+}
+
+TelemetryGauge Telemetry::getGauge(std::string const & name)
+{
+    TelemetryGauge gauge;
+    gauge.mId = registerName(mGaugeNames, name, maxGauges);
+    return gauge;
+}
+
+TelemetryHistogram Telemetry::getHistogram(std::string const & name)
+{
+    TelemetryHistogram histogram;
+    histogram.mId = registerName(mHistogramNames, name, maxHistograms);
+    return histogram;
+}
+
+Telemetry::Shard & Telemetry::getShard()
+{
+    if(sShard.shard == nullptr) {
+        sShard.shard = acquireShard();
+    }
+    return *sShard.shard;
+}
+
+Telemetry::Shard * Telemetry::acquireShard()
+{
+    TelemetryScope scope;
+    std::lock_guard lock(mMutex);
+
+    // shards of finished threads first, their counts stay part of the totals
+    uint32_t const count = mShardCount.load(std::memory_order_relaxed);
+    for(uint32_t i = 0; i < count; ++i)
+    {
+        Shard * const shard = mShards[i].load(std::memory_order_relaxed);
+        if(!shard->used.load(std::memory_order_acquire)) {
+            shard->used.store(true, std::memory_order_relaxed);
+            return shard;
+        }
+    }
+
+    if(count == maxShards) {
+        return mOverflow;
+    }
+
+    Shard * const shard = new Shard();
+    shard->used.store(true, std::memory_order_relaxed);
+    mShards[count].store(shard, std::memory_order_release);
+    mShardCount.store(count + 1, std::memory_order_release);
+    return shard;
+}
+
+void Telemetry::releaseShard(Shard * const shard)
+{
+    if(shard != mOverflow) {
+        shard->used.store(false, std::memory_order_release);
+    }
+}
+
+TelemetrySnapshot Telemetry::getSnapshot() const
+{
+    TelemetryScope scope;
+    std::lock_guard lock(mMutex);
+
+    TelemetrySnapshot snapshot;
+    snapshot.time = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    std::vector<Shard const *> shards = { mOverflow };
+    uint32_t const count = mShardCount.load(std::memory_order_acquire);
+    for(uint32_t i = 0; i < count; ++i) {
+        shards.push_back(mShards[i].load(std::memory_order_acquire));
+    }
+
+    for(size_t id = 1; id < mCounterNames.size(); ++id)
+    {
+        uint64_t sum = 0;
+        for(auto const * shard : shards) {
+            sum += shard->counters[id].load(std::memory_order_relaxed);
+        }
+        snapshot.counters.push_back({ mCounterNames[id], static_cast<int64_t>(sum) });
+    }
+
+    for(size_t id = 1; id < mGaugeNames.size(); ++id) {
+        snapshot.gauges.push_back({ mGaugeNames[id], mGauges[id].load(std::memory_order_relaxed) });
+    }
+
+    for(size_t id = 1; id < mHistogramNames.size(); ++id)
+    {
+        TelemetrySnapshot::Histogram histogram;
+        histogram.name = mHistogramNames[id];
+        histogram.buckets.resize(histogramBuckets);
+
+        for(auto const * shard : shards)
+        {
+            histogram.sum += shard->sums[id].load(std::memory_order_relaxed);
+            for(uint32_t bucket = 0; bucket < histogramBuckets; ++bucket) {
+                histogram.buckets[bucket] += shard->buckets[id][bucket].load(std::memory_order_relaxed);
+            }
+        }
+
+        for(auto const bucket : histogram.buckets) {
+            histogram.count += bucket;
+        }
+
+        snapshot.histograms.push_back(std::move(histogram));
+    }
+
+    return snapshot;
+}
+
+void TelemetryCounter::add(uint64_t const value) const
+{
+    auto & shard = getTelemetry().getShard();
+    shard.add(shard.counters[mId], value);
+}
+
+void TelemetryGauge::set(int64_t const value) const
+{
+    getTelemetry().mGauges[mId].store(value, std::memory_order_relaxed);
+}
+
+void TelemetryHistogram::record(uint64_t const value) const
+{
+    auto & shard = getTelemetry().getShard();
+    shard.add(shard.buckets[mId][std::bit_width(value)], 1);
+    shard.add(shard.sums[mId], value);
+}
+
+uint64_t TelemetrySnapshot::Histogram::getQuantile(double const quantile) const
+{
+    if(count == 0) {
+        return 0;
+    }
+
+    uint64_t const rank = static_cast<uint64_t>(std::clamp(quantile, 0.0, 1.0) * static_cast<double>(count - 1));
+    uint64_t seen = 0;
+    for(size_t bucket = 0; bucket < buckets.size(); ++bucket)
+    {
+        seen += buckets[bucket];
+        if(seen > rank) {
+            return bucket == 0 ? 0 : (bucket >= 64 ? UINT64_MAX : (uint64_t(1) << bucket) - 1);
+        }
+    }
+    return UINT64_MAX;
+}
+
+void recordTelemetryAllocation(size_t const size)
+{
+    if(tInTelemetry) {
+        return;
+    }
+    TelemetryScope scope;
+
+    static TelemetryCounter const allocations = getTelemetry().getCounter("heap.allocations");
+    static TelemetryCounter const bytes = getTelemetry().getCounter("heap.allocated_bytes");
+    static TelemetryHistogram const sizes = getTelemetry().getHistogram("heap.allocation_size");
+
+    allocations.add();
+    bytes.add(size);
+    sizes.record(size);
+}
+
+void writeTelemetryCsv(std::ostream & out, TelemetrySnapshot const & snapshot, bool const header)
+{
+    if(header) {
+        out << "time,type,name,value,count,sum,p50,p99\n";
+    }
+
+    for(auto const & counter : snapshot.counters) {
+        out << snapshot.time << ",counter," << counter.name << ',' << counter.value << ",,,,\n";
+    }
+    for(auto const & gauge : snapshot.gauges) {
+        out << snapshot.time << ",gauge," << gauge.name << ',' << gauge.value << ",,,,\n";
+    }
+    for(auto const & histogram : snapshot.histograms) {
+        out << snapshot.time << ",histogram," << histogram.name << ",," << histogram.count << ',' << histogram.sum << ','
+            << histogram.getQuantile(0.5) << ',' << histogram.getQuantile(0.99) << '\n';
+    }
+}
+
+void writeTelemetryJson(std::ostream & out, TelemetrySnapshot const & snapshot)
+{
+    out << "{\"time\":" << snapshot.time;
+
+    out << ",\"counters\":{";
+    for(size_t i = 0; i < snapshot.counters.size(); ++i) {
+        out << (i ? "," : "") << '"' << snapshot.counters[i].name << "\":" << snapshot.counters[i].value;
+    }
+
+    out << "},\"gauges\":{";
+    for(size_t i = 0; i < snapshot.gauges.size(); ++i) {
+        out << (i ? "," : "") << '"' << snapshot.gauges[i].name << "\":" << snapshot.gauges[i].value;
+    }
+
+    out << "},\"histograms\":{";
+    for(size_t i = 0; i < snapshot.histograms.size(); ++i)
+    {
+        auto const & histogram = snapshot.histograms[i];
+        out << (i ? "," : "") << '"' << histogram.name << "\":{\"count\":" << histogram.count << ",\"sum\":" << histogram.sum
+            << ",\"p50\":" << histogram.getQuantile(0.5) << ",\"p99\":" << histogram.getQuantile(0.99) << ",\"buckets\":[";
+
+        // trailing empty buckets are left out
+        size_t last = histogram.buckets.size();
+        while(last > 0 && histogram.buckets[last - 1] == 0) {
+            last--;
+        }
+        for(size_t bucket = 0; bucket < last; ++bucket) {
+            out << (bucket ? "," : "") << histogram.buckets[bucket];
+        }
+        out << "]}";
+    }
+
+    out << "}}\n";
+}
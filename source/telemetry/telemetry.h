@@ -0,0 +1,164 @@
+//
+// @file:   telemetry.h
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Counters, gauges and histograms aggregated per thread without locks
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <vector>
+
+
+// handles are cheap to copy, look them up once and keep them
+class TelemetryCounter
+{
+public:
+    void add(uint64_t const value = 1) const;
+
+private:
+    friend class Telemetry;
+    uint32_t mId = 0;
+};
+
+class TelemetryGauge
+{
+public:
+    void set(int64_t const value) const;
+
+private:
+    friend class Telemetry;
+    uint32_t mId = 0;
+};
+
+// log2 buckets, bucket k counts the values with bit width k
+class TelemetryHistogram
+{
+public:
+    void record(uint64_t const value) const;
+
+private:
+    friend class Telemetry;
+    uint32_t mId = 0;
+};
+
+struct TelemetrySnapshot
+{
+    struct Value {
+        std::string name;
+        int64_t value;
+    };
+
+    struct Histogram {
+        std::string name;
+        uint64_t count = 0;
+        uint64_t sum = 0;
+        std::vector<uint64_t> buckets;
+
+        // upper bound of the bucket that holds the quantile
+        uint64_t getQuantile(double const quantile) const;
+    };
+
+    double time = 0.0;          // seconds since the start of the process
+    std::vector<Value> counters;
+    std::vector<Value> gauges;
+    std::vector<Histogram> histograms;
+};
+
+//
+// @class:  Telemetry
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Every thread writes to its own shard of relaxed atomics, so
+//          recording never takes a lock and never shares a cache line with
+//          another thread. getSnapshot() sums all shards. Shards of finished
+//          threads are handed to new threads and keep their counts.
+//          Metrics are registered by name, the same name gives the same
+//          metric. The object is never destroyed, so it can be used from
+//          operator new and from static destructors.
+//
+class Telemetry
+{
+public:
+    static constexpr uint32_t maxCounters = 256;
+    static constexpr uint32_t maxGauges = 64;
+    static constexpr uint32_t maxHistograms = 64;
+    static constexpr uint32_t histogramBuckets = 65;
+    static constexpr uint32_t maxShards = 1024;
+
+    TelemetryCounter getCounter(std::string const & name);
+    TelemetryGauge getGauge(std::string const & name);
+    TelemetryHistogram getHistogram(std::string const & name);
+
+    TelemetrySnapshot getSnapshot() const;
+
+private:
+    friend class TelemetryCounter;
+    friend class TelemetryGauge;
+    friend class TelemetryHistogram;
+    friend Telemetry & getTelemetry();
+
+    struct alignas(64) Shard {
+        std::array<std::atomic<uint64_t>, maxCounters> counters;
+        std::array<std::array<std::atomic<uint64_t>, histogramBuckets>, maxHistograms> buckets;
+        std::array<std::atomic<uint64_t>, maxHistograms> sums;
+        std::atomic<bool> used;
+        bool shared = false;            // the overflow shard has several writers
+
+        // one writer per shard, so no read modify write is needed
+        void add(std::atomic<uint64_t> & slot, uint64_t const value) {
+            if(shared) {
+                slot.fetch_add(value, std::memory_order_relaxed);
+            }
+            else {
+                slot.store(slot.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    // gives the shard back when the thread ends
+    struct ShardHandle {
+        Shard * shard = nullptr;
+        ~ShardHandle();
+    };
+
+    static thread_local ShardHandle sShard;
+
+    Telemetry();
+
+    mutable std::mutex mMutex;
+    std::vector<std::string> mCounterNames;
+    std::vector<std::string> mGaugeNames;
+    std::vector<std::string> mHistogramNames;
+
+    std::array<std::atomic<int64_t>, maxGauges> mGauges;
+
+    std::array<std::atomic<Shard *>, maxShards> mShards;
+    std::atomic<uint32_t> mShardCount = 0;
+
+    // shared by the threads that find no free shard
+    Shard * mOverflow = nullptr;
+
+    uint32_t registerName(std::vector<std::string> & names, std::string const & name, uint32_t const max);
+
+    Shard & getShard();
+    Shard * acquireShard();
+    void releaseShard(Shard * const shard);
+};
+
+Telemetry & getTelemetry();
+
+// one line per metric: time,type,name,value,count,sum,p50,p99
+void writeTelemetryCsv(std::ostream & out, TelemetrySnapshot const & snapshot, bool const header);
+
+// one json object per snapshot and line
+void writeTelemetryJson(std::ostream & out, TelemetrySnapshot const & snapshot);
+
+// records an allocation of the operator new hook, ignores allocations made by the telemetry itself
+void recordTelemetryAllocation(size_t const size);
@@ -0,0 +1,63 @@
+//
+// @file:   telemetry_writer.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Appends telemetry snapshots to a file in a fixed interval
+//
+
+#include "telemetry_writer.h"
+#include "telemetry.h"
+
+
+TelemetryWriter::TelemetryWriter(std::string const & filename, std::chrono::milliseconds const interval)
+    : mFile(filename),
+      mJson(filename.size() >= 5 && filename.compare(filename.size() - 5, 5, ".json") == 0),
+      mInterval(interval)
+{
+    if(mFile.is_open()) {
+        mThread = std::jthread([this](std::stop_token const stop) { run(stop); });
+    }
+}
+
+TelemetryWriter::~TelemetryWriter()
+{
+    if(mThread.joinable())
+    {
+        mThread.request_stop();
+        mThread.join();
+        write();
+    }
+}
+
+bool TelemetryWriter::opened() const
+{
+    return mFile.is_open();
+}
+
+void TelemetryWriter::write()
+{
+    auto const snapshot = getTelemetry().getSnapshot();
+
+    if(mJson) {
+        writeTelemetryJson(mFile, snapshot);
+    }
+    else {
+        writeTelemetryCsv(mFile, snapshot, mHeader);
+    }
+
+    mHeader = false;
+    mFile.flush();
+}
+
+void TelemetryWriter::run(std::stop_token const stop)
+{
+    std::unique_lock lock(mMutex);
+    while(!stop.stop_requested())
+    {
+        // wakes up early when a stop is requested, the destructor writes the last snapshot
+        mWakeUp.wait_for(lock, stop, mInterval, []() { return false; });
+        if(!stop.stop_requested()) {
+            write();
+        }
+    }
+}
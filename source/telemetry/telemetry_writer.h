@@ -0,0 +1,49 @@
+//
+// @file:   telemetry_writer.h
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Appends telemetry snapshots to a file in a fixed interval
+//
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+
+//
+// @class:  TelemetryWriter
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Writes a snapshot of getTelemetry() every interval on its own
+//          thread and a last one when it is destroyed. Files ending in
+//          .json get one json object per line, all others csv.
+//
+class TelemetryWriter
+{
+public:
+    TelemetryWriter(std::string const & filename, std::chrono::milliseconds const interval);
+    ~TelemetryWriter();
+
+    TelemetryWriter(TelemetryWriter const &) = delete;
+    TelemetryWriter& operator=(TelemetryWriter const &) = delete;
+
+    bool opened() const;
+
+private:
+    std::ofstream mFile;
+    bool const mJson;
+    bool mHeader = true;
+    std::chrono::milliseconds const mInterval;
+
+    std::mutex mMutex;
+    std::condition_variable_any mWakeUp;
+    std::jthread mThread;
+
+    void write();
+    void run(std::stop_token const stop);
+};
@@ -0,0 +1,140 @@
+//
+// @file:   world.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Mesh, cell graph and per cell fields of a world
+//
+
+#include "world.h"
+#include "geometry/sphere.h"
+#include "telemetry/telemetry.h"
+
+
+WorldFieldView const * WorldView::findField(std::string_view const name) const
+{
+    for(auto const & field : fields) {
+        if(field.name == name) {
+            return &field;
+        }
+    }
+
+    return nullptr;
+}
+
+WorldField& World::addField(std::string const & name, uint32_t const components, float const value)
+{
+    WorldField field;
+    field.name = name;
+    field.components = components;
+    field.values.assign(getCellCount() * components, value);
+
+    fields.push_back(std::move(field));
+    return fields.back();
+}
+
+WorldField& World::addParticleAttribute(std::string const & name, uint32_t const components, float const value)
+{
+    WorldField attribute;
+    attribute.name = name;
+    attribute.components = components;
+    attribute.values.assign(particleCount * components, value);
+
+    particleAttributes.push_back(std::move(attribute));
+    return particleAttributes.back();
+}
+
+WorldView World::getView() const
+{
+    WorldView view;
+    view.vertices = vertices;
+    view.indices = indices;
+    view.adjacencyOffsets = adjacencyOffsets;
+    view.adjacency = adjacency;
+    view.tick = tick;
+    view.time = time;
+
+    for(auto const & field : fields) {
+        view.fields.push_back({field.name, field.components, field.values});
+    }
+
+    return view;
+}
+
+std::vector<glm::vec3> World::getTriangles() const
+{
+    std::vector<glm::vec3> res;
+    res.reserve(indices.size());
+
+    for(auto const index : indices) {
+        res.push_back(vertices[index]);
+    }
+
+    return res;
+}
+
+glm::vec3 getCellDirection(WorldView const & world, size_t const cell)
+{
+    auto const * const quad = &world.indices[cell * 6];
+    glm::vec3 const sum = world.vertices[quad[0]] + world.vertices[quad[1]] + world.vertices[quad[2]] + world.vertices[quad[3]];
+
+    float const length = glm::length(sum);
+    float const radius = glm::length(world.vertices[quad[0]]);
+    return length > 1e-6f * radius ? sum / length : world.vertices[quad[0]] / radius;
+}
+
+World createSphereWorld(float const r, size_t const n)
+{
+    World world;
+
+    MonotonicArena arena(getSphereVerticesBytes(n));
+    world.vertices.reserve(n * n);
+    for(auto const & row : createSphereVertices(r, n, &arena)) {
+        world.vertices.insert(world.vertices.end(), row.begin(), row.end());
+    }
+
+    // same vertex order as createSphereTriangles
+    auto const index = [n](size_t const j, size_t const i) {
+        return static_cast<uint32_t>((j % n) * n + (i % n));
+    };
+
+    world.indices.reserve(n * n * 6);
+    for(size_t j = 0; j < n; ++j) {
+        for(size_t i = 0; i < n; ++i) {
+            world.indices.push_back(index(j, i));
+            world.indices.push_back(index(j+1, i));
+            world.indices.push_back(index(j, i+1));
+
+            world.indices.push_back(index(j+1, i+1));
+            world.indices.push_back(index(j, i+1));
+            world.indices.push_back(index(j+1, i));
+        }
+    }
+
+    // cell j * n + i, neighbours wrap in longitude and stop at the poles
+    world.adjacencyOffsets.reserve(n * n + 1);
+    world.adjacency.reserve(n * n * 4);
+    world.adjacencyOffsets.push_back(0);
+    for(size_t j = 0; j < n; ++j) {
+        for(size_t i = 0; i < n; ++i) {
+            if(j > 0) {
+                world.adjacency.push_back(index(j-1, i));
+            }
+            world.adjacency.push_back(index(j, i+n-1));
+            world.adjacency.push_back(index(j, i+1));
+            if(j + 1 < n) {
+                world.adjacency.push_back(index(j+1, i));
+            }
+
+            world.adjacencyOffsets.push_back(static_cast<uint32_t>(world.adjacency.size()));
+        }
+    }
+
+    size_t const meshBytes = world.vertices.size() * sizeof(glm::vec3) + world.indices.size() * sizeof(uint32_t)
+        + world.adjacencyOffsets.size() * sizeof(uint32_t) + world.adjacency.size() * sizeof(uint32_t);
+
+    auto & telemetry = getTelemetry();
+    telemetry.getGauge("world.cells").set(static_cast<int64_t>(world.getCellCount()));
+    telemetry.getGauge("world.mesh_bytes").set(static_cast<int64_t>(meshBytes));
+
+    return world;
+}
@@ -0,0 +1,108 @@
+//
+// @file:   world.h
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Mesh, cell graph and per cell fields of a world
+//
+
+#pragma once
+
+#include "include_glm.h"
+
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+
+//
+// @struct: WorldFieldView
+// @brief:  A per cell field, components values per cell
+//
+struct WorldFieldView
+{
+    std::string_view name;
+    uint32_t components = 1;
+    std::span<float const> values;
+};
+
+//
+// @struct: WorldView
+// @brief:  Non owning view of a world, either from a World or from a mapped snapshot
+//
+struct WorldView
+{
+    std::span<glm::vec3 const> vertices;
+    std::span<uint32_t const> indices;              // 6 per cell
+
+    std::span<uint32_t const> adjacencyOffsets;     // cell count + 1
+    std::span<uint32_t const> adjacency;            // neighbours of cell i are [offsets[i], offsets[i+1])
+
+    std::vector<WorldFieldView> fields;
+
+    uint64_t tick = 0;
+    double time = 0.0;
+
+    size_t getCellCount() const {
+        return indices.size() / 6;
+    }
+
+    std::span<uint32_t const> getNeighbours(size_t const cell) const {
+        return adjacency.subspan(adjacencyOffsets[cell], adjacencyOffsets[cell + 1] - adjacencyOffsets[cell]);
+    }
+
+    WorldFieldView const * findField(std::string_view const name) const;
+};
+
+
+struct WorldField
+{
+    std::string name;
+    uint32_t components = 1;
+    std::vector<float> values;
+};
+
+//
+// @class:  World
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Owns the data of a world. Every cell is a quad of two triangles,
+//          drawn with 6 vertices like the SphereShaderObject expects.
+//
+struct World
+{
+    std::vector<glm::vec3> vertices;
+    std::vector<uint32_t> indices;
+
+    std::vector<uint32_t> adjacencyOffsets;
+    std::vector<uint32_t> adjacency;
+
+    std::vector<WorldField> fields;
+
+    // attributes of the particles, components values per particle. A KernelHost
+    // resizes them to particleCount before a tick
+    size_t particleCount = 0;
+    std::vector<WorldField> particleAttributes;
+
+    uint64_t tick = 0;
+    double time = 0.0;
+
+    size_t getCellCount() const {
+        return indices.size() / 6;
+    }
+
+    WorldField& addField(std::string const & name, uint32_t const components = 1, float const value = 0.0f);
+    WorldField& addParticleAttribute(std::string const & name, uint32_t const components = 1, float const value = 0.0f);
+
+    WorldView getView() const;
+
+    // triangle list as drawn by the SphereShaderObject
+    std::vector<glm::vec3> getTriangles() const;
+};
+
+// center of a cell on the unit sphere, degenerated cells at the poles fall back to their first vertex
+glm::vec3 getCellDirection(WorldView const & world, size_t const cell);
+
+// sphere of n * n cells, neighbours wrap around in longitude
+World createSphereWorld(float const r, size_t const n);
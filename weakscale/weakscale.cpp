@@ -0,0 +1,416 @@
+//
+// @file:   weakscale.cpp
+// @author: FirePrincess
+// @date:   2026-10-19
+// @brief:  Weak scaling of the domain decomposition, one process per domain
+//
+
+#include "domain/domain_simulation.h"
+#include "kernel/diffusion_kernel.h"
+#include "tasks/thread_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char ** environ;
+#endif
+
+using namespace std;
+
+
+namespace {
+
+constexpr double dt = 0.1;
+constexpr uint64_t warmupTicks = 5;
+
+struct WorkerSettings
+{
+    uint32_t domains = 1;
+    uint32_t id = 0;
+    size_t resolution = 0;
+    uint64_t ticks = 0;
+    size_t threads = 1;
+    bool check = false;
+    string out;
+    HaloTransportSettings transport;
+};
+
+struct WorkerResult
+{
+    double seconds = 0.0;
+    double exchangeSeconds = 0.0;
+    uint64_t sentBytes = 0;
+    vector<uint32_t> cells;         // owned cells and their temperature, only with --check
+    vector<float> values;
+};
+
+int printUsage()
+{
+    cout << "Usage: weakscale [--processes 1,2,4,8,16] [--cells-per-process N] [--ticks N]" << endl;
+    cout << "                 [--threads N] [--transport shm|tcp] [--port N] [--check]" << endl;
+    cout << endl;
+    cout << "  Runs the diffusion kernel with one process per domain and the same number" << endl;
+    cout << "  of cells per process, the efficiency is the time per tick of the first" << endl;
+    cout << "  count divided by the time per tick of every other count. Every process" << endl;
+    cout << "  computes with --threads threads, 1 by default, so the processes do not" << endl;
+    cout << "  compete for the cores. --check compares the temperature of every run with" << endl;
+    cout << "  a single process reference." << endl;
+    return 2;
+}
+
+World createInitialWorld(size_t const resolution)
+{
+    World world = createSphereWorld(1.0f, resolution);
+
+    // a warm band and a few hot spots, the same in every process
+    auto & temperature = world.addField("temperature").values;
+    for(size_t cell = 0; cell < world.getCellCount(); ++cell) {
+        glm::vec3 const direction = getCellDirection(world.getView(), cell);
+        temperature[cell] = std::abs(direction.z) < 0.2f ? 1.0f : 0.0f;
+        temperature[cell] += std::sin(7.0f * direction.x) * std::cos(5.0f * direction.y) > 0.9f ? 5.0f : 0.0f;
+    }
+
+    return world;
+}
+
+bool writeResult(string const & filename, WorkerResult const & result)
+{
+    ofstream file(filename, std::ios::binary);
+    uint64_t const count = result.cells.size();
+    file.write(reinterpret_cast<char const *>(&result.seconds), sizeof(result.seconds));
+    file.write(reinterpret_cast<char const *>(&result.exchangeSeconds), sizeof(result.exchangeSeconds));
+    file.write(reinterpret_cast<char const *>(&result.sentBytes), sizeof(result.sentBytes));
+    file.write(reinterpret_cast<char const *>(&count), sizeof(count));
+    file.write(reinterpret_cast<char const *>(result.cells.data()), static_cast<std::streamsize>(count * sizeof(uint32_t)));
+    file.write(reinterpret_cast<char const *>(result.values.data()), static_cast<std::streamsize>(count * sizeof(float)));
+    return file.good();
+}
+
+bool readResult(string const & filename, WorkerResult & result)
+{
+    ifstream file(filename, std::ios::binary);
+    uint64_t count = 0;
+    file.read(reinterpret_cast<char *>(&result.seconds), sizeof(result.seconds));
+    file.read(reinterpret_cast<char *>(&result.exchangeSeconds), sizeof(result.exchangeSeconds));
+    file.read(reinterpret_cast<char *>(&result.sentBytes), sizeof(result.sentBytes));
+    file.read(reinterpret_cast<char *>(&count), sizeof(count));
+    if(!file || count > (uint64_t(1) << 32)) {
+        return false;
+    }
+    result.cells.resize(count);
+    result.values.resize(count);
+    file.read(reinterpret_cast<char *>(result.cells.data()), static_cast<std::streamsize>(count * sizeof(uint32_t)));
+    file.read(reinterpret_cast<char *>(result.values.data()), static_cast<std::streamsize>(count * sizeof(float)));
+    return file.good();
+}
+
+int runWorker(WorkerSettings const & settings)
+{
+    // before anything uses the pool
+    if(!setThreadPoolSize(settings.threads)) {
+        cout << "domain " << settings.id << " failed to limit its threads" << endl;
+        return 1;
+    }
+
+    Domain domain;
+    {
+        // every process builds the global mesh to derive the same partition, only its domain is kept
+        World const world = createInitialWorld(settings.resolution);
+        WorldView const view = world.getView();
+        domain = createDomain(view, partitionWorld(view, settings.domains), settings.domains, settings.id);
+    }
+
+    DomainSimulation simulation(std::move(domain), settings.transport);
+    simulation.getHost().setKernel(getDiffusionKernel());
+
+    if(!simulation.connect()) {
+        cout << "domain " << settings.id << " failed to connect" << endl;
+        return 1;
+    }
+
+    // the first exchanges also synchronize the processes that started at different times
+    for(uint64_t tick = 0; tick < warmupTicks; ++tick) {
+        if(!simulation.tick(dt)) {
+            return 1;
+        }
+    }
+
+    WorkerResult result;
+    double const exchangeStart = simulation.getExchangeSeconds();
+    uint64_t const sentStart = simulation.getSentBytes();
+    auto const start = chrono::steady_clock::now();
+    for(uint64_t tick = 0; tick < settings.ticks; ++tick) {
+        if(!simulation.tick(dt)) {
+            return 1;
+        }
+    }
+    result.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    result.exchangeSeconds = simulation.getExchangeSeconds() - exchangeStart;
+    result.sentBytes = simulation.getSentBytes() - sentStart;
+
+    if(settings.check)
+    {
+        auto const & owned = simulation.getDomain();
+        auto const & temperature = simulation.getWorld().fields.front().values;
+        result.cells.assign(owned.globalCells.begin(), owned.globalCells.begin() + owned.ownedCount);
+        result.values.assign(temperature.begin(), temperature.begin() + owned.ownedCount);
+    }
+
+    return writeResult(settings.out, result) ? 0 : 1;
+}
+
+vector<float> runReference(size_t const resolution, uint64_t const ticks)
+{
+    World world = createInitialWorld(resolution);
+    KernelHost host(world);
+    host.setKernel(getDiffusionKernel());
+    for(uint64_t tick = 0; tick < warmupTicks + ticks; ++tick) {
+        host.tick(dt);
+    }
+
+    return world.fields.front().values;
+}
+
+#ifndef _WIN32
+
+// starts all workers at once and waits for them, false if one of them failed
+bool runWorkers(char const * const executable, vector<vector<string>> const & arguments)
+{
+    vector<pid_t> processes;
+    bool ok = true;
+
+    for(auto const & args : arguments)
+    {
+        vector<char *> argv;
+        argv.push_back(const_cast<char *>(executable));
+        for(auto const & arg : args) {
+            argv.push_back(const_cast<char *>(arg.c_str()));
+        }
+        argv.push_back(nullptr);
+
+        pid_t process = 0;
+        if(posix_spawnp(&process, executable, nullptr, nullptr, argv.data(), environ) != 0) {
+            cout << "failed to start " << executable << endl;
+            ok = false;
+            break;
+        }
+        processes.push_back(process);
+    }
+
+    // workers of a failed start time out in their first exchange
+    for(auto const process : processes)
+    {
+        int status = 0;
+        if(waitpid(process, &status, 0) != process || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            ok = false;
+        }
+    }
+
+    return ok;
+}
+
+#else
+
+bool runWorkers(char const * const, vector<vector<string>> const &)
+{
+    cout << "weakscale needs POSIX processes and shared memory" << endl;
+    return false;
+}
+
+#endif
+
+}
+
+
+int main(int const argc, char const * argv[])
+{
+    vector<uint32_t> processCounts = { 1, 2, 4, 8, 16 };
+    size_t cellsPerProcess = 100000;
+    uint64_t ticks = 100;
+    size_t threads = 1;
+    bool check = false;
+
+    bool worker = false;
+    WorkerSettings workerSettings;
+    HaloTransportSettings transport;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        string const arg = argv[i];
+        bool const hasValue = i + 1 < argc;
+        if(arg == "--processes" && hasValue) {
+            processCounts.clear();
+            stringstream list(argv[++i]);
+            for(string count; getline(list, count, ',');) {
+                processCounts.push_back(static_cast<uint32_t>(std::stoul(count)));
+            }
+        }
+        else if(arg == "--cells-per-process" && hasValue) {
+            cellsPerProcess = std::stoul(argv[++i]);
+        }
+        else if(arg == "--ticks" && hasValue) {
+            ticks = std::stoull(argv[++i]);
+        }
+        else if(arg == "--threads" && hasValue) {
+            threads = std::stoul(argv[++i]);
+        }
+        else if(arg == "--transport" && hasValue) {
+            string const type = argv[++i];
+            if(type != "shm" && type != "tcp") {
+                return printUsage();
+            }
+            transport.type = type == "shm" ? HaloTransportType::eSharedMemory : HaloTransportType::eSocket;
+        }
+        else if(arg == "--port" && hasValue) {
+            transport.basePort = static_cast<uint16_t>(std::stoul(argv[++i]));
+        }
+        else if(arg == "--check") {
+            check = true;
+        }
+        // arguments of the worker processes started by the parent
+        else if(arg == "--worker") {
+            worker = true;
+        }
+        else if(arg == "--domains" && hasValue) {
+            workerSettings.domains = static_cast<uint32_t>(std::stoul(argv[++i]));
+        }
+        else if(arg == "--domain-id" && hasValue) {
+            workerSettings.id = static_cast<uint32_t>(std::stoul(argv[++i]));
+        }
+        else if(arg == "--resolution" && hasValue) {
+            workerSettings.resolution = std::stoul(argv[++i]);
+        }
+        else if(arg == "--session" && hasValue) {
+            transport.session = argv[++i];
+        }
+        else if(arg == "--out" && hasValue) {
+            workerSettings.out = argv[++i];
+        }
+        else {
+            return printUsage();
+        }
+    }
+
+    if(worker) {
+        workerSettings.ticks = ticks;
+        workerSettings.threads = threads;
+        workerSettings.check = check;
+        workerSettings.transport = transport;
+        return runWorker(workerSettings);
+    }
+
+    if(processCounts.empty() || cellsPerProcess == 0 || threads == 0 || std::find(processCounts.begin(), processCounts.end(), 0u) != processCounts.end()) {
+        return printUsage();
+    }
+
+    auto const directory = std::filesystem::temp_directory_path();
+
+    cout << setw(10) << "processes" << setw(9) << "threads" << setw(12) << "cells" << setw(14) << "ms/tick"
+         << setw(14) << "exchange ms" << setw(14) << "halo KiB" << setw(12) << "efficiency";
+    if(check) {
+        cout << setw(12) << "max error";
+    }
+    cout << endl;
+
+    double baseline = 0.0;
+    for(auto const processes : processCounts)
+    {
+        size_t const resolution = static_cast<size_t>(std::lround(std::sqrt(static_cast<double>(cellsPerProcess) * processes)));
+        string const session = "wss_" + std::to_string(getpid()) + "_" + std::to_string(processes);
+
+        vector<vector<string>> arguments;
+        vector<string> outputs;
+        for(uint32_t id = 0; id < processes; ++id)
+        {
+            outputs.push_back((directory / (session + "_" + std::to_string(id) + ".bin")).string());
+
+            vector<string> args = {
+                "--worker",
+                "--domains", std::to_string(processes),
+                "--domain-id", std::to_string(id),
+                "--resolution", std::to_string(resolution),
+                "--ticks", std::to_string(ticks),
+                "--threads", std::to_string(threads),
+                "--transport", transport.type == HaloTransportType::eSharedMemory ? "shm" : "tcp",
+                "--port", std::to_string(transport.basePort),
+                "--session", session,
+                "--out", outputs.back(),
+            };
+            if(check) {
+                args.push_back("--check");
+            }
+            arguments.push_back(std::move(args));
+        }
+
+        if(!runWorkers(argv[0], arguments)) {
+            cout << "run with " << processes << " processes failed" << endl;
+            return 1;
+        }
+
+        // the slowest domain sets the pace of all
+        WorkerResult total;
+        vector<WorkerResult> results(processes);
+        for(uint32_t id = 0; id < processes; ++id)
+        {
+            if(!readResult(outputs[id], results[id])) {
+                cout << "failed to read " << outputs[id] << endl;
+                return 1;
+            }
+            std::error_code error;
+            std::filesystem::remove(outputs[id], error);
+
+            total.seconds = std::max(total.seconds, results[id].seconds);
+            total.exchangeSeconds = std::max(total.exchangeSeconds, results[id].exchangeSeconds);
+            total.sentBytes += results[id].sentBytes;
+        }
+
+        double const msPerTick = total.seconds * 1000.0 / static_cast<double>(std::max<uint64_t>(ticks, 1));
+        if(baseline == 0.0) {
+            baseline = msPerTick;
+        }
+
+        cout << setw(10) << processes << setw(9) << threads << setw(12) << resolution * resolution
+             << setw(14) << fixed << setprecision(3) << msPerTick
+             << setw(14) << total.exchangeSeconds * 1000.0 / static_cast<double>(std::max<uint64_t>(ticks, 1))
+             << setw(14) << setprecision(1) << static_cast<double>(total.sentBytes) / 1024.0
+             << setw(12) << setprecision(3) << (msPerTick > 0.0 ? baseline / msPerTick : 0.0);
+
+        if(check)
+        {
+            vector<float> const reference = runReference(resolution, ticks);
+
+            float error = 0.0f;
+            size_t covered = 0;
+            for(auto const & result : results) {
+                for(size_t i = 0; i < result.cells.size(); ++i) {
+                    error = std::max(error, std::abs(result.values[i] - reference[result.cells[i]]));
+                }
+                covered += result.cells.size();
+            }
+
+            cout << setw(12) << setprecision(6) << error;
+            if(covered != reference.size()) {
+                cout << endl << "domains cover " << covered << " of " << reference.size() << " cells" << endl;
+                return 1;
+            }
+        }
+
+        cout << endl;
+    }
+
+    return 0;
+}